@@ -1,6 +1,8 @@
-#version 450 core
+#version 460 core
 
-layout(location = 0) in vec3 in_position;
+// Level geometry positions are packed as fixed point with the scale in "w" (See pack_position).
+// Float positions have a "w" of 1, so the divide works for both.
+layout(location = 0) in vec4 in_position;
 layout(location = 2) in vec3 in_normal;
 
 out VS_OUT {
@@ -15,10 +17,24 @@ layout(std430, binding = 0) readonly buffer Matrices
 
 uniform mat4 model_matrix;
 
+// Objects sharing their geometry with other objects (See GeometryCache) are moved to their position
+// using the offset indexed by the object ID, which MeshBatch passes as the base instance
+layout(std430, binding = 1) readonly buffer ObjectOffsets
+{
+    vec4 object_offsets[];
+};
+
+uniform bool use_object_offsets;
+
 // Source: https://learnopengl.com/Advanced-OpenGL/Geometry-Shader
 void main()
 {
-    gl_Position = matrices.view * model_matrix * vec4(in_position, 1.0); 
+    vec3 position = in_position.xyz / in_position.w;
+    if (use_object_offsets)
+    {
+        position += object_offsets[gl_BaseInstance].xyz;
+    }
+    gl_Position = matrices.view * model_matrix * vec4(position, 1.0); 
     mat3 normal_matrix = mat3(transpose(inverse(matrices.view * model_matrix)));
     gs_in.normal = normalize(vec3(vec4(normal_matrix * in_normal, 0.0)));
 }
\ No newline at end of file
@@ -5,9 +5,9 @@
 // the object ID can read-back via glReadPixels
 layout(location = 0) out int out_colour;
 
-uniform int object_id;
+flat in int pass_object_id;
 
 void main() 
 {
-    out_colour = object_id;
+    out_colour = pass_object_id;
 }
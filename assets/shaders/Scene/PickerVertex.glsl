@@ -1,6 +1,8 @@
-#version 450 core
+#version 460 core
 
-layout(location = 0) in vec3 in_position;
+// Level geometry positions are packed as fixed point with the scale in "w" (See pack_position).
+// Float positions have a "w" of 1, so the divide works for both.
+layout(location = 0) in vec4 in_position;
 
 layout(std430, binding = 0) readonly buffer Matrices 
 {
@@ -10,7 +12,28 @@ layout(std430, binding = 0) readonly buffer Matrices
 
 uniform mat4 model_matrix;
 
+// Objects sharing their geometry with other objects (See GeometryCache) are moved to their position
+// using the offset indexed by the object ID, which MeshBatch passes as the base instance
+layout(std430, binding = 1) readonly buffer ObjectOffsets
+{
+    vec4 object_offsets[];
+};
+
+uniform bool use_object_offsets;
+
+// Meshes drawn by a MeshBatch pass their object ID as the base instance, while meshes drawn
+// individually have a base instance of 0 so only the uniform is used
+uniform int object_id;
+
+flat out int pass_object_id;
+
 void main() 
 {
-    gl_Position = matrices.projection * matrices.view * model_matrix * vec4(in_position, 1.0);
+    pass_object_id = object_id + gl_BaseInstance;
+    vec3 position = in_position.xyz / in_position.w;
+    if (use_object_offsets)
+    {
+        position += object_offsets[gl_BaseInstance].xyz;
+    }
+    gl_Position = matrices.projection * matrices.view * model_matrix * vec4(position, 1.0);
 }
@@ -1,6 +1,8 @@
 #version 450 core
 
-layout(location = 0) in vec2 in_position;
+// Positions are packed as fixed point with the scale in "w" (See pack_position). Float positions
+// have a "w" of 1, so the divide works for both.
+layout(location = 0) in vec4 in_position;
 layout(location = 1) in vec3 in_texture_coord;
 layout(location = 2) in vec3 in_world_texture_coord;
 layout(location = 3) in vec4 in_colour;
@@ -20,5 +22,6 @@ void main()
     vs_out.texture_coord = in_texture_coord;
     vs_out.world_texture_coord = in_world_texture_coord;
     vs_out.colour = in_colour;
-    gl_Position = projection_matrix * view_matrix * model_matrix * vec4(in_position, 0.0, 1.0);
+    vec2 position = in_position.xy / in_position.w;
+    gl_Position = projection_matrix * view_matrix * model_matrix * vec4(position, 0.0, 1.0);
 }
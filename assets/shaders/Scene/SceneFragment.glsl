@@ -14,6 +14,9 @@ uniform bool use_texture;
 
 uniform bool selected;
 
+// Floors outside of the visible floor range are drawn faded, without textures
+uniform bool ghosted;
+
 uniform vec3 main_light_position;
 uniform vec3 main_light_colour;
 uniform float main_light_brightness;
@@ -24,6 +27,12 @@ void main()
     vec3 norm = normalize(fs_in.normal);
     float diffuse_light  = max(dot(fs_in.normal, light_direction), 0.25);
 
+    if (ghosted)
+    {
+        out_colour = vec4(vec3(diffuse_light), 0.2);
+        return;
+    }
+
     out_colour = fs_in.colour;
     if (use_texture) 
     {
@@ -1,6 +1,8 @@
-#version 450 core
+#version 460 core
 
-layout(location = 0) in vec3 in_position;
+// Level geometry positions are packed as fixed point with the scale in "w" (See pack_position).
+// Float positions have a "w" of 1, so the divide works for both.
+layout(location = 0) in vec4 in_position;
 layout(location = 1) in TEX_COORD_LENGTH in_texture_coord;
 layout(location = 2) in vec3 in_normal;
 layout(location = 3) in vec4 in_colour;
@@ -21,10 +23,27 @@ layout(std430, binding = 0) readonly buffer Matrices
 
 uniform mat4 model_matrix;
 
+// Objects sharing their geometry with other objects (See GeometryCache) are moved to their position
+// using the offset indexed by the object ID, which MeshBatch passes as the base instance
+layout(std430, binding = 1) readonly buffer ObjectOffsets
+{
+    vec4 object_offsets[];
+};
+
+uniform bool use_object_offsets;
+
+// Calculated on the CPU from the model matrix by gl::Shader::set_model_matrix
+uniform mat3 normal_matrix;
+
 void main() 
 {
-    vs_out.fragment_coord = vec3(model_matrix * vec4(in_position, 1.0));
-    vs_out.normal = mat3(transpose(inverse(model_matrix))) * in_normal;
+    vec3 position = in_position.xyz / in_position.w;
+    if (use_object_offsets)
+    {
+        position += object_offsets[gl_BaseInstance].xyz;
+    }
+    vs_out.fragment_coord = vec3(model_matrix * vec4(position, 1.0));
+    vs_out.normal = normal_matrix * in_normal;
     vs_out.texture_coord = in_texture_coord;
     vs_out.colour = in_colour;
     gl_Position = matrices.projection * matrices.view * vec4(vs_out.fragment_coord, 1.0);
@@ -1,11 +1,14 @@
 #version 450 core
 
-layout(location = 0) in vec3 in_position;
+// Level geometry positions are packed as fixed point with the scale in "w" (See pack_position).
+// Float positions have a "w" of 1, so the divide works for both.
+layout(location = 0) in vec4 in_position;
 
 uniform mat4 light_space_matrix;
 uniform mat4 model_matrix;
 
 void main() 
 {
-    gl_Position = light_space_matrix * model_matrix * vec4(in_position, 1.0);
+    vec3 position = in_position.xyz / in_position.w;
+    gl_Position = light_space_matrix * model_matrix * vec4(position, 1.0);
 }
\ No newline at end of file
@@ -25,6 +25,10 @@ void ActionManager::push_action(std::unique_ptr<Action> action, bool store_actio
         auto& moved_action = action_stack_.emplace_back(std::move(action));
         action_index_ = action_stack_.size();
 
+        // Actions that are not stored are intermediate steps (such as while dragging), which are
+        // followed by a stored action with the final result
+        journal_.append(EditJournal::RecordType::Execute, moved_action->get_changes(false));
+
         auto [title, body] = moved_action->to_string();
         std::println("Execute: {}\n{}\n\n Index {} ", title, body, action_index_);
         std::println("=======================================================");
@@ -38,6 +42,7 @@ void ActionManager::undo_action()
         auto& action = action_stack_.at(action_index_ - 1);
         action->undo(*p_state_, *p_level_);
         action_index_ -= 1;
+        journal_.append(EditJournal::RecordType::Undo, action->get_changes(true));
 
         auto [title, body] = action->to_string();
         std::println("Undo: {}\n{}\n\n Index {} ", title, body, action_index_);
@@ -56,6 +61,7 @@ void ActionManager::redo_action()
         auto& action = action_stack_.at(action_index_);
         action->execute(*p_state_, *p_level_);
         action_index_ += 1;
+        journal_.append(EditJournal::RecordType::Redo, action->get_changes(false));
 
         auto [title, body] = action->to_string();
         std::println("Redo: {}\n{}\n\n Index {} ", title, body, action_index_);
@@ -92,6 +98,11 @@ void ActionManager::clear()
     action_stack_.clear();
 }
 
+EditJournal& ActionManager::get_journal()
+{
+    return journal_;
+}
+
 // =======================================
 //          AddObjectAction
 // =======================================
@@ -134,6 +145,18 @@ ActionStrings AddObjectAction::to_string() const
     };
 }
 
+std::vector<LevelChange> AddObjectAction::get_changes(bool undone) const
+{
+    if (undone)
+    {
+        return {{.type = LevelChange::Type::Remove, .object = LevelObject{id_}}};
+    }
+
+    auto object = object_;
+    object.object_id = id_;
+    return {{.type = LevelChange::Type::Add, .object = object, .floor = floor_}};
+}
+
 // =======================================
 //          AddBulkObjectsAction
 // =======================================
@@ -147,7 +170,7 @@ AddBulkObjectsAction::AddBulkObjectsAction(const std::vector<LevelObject>& objec
 void AddBulkObjectsAction::execute(EditorState& state, EditorLevel& level)
 {
     // New objects are selected - so clear the old selection
-
+    Selection::BatchUpdate batch_update(state.selection);
     state.selection.clear_selection();
 
     // When adding a single object, this ensures that the active object is one added
@@ -211,6 +234,25 @@ ActionStrings AddBulkObjectsAction::to_string() const
     };
 }
 
+std::vector<LevelChange> AddBulkObjectsAction::get_changes(bool undone) const
+{
+    std::vector<LevelChange> changes;
+    for (auto&& [object, floor, object_id] : std::views::zip(objects_, floors_, object_ids_))
+    {
+        if (undone)
+        {
+            changes.push_back(
+                {.type = LevelChange::Type::Remove, .object = LevelObject{object_id}});
+        }
+        else
+        {
+            changes.push_back({.type = LevelChange::Type::Add, .object = object, .floor = floor});
+            changes.back().object.object_id = object_id;
+        }
+    }
+    return changes;
+}
+
 // =======================================
 //          UpdateObjectAction
 // =======================================
@@ -241,6 +283,11 @@ ActionStrings UpdateObjectAction::to_string() const
     };
 }
 
+std::vector<LevelChange> UpdateObjectAction::get_changes(bool undone) const
+{
+    return {{.type = LevelChange::Type::Update, .object = undone ? old_object_ : new_object_}};
+}
+
 BulkUpdateObjectAction::BulkUpdateObjectAction(const std::vector<LevelObject>& old_objects,
                                                const std::vector<LevelObject>& new_objects)
     : old_objects_(old_objects)
@@ -281,6 +328,16 @@ ActionStrings BulkUpdateObjectAction::to_string() const
             .body = std::format("Before:\n{}\n\nAfter:\n{}", before, after)};
 }
 
+std::vector<LevelChange> BulkUpdateObjectAction::get_changes(bool undone) const
+{
+    std::vector<LevelChange> changes;
+    for (auto& object : undone ? old_objects_ : new_objects_)
+    {
+        changes.push_back({.type = LevelChange::Type::Update, .object = object});
+    }
+    return changes;
+}
+
 // =======================================
 //      DeleteObjectAction
 // =======================================
@@ -302,6 +359,7 @@ void DeleteObjectAction::execute(EditorState& state, EditorLevel& level)
 
 void DeleteObjectAction::undo(EditorState& state, EditorLevel& level)
 {
+    Selection::BatchUpdate batch_update(state.selection);
     state.selection.clear_selection();
     for (auto&& [object, floor] : std::views::zip(objects_, floors_))
     {
@@ -329,3 +387,21 @@ ActionStrings DeleteObjectAction::to_string() const
         .body = body,
     };
 }
+
+std::vector<LevelChange> DeleteObjectAction::get_changes(bool undone) const
+{
+    std::vector<LevelChange> changes;
+    for (auto&& [object, floor] : std::views::zip(objects_, floors_))
+    {
+        if (undone)
+        {
+            changes.push_back({.type = LevelChange::Type::Add, .object = object, .floor = floor});
+        }
+        else
+        {
+            changes.push_back(
+                {.type = LevelChange::Type::Remove, .object = LevelObject{object.object_id}});
+        }
+    }
+    return changes;
+}
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 
+#include "EditJournal.h"
 #include "LevelObjects/LevelObject.h"
 
 class EditorLevel;
@@ -24,6 +25,10 @@ class Action
     virtual void undo(EditorState& state, EditorLevel& level) = 0;
 
     virtual ActionStrings to_string() const = 0;
+
+    /// The changes made to the level by the last call to "execute", or to "undo" when "undone" is
+    /// set, which are written to the edit journal
+    virtual std::vector<LevelChange> get_changes(bool undone) const = 0;
 };
 
 /// Action to add a new object to the level.
@@ -36,6 +41,7 @@ class AddObjectAction final : public Action
     void undo(EditorState& state, EditorLevel& level) override;
 
     ActionStrings to_string() const override;
+    std::vector<LevelChange> get_changes(bool undone) const override;
 
   private:
     /// The object to add
@@ -60,6 +66,7 @@ class AddBulkObjectsAction final : public Action
     void undo(EditorState& state, EditorLevel& level) override;
 
     ActionStrings to_string() const override;
+    std::vector<LevelChange> get_changes(bool undone) const override;
 
   private:
     /// The objects to add
@@ -82,6 +89,7 @@ class UpdateObjectAction final : public Action
     void undo(EditorState& state, EditorLevel& level) override;
 
     ActionStrings to_string() const override;
+    std::vector<LevelChange> get_changes(bool undone) const override;
 
   private:
     /// The object before the update
@@ -102,6 +110,7 @@ class BulkUpdateObjectAction final : public Action
     void undo(EditorState& state, EditorLevel& level) override;
 
     ActionStrings to_string() const override;
+    std::vector<LevelChange> get_changes(bool undone) const override;
 
   private:
     /// The object before the update
@@ -121,6 +130,7 @@ class DeleteObjectAction final : public Action
     void undo(EditorState& state, EditorLevel& level) override;
 
     ActionStrings to_string() const override;
+    std::vector<LevelChange> get_changes(bool undone) const override;
 
   private:
     /// The object to delete
@@ -142,10 +152,15 @@ class ActionManager
 
     void clear();
 
+    /// Every action executed, undone or redone is written to the journal (See EditJournal)
+    EditJournal& get_journal();
+
   private:
     EditorState* p_state_ = nullptr;
     EditorLevel* p_level_ = nullptr;
 
+    EditJournal journal_;
+
     std::vector<std::unique_ptr<Action>> action_stack_;
     size_t action_index_ = 0;
 };
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "BackgroundLevelSaver.h"
+
+#include <cassert>
+#include <chrono>
+
+#include <SFML/System/Clock.hpp>
+
+namespace
+{
+    LevelSaveResult save_snapshot(const FloorsSnapshot& snapshot, LevelSaveRequest request)
+    {
+        LevelSaveResult result{.request = std::move(request)};
+
+        sf::Clock clock;
+        LevelFileIO level_file_io;
+        level_file_io.set_compression_level(result.request.compression_level);
+        level_file_io.set_save_id(result.request.save_id);
+        if (result.request.export_json)
+        {
+            level_file_io.write_floors(snapshot.serialise(level_file_io));
+            result.serialise_time = clock.restart();
+
+            result.success = level_file_io.export_json(result.request.level_name);
+            result.write_time = clock.getElapsedTime();
+            return result;
+        }
+
+        if (result.request.format == LevelFileFormat::Binary)
+        {
+            level_file_io.write_floors_binary(snapshot.serialise_binary(result.request.save_id));
+        }
+        else
+        {
+            level_file_io.write_floors(snapshot.serialise(level_file_io));
+        }
+        result.serialise_time = clock.restart();
+
+        result.success = level_file_io.save(result.request.level_name, true);
+        result.write_time = clock.getElapsedTime();
+        return result;
+    }
+} // namespace
+
+BackgroundLevelSaver::~BackgroundLevelSaver()
+{
+    // The level must finish saving even if the result is no longer wanted
+    wait();
+}
+
+void BackgroundLevelSaver::start(FloorsSnapshot snapshot, LevelSaveRequest request)
+{
+    assert(!is_saving());
+    saving_ = std::async(std::launch::async,
+                         [snapshot = std::move(snapshot), request = std::move(request)]() mutable
+                         { return save_snapshot(snapshot, std::move(request)); });
+}
+
+bool BackgroundLevelSaver::is_saving() const
+{
+    return saving_.valid();
+}
+
+std::optional<LevelSaveResult> BackgroundLevelSaver::poll()
+{
+    if (saving_.valid() &&
+        saving_.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        return saving_.get();
+    }
+    return {};
+}
+
+std::optional<LevelSaveResult> BackgroundLevelSaver::wait()
+{
+    if (saving_.valid())
+    {
+        return saving_.get();
+    }
+    return {};
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <optional>
+#include <string>
+
+#include <SFML/System/Time.hpp>
+
+#include "FloorManager.h"
+#include "LevelFileIO.h"
+
+/// What to save the level as, passed back with the result of the save
+struct LevelSaveRequest
+{
+    std::string level_name;
+    LevelFileFormat format = LevelFileFormat::Binary;
+
+    /// The zlib compression level (1-9) used when saving as JSON
+    int compression_level = 6;
+
+    /// The revision of the level when the snapshot was taken (See EditorLevel::get_revision)
+    std::uint64_t revision = 0;
+
+    /// Written with the level's floors (See LevelFileIO::set_save_id)
+    std::uint64_t save_id = 0;
+
+    /// Set to only write a JSON copy of the level (See LevelFileIO::export_json) rather than
+    /// saving it, which always uses the JSON format
+    bool export_json = false;
+};
+
+struct LevelSaveResult
+{
+    LevelSaveRequest request;
+    bool success = false;
+
+    sf::Time serialise_time;
+    sf::Time write_time;
+};
+
+/// Serialises, compresses and writes a level on a worker thread, such that saving a large level
+/// does not stall the editor. The level is saved from a snapshot of its floors, so it can continue
+/// to be edited while it is being saved.
+class BackgroundLevelSaver
+{
+  public:
+    BackgroundLevelSaver() = default;
+    ~BackgroundLevelSaver();
+
+    BackgroundLevelSaver(const BackgroundLevelSaver&) = delete;
+    BackgroundLevelSaver& operator=(const BackgroundLevelSaver&) = delete;
+
+    /// Starts saving the snapshot. Only one level is saved at a time, so the result of any save
+    /// still in progress must be waited for first (See "wait").
+    void start(FloorsSnapshot snapshot, LevelSaveRequest request);
+
+    [[nodiscard]] bool is_saving() const;
+
+    /// Returns the result of the save once it has finished without waiting for it. Each result is
+    /// only returned once.
+    std::optional<LevelSaveResult> poll();
+
+    /// Waits for the save in progress to finish and returns its result, or nothing if there is no
+    /// save in progress.
+    std::optional<LevelSaveResult> wait();
+
+  private:
+    std::future<LevelSaveResult> saving_;
+};
\ No newline at end of file
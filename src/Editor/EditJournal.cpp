@@ -0,0 +1,425 @@
+#include "EditJournal.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <print>
+#include <tuple>
+
+#include <zlib.h>
+
+#include "../Util/MappedFile.h"
+#include "EditorLevel.h"
+#include "FloorManager.h"
+#include "LevelBinaryFormat.h"
+
+namespace
+{
+    constexpr std::array<char, 4> MAGIC = {'C', 'L', 'Y', 'J'};
+    constexpr std::uint32_t VERSION = 1;
+
+    struct Header
+    {
+        std::array<char, 4> magic = MAGIC;
+        std::uint32_t version = VERSION;
+        std::uint64_t save_id = 0;
+    };
+    static_assert(sizeof(Header) == 16);
+
+    /// Size of the record's payload size and CRC that precede the payload
+    constexpr std::size_t RECORD_PREFIX_SIZE = 2 * sizeof(std::uint32_t);
+
+    /// Replayed objects that have since been removed
+    constexpr ObjectId NO_OBJECT = -1;
+
+    template <typename T>
+    void append_value(std::vector<std::byte>& output, const T& value)
+    {
+        auto p_value = reinterpret_cast<const std::byte*>(&value);
+        output.insert(output.end(), p_value, p_value + sizeof(T));
+    }
+
+    /// Reads a value from the start of "input" and advances past it
+    template <typename T>
+    bool take_value(std::span<const std::byte>& input, T& value)
+    {
+        if (input.size() < sizeof(T))
+        {
+            return false;
+        }
+        std::memcpy(&value, input.data(), sizeof(T));
+        input = input.subspan(sizeof(T));
+        return true;
+    }
+
+    std::uint32_t calculate_crc(std::span<const std::byte> data)
+    {
+        return crc32(crc32(0, nullptr, 0), reinterpret_cast<const Bytef*>(data.data()),
+                     static_cast<uInt>(data.size()));
+    }
+
+    std::optional<LevelChange> read_change(std::span<const std::byte>& payload)
+    {
+        LevelChange change;
+        if (!take_value(payload, change.type) || change.type > LevelChange::Type::Remove ||
+            !take_value(payload, change.object.object_id))
+        {
+            return {};
+        }
+
+        std::int32_t floor = 0;
+        if (change.type == LevelChange::Type::Add && !take_value(payload, floor))
+        {
+            return {};
+        }
+        change.floor = floor;
+
+        if (change.type != LevelChange::Type::Remove)
+        {
+            auto object = read_object_record(payload);
+            if (!object)
+            {
+                return {};
+            }
+            object->object_id = change.object.object_id;
+            change.object = std::move(*object);
+        }
+        return change;
+    }
+
+    /// Reads the record from the start of "records" and advances past it. Returns nothing if the
+    /// record is incomplete or corrupt, which is where the journal ends.
+    std::optional<std::vector<LevelChange>> read_record(std::span<const std::byte>& records)
+    {
+        auto input = records;
+        std::uint32_t size = 0;
+        std::uint32_t crc = 0;
+        if (!take_value(input, size) || !take_value(input, crc) || size > input.size())
+        {
+            return {};
+        }
+
+        auto payload = input.first(size);
+        if (calculate_crc(payload) != crc)
+        {
+            return {};
+        }
+
+        EditJournal::RecordType type;
+        std::uint32_t change_count = 0;
+        if (!take_value(payload, type) || type > EditJournal::RecordType::Redo ||
+            !take_value(payload, change_count))
+        {
+            return {};
+        }
+
+        std::vector<LevelChange> changes;
+        for (std::uint32_t i = 0; i < change_count; i++)
+        {
+            auto change = read_change(payload);
+            if (!change)
+            {
+                return {};
+            }
+            changes.push_back(std::move(*change));
+        }
+
+        records = input.subspan(size);
+        return changes;
+    }
+
+    /// Floors are added one at a time above or below the existing floors, as they are in the editor
+    void ensure_floors_exist(EditorLevel& level, int floor)
+    {
+        if (level.get_floor_count() == 0)
+        {
+            level.ensure_floor_exists(floor);
+        }
+        while (floor > level.get_max_floor())
+        {
+            level.ensure_floor_exists(level.get_max_floor() + 1);
+        }
+        while (floor < level.get_min_floor())
+        {
+            level.ensure_floor_exists(level.get_min_floor() - 1);
+        }
+    }
+} // namespace
+
+ObjectId EditJournal::IdMapping::get_journal_id(ObjectId id)
+{
+    if (auto itr = journal_ids.find(id); itr != journal_ids.end())
+    {
+        return itr->second;
+    }
+    if (id >= 0 && id < identity_below)
+    {
+        return id;
+    }
+    return journal_ids[id] = next_journal_id++;
+}
+
+EditJournal::~EditJournal()
+{
+    close();
+}
+
+std::size_t EditJournal::open(const std::filesystem::path& path, std::uint64_t save_id,
+                              EditorLevel& level)
+{
+    close();
+    pending_save_.reset();
+
+    // The loaded objects' IDs are the IDs the journal refers to them by
+    auto loaded_count = static_cast<ObjectId>(level.last_placed_id() + 1);
+    ids_ = {.identity_below = loaded_count, .next_journal_id = loaded_count};
+
+    std::size_t record_count = 0;
+    std::uint64_t valid_size = 0;
+    {
+        // Journals that are not for the save the level was loaded from are older than the save
+        MappedFile journal;
+        Header header;
+        if (journal.open(path) && journal.data().size() >= sizeof(Header))
+        {
+            std::memcpy(&header, journal.data().data(), sizeof(Header));
+            if (header.magic == MAGIC && header.version == VERSION && header.save_id == save_id)
+            {
+                std::tie(record_count, valid_size) = replay(journal.data(), level);
+            }
+        }
+    }
+
+    // The file is truncated to the valid records, such that new records are not appended after
+    // a record that was cut short
+    if (valid_size == 0)
+    {
+        start(path, save_id);
+    }
+    else if (file_.open(path, valid_size))
+    {
+        path_ = path;
+    }
+    else
+    {
+        std::println(std::cerr, "Could not open edit journal {}", path.string());
+    }
+
+    if (record_count > 0)
+    {
+        std::println("Replayed {} records from the edit journal {}", record_count, path.string());
+    }
+    return record_count;
+}
+
+void EditJournal::close()
+{
+    sync();
+    file_.close();
+}
+
+void EditJournal::append(RecordType type, const std::vector<LevelChange>& changes)
+{
+    if (changes.empty())
+    {
+        return;
+    }
+
+    write_record(encode_record(type, changes, ids_));
+    if (pending_save_)
+    {
+        pending_save_->records.push_back(encode_record(type, changes, pending_save_->ids));
+    }
+}
+
+void EditJournal::update()
+{
+    if (unsynced_records_ > 0 &&
+        unsynced_clock_.getElapsedTime().asSeconds() >= SYNC_INTERVAL_SECONDS)
+    {
+        sync();
+    }
+}
+
+void EditJournal::begin_save(const std::filesystem::path& path, std::uint64_t save_id,
+                             const FloorsSnapshot& snapshot)
+{
+    // When the saved level is loaded, each object's ID is its index within the snapshot
+    auto& pending = pending_save_.emplace(PendingSave{.path = path, .save_id = save_id});
+    for (auto& floor : snapshot.floors)
+    {
+        for (auto& object : floor.objects)
+        {
+            pending.ids.journal_ids[object.object_id] = pending.ids.next_journal_id++;
+        }
+    }
+}
+
+void EditJournal::end_save(bool success)
+{
+    if (!pending_save_)
+    {
+        return;
+    }
+    auto pending = std::move(*pending_save_);
+    pending_save_.reset();
+    if (!success)
+    {
+        return;
+    }
+
+    // When saved as a different level, the edits belong to that level rather than this one
+    close();
+    if (!path_.empty() && path_ != pending.path)
+    {
+        std::error_code error;
+        std::filesystem::remove(path_, error);
+    }
+
+    if (start(pending.path, pending.save_id))
+    {
+        ids_ = std::move(pending.ids);
+        for (auto& record : pending.records)
+        {
+            write_record(record);
+        }
+        sync();
+    }
+}
+
+bool EditJournal::start(const std::filesystem::path& path, std::uint64_t save_id)
+{
+    path_ = path;
+    unsynced_records_ = 0;
+
+    Header header{.save_id = save_id};
+    auto p_header = reinterpret_cast<const std::byte*>(&header);
+    if (!file_.open(path, 0) || !file_.append({p_header, sizeof(Header)}) || !file_.sync())
+    {
+        std::println(std::cerr, "Could not create edit journal {}", path.string());
+        file_.close();
+        return false;
+    }
+    return true;
+}
+
+std::pair<std::size_t, std::uint64_t> EditJournal::replay(std::span<const std::byte> data,
+                                                          EditorLevel& level)
+{
+    // Maps the IDs the journal refers to objects by to their IDs in the level
+    auto loaded_count = ids_.identity_below;
+    std::unordered_map<ObjectId, ObjectId> level_ids;
+    auto get_level_id = [&](ObjectId journal_id)
+    {
+        if (auto itr = level_ids.find(journal_id); itr != level_ids.end())
+        {
+            return itr->second;
+        }
+        return journal_id < loaded_count ? journal_id : NO_OBJECT;
+    };
+
+    std::size_t record_count = 0;
+    auto records = data.subspan(sizeof(Header));
+    while (auto changes = read_record(records))
+    {
+        for (auto& change : *changes)
+        {
+            auto journal_id = change.object.object_id;
+            switch (change.type)
+            {
+                case LevelChange::Type::Add:
+                {
+                    ensure_floors_exist(level, change.floor);
+                    level_ids[journal_id] = level.add_object(change.object, change.floor).object_id;
+                    ids_.next_journal_id = std::max(ids_.next_journal_id, journal_id + 1);
+                    break;
+                }
+
+                case LevelChange::Type::Update:
+                    change.object.object_id = get_level_id(journal_id);
+                    level.update_object(change.object, change.floor);
+                    break;
+
+                case LevelChange::Type::Remove:
+                    level.remove_object(get_level_id(journal_id));
+                    level_ids[journal_id] = NO_OBJECT;
+                    break;
+            }
+        }
+        record_count++;
+    }
+
+    // New records refer to the replayed objects by the same IDs as the replayed records
+    for (auto [journal_id, level_id] : level_ids)
+    {
+        if (level_id != NO_OBJECT)
+        {
+            ids_.journal_ids[level_id] = journal_id;
+        }
+    }
+    return {record_count, data.size() - records.size()};
+}
+
+std::vector<std::byte> EditJournal::encode_record(RecordType type,
+                                                  const std::vector<LevelChange>& changes,
+                                                  IdMapping& ids)
+{
+    // The size and CRC are filled in once the payload has been written
+    std::vector<std::byte> record(RECORD_PREFIX_SIZE);
+    append_value(record, type);
+    append_value(record, static_cast<std::uint32_t>(changes.size()));
+    for (auto& change : changes)
+    {
+        append_value(record, change.type);
+        append_value(record, ids.get_journal_id(change.object.object_id));
+        if (change.type == LevelChange::Type::Add)
+        {
+            append_value(record, static_cast<std::int32_t>(change.floor));
+        }
+        if (change.type != LevelChange::Type::Remove)
+        {
+            write_object_record(record, change.object);
+        }
+    }
+
+    auto payload = std::span<const std::byte>(record).subspan(RECORD_PREFIX_SIZE);
+    auto size = static_cast<std::uint32_t>(payload.size());
+    auto crc = calculate_crc(payload);
+    std::memcpy(record.data(), &size, sizeof(size));
+    std::memcpy(record.data() + sizeof(size), &crc, sizeof(crc));
+    return record;
+}
+
+void EditJournal::write_record(const std::vector<std::byte>& record)
+{
+    if (!file_.is_open())
+    {
+        return;
+    }
+
+    if (!file_.append(record))
+    {
+        std::println(std::cerr, "Could not write to edit journal {}", path_.string());
+        file_.close();
+        return;
+    }
+
+    if (unsynced_records_++ == 0)
+    {
+        unsynced_clock_.restart();
+    }
+    if (unsynced_records_ >= SYNC_RECORD_COUNT)
+    {
+        sync();
+    }
+}
+
+void EditJournal::sync()
+{
+    if (unsynced_records_ > 0)
+    {
+        file_.sync();
+        unsynced_records_ = 0;
+    }
+}
\ No newline at end of file
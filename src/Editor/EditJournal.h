@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <SFML/System/Clock.hpp>
+
+#include "../Util/AppendFile.h"
+#include "LevelObjects/LevelObject.h"
+
+class EditorLevel;
+struct FloorsSnapshot;
+
+/// A single change made to the level by an action, such that it can be replayed from the journal
+struct LevelChange
+{
+    enum class Type : std::uint8_t
+    {
+        Add,
+        Update,
+        Remove,
+    };
+
+    Type type = Type::Add;
+
+    /// Only the object ID is used for removed objects
+    LevelObject object{0};
+
+    /// The floor the object is added to, unused for other changes
+    int floor = 0;
+};
+
+/**
+ * @brief Crash-safe journal of the edits made to a level since it was last saved.
+ *
+ * The changes made by every action that is executed, undone or redone are appended to a file next
+ * to the level, such that they can be replayed onto the saved level if the editor exits without
+ * saving. Each record is only as large as the edit, unlike saving the whole level. Records are
+ * synced to disk in batches rather than one at a time.
+ *
+ *  Header - Magic "CLYJ", the version, and the ID of the save the journal follows
+ *  Record - u32 payload size, u32 CRC-32 of the payload, then the payload:
+ *           u8 record type, u32 change count, and for each change its u8 type and i32 object
+ *           ID, followed by the i32 floor and the object (See write_object_record) if the object
+ *           is added, or just the object if it is updated
+ *
+ * A record cut short by a crash fails its CRC, so it and anything after it is ignored.
+ *
+ * Objects are given new IDs each time the level is loaded, so the journal refers to objects by
+ * the ID they are given when the saved level is loaded (See FloorsSnapshot), rather than the ID
+ * they have in the editor.
+ */
+class EditJournal
+{
+  public:
+    enum class RecordType : std::uint8_t
+    {
+        Execute,
+        Undo,
+        Redo,
+    };
+
+    /// The most records, and the longest time since the oldest record was appended, before the
+    /// records are synced to disk
+    constexpr static std::size_t SYNC_RECORD_COUNT = 32;
+    constexpr static float SYNC_INTERVAL_SECONDS = 1.0f;
+
+    EditJournal() = default;
+    ~EditJournal();
+
+    EditJournal(const EditJournal&) = delete;
+    EditJournal& operator=(const EditJournal&) = delete;
+
+    /// Opens the journal of a level that has just been loaded. If the journal was written after the
+    /// save the level was loaded from, its changes are replayed onto the level and new records are
+    /// appended after them. Otherwise the journal is started again. Returns the number of records
+    /// replayed.
+    std::size_t open(const std::filesystem::path& path, std::uint64_t save_id, EditorLevel& level);
+
+    /// Syncs any records still to be synced and closes the journal, leaving the file on disk
+    void close();
+
+    /// Appends the changes made by an action
+    void append(RecordType type, const std::vector<LevelChange>& changes);
+
+    /// Syncs the records to disk if the oldest record still to be synced is old enough. Called
+    /// regularly such that the last few records are synced even if there are no more edits.
+    void update();
+
+    /// Called when the level starts being saved, with the objects in the order they are saved.
+    /// Records appended until "end_save" are also kept in memory, such that they can be moved into
+    /// the journal following the save.
+    void begin_save(const std::filesystem::path& path, std::uint64_t save_id,
+                    const FloorsSnapshot& snapshot);
+
+    /// If the save succeeded, replaces the journal with one following the save, which only holds
+    /// the records appended since the save began. Otherwise the journal is left as it is.
+    void end_save(bool success);
+
+  private:
+    /// Maps IDs of objects in the editor to the IDs the journal refers to them by
+    struct IdMapping
+    {
+        std::unordered_map<ObjectId, ObjectId> journal_ids;
+
+        /// Objects loaded with the level are referred to by their own ID, unless mapped above
+        ObjectId identity_below = 0;
+
+        /// The ID given to objects added since the journal started
+        ObjectId next_journal_id = 0;
+
+        ObjectId get_journal_id(ObjectId id);
+    };
+
+    struct PendingSave
+    {
+        std::filesystem::path path;
+        std::uint64_t save_id = 0;
+        IdMapping ids;
+        std::vector<std::vector<std::byte>> records;
+    };
+
+    /// Creates the journal with just the header, replacing any existing journal
+    bool start(const std::filesystem::path& path, std::uint64_t save_id);
+
+    /// Reads the valid records of the journal and applies them to the level. Returns the number
+    /// of records applied and the size of the file up to the end of the last valid record.
+    std::pair<std::size_t, std::uint64_t> replay(std::span<const std::byte> data,
+                                                 EditorLevel& level);
+
+    /// Encodes the changes into a record, including its size and CRC
+    static std::vector<std::byte> encode_record(RecordType type,
+                                                const std::vector<LevelChange>& changes,
+                                                IdMapping& ids);
+
+    void write_record(const std::vector<std::byte>& record);
+    void sync();
+
+    AppendFile file_;
+    std::filesystem::path path_;
+    IdMapping ids_;
+
+    std::size_t unsynced_records_ = 0;
+    sf::Clock unsynced_clock_;
+
+    std::optional<PendingSave> pending_save_;
+};
\ No newline at end of file
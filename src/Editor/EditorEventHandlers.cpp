@@ -37,7 +37,7 @@ bool ObjectMoveHandler::handle_move_events(const sf::Event& event, const EditorS
             // Check if any of the selected objects were clicked - if they were then it means
             // the whole group can be moved around
             bool moving_selection = false;
-            for (auto object : p_level_->get_objects(state.selection.objects))
+            for (auto object : p_level_->get_objects(state.selection.get_objects()))
             {
                 moving_selection |= object->try_select_2d(state.world_position_hovered);
             }
@@ -80,9 +80,12 @@ bool ObjectMoveHandler::handle_move_events(const sf::Event& event, const EditorS
                 std::vector<LevelObject> new_objects;
                 new_objects.reserve(moving_objects_.size());
 
-                for (auto object : moving_objects_)
+                for (auto& handle : moving_objects_)
                 {
-                    new_objects.push_back(*object);
+                    if (auto object = p_level_->get_object(handle))
+                    {
+                        new_objects.push_back(*object);
+                    }
                 }
 
                 for (auto& new_object : new_objects)
@@ -117,10 +120,11 @@ bool ObjectMoveHandler::is_moving_objects() const
 }
 
 bool ObjectMoveHandler::try_start_move_mouse_picker(const MousePickingState& picker_state,
-                                                    gl::Shader& picker_shader,
-                                                    const EditorLevel& level,
+                                                    gl::Shader& picker_shader, EditorLevel& level,
                                                     const EditorState& state, ToolType current_tool,
-                                                    const Camera& camera_3d)
+                                                    const Camera& camera_3d,
+                                                    const FloorRange& floor_range,
+                                                    bool ray_cast_picking)
 {
     // Prevent moving walls just placed down
     if (last_object_was_created_wall(state, current_tool))
@@ -134,12 +138,28 @@ bool ObjectMoveHandler::try_start_move_mouse_picker(const MousePickingState& pic
         return false;
     }
 
-    level.render_subset_to_picker(picker_shader, state.selection.objects);
+    std::optional<ObjectId> picked_id;
+    if (ray_cast_picking)
+    {
+        // Offset to the centre of the pixel, matching what glReadPixels would sample
+        auto ray = camera_3d.get_mouse_ray({picker_state.unscaled_point.x + 0.5f,
+                                            picker_state.unscaled_point.y + 0.5f});
+        picked_id = level.pick_object(ray, state.selection, floor_range);
+    }
+    else
+    {
+        level.render_subset_to_picker(picker_shader, state.selection, floor_range);
+
+        GLint pixel_id = 0;
+        glReadPixels(picker_state.point.x, picker_state.point.y, 1, 1, GL_RED_INTEGER, GL_INT,
+                     &pixel_id);
+        if (pixel_id > -1)
+        {
+            picked_id = pixel_id;
+        }
+    }
 
-    GLint picked_id = 0;
-    glReadPixels(picker_state.point.x, picker_state.point.y, 1, 1, GL_RED_INTEGER, GL_INT,
-                 &picked_id);
-    if (picked_id > -1)
+    if (picked_id)
     {
         moving_object_3d_ = true;
         auto intersect = camera_3d.find_mouse_floor_intersect(
@@ -159,8 +179,8 @@ void ObjectMoveHandler::start_move(const Selection& selection)
 {
     moving_object_cache_.clear();
     moving_objects_.clear();
-    moving_objects_ = p_level_->get_objects(selection.objects);
-    for (auto object : moving_objects_)
+    moving_objects_ = p_level_->get_object_handles(selection.get_objects());
+    for (auto object : p_level_->get_objects(selection.get_objects()))
     {
         moving_object_cache_.push_back(*object);
     }
@@ -171,9 +191,9 @@ bool ObjectMoveHandler::last_object_was_created_wall(const EditorState& state,
 {
     // To avoid moving a wall that was just placed when placing an adjacent wall, this
     // checks if the last object was a wall. If it is, then it cannot be moved.
-    if (state.selection.objects.size() == 1 && current_tool == ToolType::CreateWall)
+    if (state.selection.get_objects().size() == 1 && current_tool == ToolType::CreateWall)
     {
-        auto object = p_level_->get_object(state.selection.objects[0]);
+        auto object = p_level_->get_object(state.selection.get_objects()[0]);
         if (!object)
         {
             return true;
@@ -236,13 +256,13 @@ void CopyPasteHandler::copy_selection(const Selection& selection, int current_fl
     copied_objects_.clear();
     copied_objects_floors_.clear();
 
-    auto [objects, floors] = p_level_->copy_objects_and_floors(selection.objects);
+    auto [objects, floors] = p_level_->copy_objects_and_floors(selection.get_objects());
 
     copied_objects_ = std::move(objects);
     copied_objects_floors_ = std::move(floors);
     copy_start_floor_ = current_floor;
 
-    p_messages_manager_->add_message("Copied " + std::to_string(selection.objects.size()) +
+    p_messages_manager_->add_message("Copied " + std::to_string(selection.get_objects().size()) +
                                      " object(s).");
 }
 
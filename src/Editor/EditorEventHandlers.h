@@ -5,6 +5,7 @@
 #include <SFML/Window/Event.hpp>
 #include <glm/glm.hpp>
 
+#include "FloorManager.h"
 #include "LevelObjects/LevelObject.h"
 #include "Tools/Tool.h"
 
@@ -14,6 +15,7 @@ class MessagesManager;
 struct Selection;
 struct MousePickingState;
 class Camera;
+struct FloorRange;
 
 /// Handles moving selected objects in the editor.
 class ObjectMoveHandler
@@ -28,10 +30,14 @@ class ObjectMoveHandler
     glm::vec2 get_move_offset() const;
     bool is_moving_objects() const;
 
+    /// Starts moving the selection if it is clicked in the 3D view. When "ray_cast_picking" is
+    /// set, the level's PickingBVH is used rather than rendering to the picker texture. Objects on
+    /// floors outside of the range cannot be clicked.
     bool try_start_move_mouse_picker(const MousePickingState& picker_state,
-                                     gl::Shader& picker_shader, const EditorLevel& level,
+                                     gl::Shader& picker_shader, EditorLevel& level,
                                      const EditorState& state, ToolType current_tool,
-                                     const Camera& camera_3d);
+                                     const Camera& camera_3d, const FloorRange& floor_range,
+                                     bool ray_cast_picking);
 
   private:
     void start_move(const Selection& selection);
@@ -53,8 +59,9 @@ class ObjectMoveHandler
     /// returned to when CTRL+Z is done
     std::vector<LevelObject> moving_object_cache_;
 
-    /// The objects being moved
-    std::vector<LevelObject*> moving_objects_;
+    /// The objects being moved. Handles are used as objects can be added or removed mid-move, which
+    /// would invalidate pointers.
+    std::vector<ObjectHandle> moving_objects_;
 
     EditorLevel* p_level_;
     ActionManager* p_action_manager_;
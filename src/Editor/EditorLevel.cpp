@@ -1,6 +1,7 @@
 #include "EditorLevel.h"
 
 #include <fstream>
+#include <tuple>
 
 #include <imgui.h>
 #include <nlohmann/json.hpp>
@@ -31,164 +32,375 @@ LevelObject& EditorLevel::add_object(const LevelObject& object, int floor_number
 
 LevelObject& EditorLevel::add_object(const LevelObject& object, Floor& floor)
 {
-    changes_made_since_last_save_ = true;
+    // Shared geometry is only generated if no other object is using it yet
+    LevelObjectsMesh3D mesh;
+    if (!GeometryCache::make_key(object, floor.real_floor))
+    {
+        object.to_geometry(floor.real_floor, mesh);
+    }
+
+    auto [mesh_2d, primitive] = object.to_2d_geometry(*p_drawing_pad_texture_map_);
+    return add_object_with_geometry(object, floor, std::move(mesh), std::move(mesh_2d), primitive);
+}
+
+LevelObject& EditorLevel::add_object_with_geometry(const LevelObject& object, Floor& floor,
+                                                   LevelObjectsMesh3D mesh, Mesh2DWorld mesh_2d,
+                                                   gl::PrimitiveType primitive_2d)
+{
+    revision_++;
 
     LevelObject new_object = object;
     new_object.object_id = current_id_++;
 
+    ObjectLocation location{
+        .floor_index = static_cast<size_t>(&floor - floors_manager_.floors.data()),
+    };
+
     // Add the 3D mesh
     Floor::LevelMesh level_mesh = {
         .id = new_object.object_id,
-        .mesh = object.to_geometry(floor.real_floor),
+        .mesh = std::move(mesh),
     };
-    level_mesh.mesh.update();
-    floor.meshes.push_back(std::move(level_mesh));
+    auto offset = GeometryCache::get_offset(new_object);
+    if (auto key = GeometryCache::make_key(new_object, floor.real_floor))
+    {
+        level_mesh.bounds = use_shared_geometry(level_mesh, location, *key).bounds;
+    }
+    else
+    {
+        level_mesh.mesh.update();
+        level_mesh.bounds = level_mesh.mesh.calculate_bounds();
+    }
+    level_mesh.bounds.min += offset;
+    level_mesh.bounds.max += offset;
+    geometry_cache_.set_offset(new_object.object_id, offset);
+
+    auto& geometry = level_mesh.geometry();
+    picking_bvh_.insert(new_object.object_id, geometry.vertices, geometry.indices, offset);
+    location.mesh = floor.meshes.insert(std::move(level_mesh));
+    floor.batch_needs_rebuild = true;
+    floor.optimised_mesh_needs_rebuild = true;
 
     // Add the 2D mesh
-    auto [mesh, primitive] = object.to_2d_geometry(*p_drawing_pad_texture_map_);
     Floor::LevelMesh level_mesh_2d = {
-        .id = new_object.object_id, .mesh = std::move(mesh), .primitive = primitive};
+        .id = new_object.object_id, .mesh = std::move(mesh_2d), .primitive = primitive_2d};
     level_mesh_2d.mesh.update();
-    floor.meshes_2d.push_back(std::move(level_mesh_2d));
+    location.mesh_2d = floor.meshes_2d.insert(std::move(level_mesh_2d));
+    floor.draw_list_2d_needs_rebuild = true;
+
+    location.object = floor.objects.insert(new_object);
+    floor.spatial_grid.insert(new_object.object_id, new_object.get_bounds_2d());
+
+    // Record where the object and its meshes are such that it can be found without a search
+    object_locations_[new_object.object_id] = location;
 
     // Return the new object
-    return floor.objects.emplace_back(new_object);
+    return *floor.objects.get(location.object);
 }
 
-void EditorLevel::update_object(const LevelObject& object, int floor_number)
+const GeometryCache::Entry&
+EditorLevel::use_shared_geometry(Floor::LevelMesh<LevelObjectsMesh3D>& level_mesh,
+                                 ObjectLocation& location, const GeometryCache::Key& key)
 {
-    for (auto& floor : floors_manager_.floors)
+    // Acquired before releasing the previous geometry such that it is not freed and generated
+    // again when it is the same, such as when the object has only moved
+    auto& shared = geometry_cache_.acquire(key);
+    if (location.shared_geometry)
     {
-        for (auto& mesh : floor.meshes)
-        {
-            if (mesh.id == object.object_id)
-            {
-                mesh.mesh = object.to_geometry(floor.real_floor);
-                mesh.mesh.update();
-                break;
-            }
-        }
+        geometry_cache_.release(*location.shared_geometry);
+    }
+    location.shared_geometry = key;
+    level_mesh.p_shared_mesh = &shared.mesh;
+    return shared;
+}
 
-        for (auto& mesh : floor.meshes_2d)
-        {
-            if (mesh.id == object.object_id)
-            {
-                mesh.mesh = object.to_2d_geometry(*p_drawing_pad_texture_map_).first;
-                mesh.mesh.update();
-                break;
-            }
-        }
+void EditorLevel::update_object(const LevelObject& object, [[maybe_unused]] int floor_number)
+{
+    auto itr = object_locations_.find(object.object_id);
+    if (itr == object_locations_.end())
+    {
+        return;
+    }
+    auto& location = itr->second;
+    auto& floor = floors_manager_.floors[location.floor_index];
 
-        // Copy the new object to the old object
-        for (auto& old_object : floor.objects)
-        {
-            if (old_object.object_id == object.object_id)
-            {
-                old_object = object;
-                break;
-            }
-        }
+    // Objects that have only been moved have their existing geometry translated, rather than
+    // regenerated, and only their vertices are uploaded again
+    auto translation = floor.objects.get(location.object)->find_translation(object);
+
+    auto& level_mesh = *floor.meshes.get(location.mesh);
+    auto offset = GeometryCache::get_offset(object);
+    if (auto key = GeometryCache::make_key(object, floor.real_floor))
+    {
+        // Objects that have only moved keep the same geometry, so only their offset changes
+        level_mesh.bounds = use_shared_geometry(level_mesh, location, *key).bounds;
+    }
+    else if (translation)
+    {
+        auto translation_3d = glm::vec3{translation->x, 0, translation->y} / TILE_SIZE_F;
+        level_mesh.mesh.translate(translation_3d);
+        level_mesh.mesh.update_vertices();
+        level_mesh.bounds.min += translation_3d;
+        level_mesh.bounds.max += translation_3d;
+    }
+    else
+    {
+        // The geometry is regenerated into the existing mesh rather than replacing it, such that
+        // both its CPU buffers and its MeshArena space are reused when the new geometry fits
+        object.to_geometry(floor.real_floor, level_mesh.mesh);
+        level_mesh.mesh.update();
+        level_mesh.bounds = level_mesh.mesh.calculate_bounds();
     }
-    changes_made_since_last_save_ = true;
+    level_mesh.bounds.min += offset;
+    level_mesh.bounds.max += offset;
+    geometry_cache_.set_offset(object.object_id, offset);
+    floor.bounds.expand(level_mesh.bounds);
+
+    auto& geometry = level_mesh.geometry();
+    picking_bvh_.update(object.object_id, geometry.vertices, geometry.indices, offset);
+    if (!floor.batch_needs_rebuild && !floor.batch.try_update(object.object_id, geometry))
+    {
+        floor.batch_needs_rebuild = true;
+    }
+    floor.optimised_mesh_needs_rebuild = true;
+
+    auto& mesh_2d = floor.meshes_2d.get(location.mesh_2d)->mesh;
+    auto had_buffered_2d = mesh_2d.has_buffered();
+    if (translation)
+    {
+        mesh_2d.translate(*translation);
+        mesh_2d.update_vertices();
+    }
+    else
+    {
+        object.to_2d_geometry(*p_drawing_pad_texture_map_, mesh_2d);
+        mesh_2d.update();
+    }
+    if (mesh_2d.has_buffered() != had_buffered_2d)
+    {
+        floor.draw_list_2d_needs_rebuild = true;
+    }
+
+    // Copy the new object to the old object
+    *floor.objects.get(location.object) = object;
+    floor.spatial_grid.update(object.object_id, object.get_bounds_2d());
+
+    revision_++;
 }
 
 void EditorLevel::remove_object(ObjectId id)
 {
-    for (auto& floor : floors_manager_.floors)
+    auto itr = object_locations_.find(id);
+    if (itr == object_locations_.end())
+    {
+        return;
+    }
+    auto location = itr->second;
+    object_locations_.erase(itr);
+
+    auto& floor = floors_manager_.floors[location.floor_index];
+    floor.objects.erase(location.object);
+    floor.meshes.erase(location.mesh);
+    floor.batch_needs_rebuild = true;
+    floor.optimised_mesh_needs_rebuild = true;
+    floor.meshes_2d.erase(location.mesh_2d);
+    floor.draw_list_2d_needs_rebuild = true;
+    floor.spatial_grid.remove(id);
+    picking_bvh_.remove(id);
+    if (location.shared_geometry)
     {
-        std::erase_if(floor.meshes, [id](const auto& mesh) { return mesh.id == id; });
-        std::erase_if(floor.meshes_2d, [id](const auto& mesh) { return mesh.id == id; });
-        std::erase_if(floor.objects, [id](const auto& object) { return object.object_id == id; });
+        geometry_cache_.release(*location.shared_geometry);
     }
-    changes_made_since_last_save_ = true;
+
+    revision_++;
 }
 
 void EditorLevel::set_object_id(ObjectId current_id, ObjectId new_id)
 {
-    for (auto& floor : floors_manager_.floors)
+    auto node = object_locations_.extract(current_id);
+    if (node.empty())
+    {
+        return;
+    }
+    auto location = node.mapped();
+    auto& floor = floors_manager_.floors[location.floor_index];
+
+    floor.objects.get(location.object)->object_id = new_id;
+    floor.meshes.get(location.mesh)->id = new_id;
+    floor.batch_needs_rebuild = true;
+    floor.meshes_2d.get(location.mesh_2d)->id = new_id;
+    floor.draw_list_2d_needs_rebuild = true;
+    floor.spatial_grid.set_object_id(current_id, new_id);
+    picking_bvh_.set_object_id(current_id, new_id);
+    geometry_cache_.set_object_id(current_id, new_id);
+
+    node.key() = new_id;
+    object_locations_.insert(std::move(node));
+}
+
+void EditorLevel::render(gl::Shader& scene_shader, const Selection& selection,
+                         const FloorRange& floor_range, const glm::vec3& selected_offset,
+                         const std::optional<Frustum>& frustum, bool optimise_geometry)
+{
+    update_batches();
+    auto floors_with_active = find_floors_with_objects(selection.get_objects());
+    render_stats_ = {};
+
+    // Objects with shared geometry are moved to their position in the shader
+    geometry_cache_.bind_offsets();
+    scene_shader.set_uniform("use_object_offsets", true);
+
+    // The selected objects are drawn after the rest, as they use different uniforms
+    std::vector<std::pair<const MeshBatch<VertexLevelObjects>*, DrawCommandRange>> active_draws;
+
+    // Floors outside of the range are drawn last in one pass, as they are blended
+    std::vector<Floor*> ghost_draws;
+
+    // The optimised meshes are in world space, so must not be moved by the object offsets
+    auto draw_optimised = [&](Floor& floor)
+    {
+        update_optimised_mesh(floor);
+        auto& stats = floor.optimisation_stats;
+        render_stats_.optimised_floors++;
+        render_stats_.optimised_triangles_removed += stats.input_triangles - stats.output_triangles;
+        if (floor.optimised_mesh.has_buffered() && floor.optimised_mesh.indices_count() > 0)
+        {
+            scene_shader.set_uniform("use_object_offsets", false);
+            floor.optimised_mesh.bind().draw_elements();
+            scene_shader.set_uniform("use_object_offsets", true);
+        }
+    };
+
+    // Selected objects are drawn offset, so their bounds must be moved to match
+    auto active_offset = selected_offset / TILE_SIZE_F;
+    auto is_visible = [&](const Floor& floor, ObjectId id)
+    {
+        auto bounds = floor.meshes.get(find_location(id)->mesh)->bounds;
+        if (selection.contains(id))
+        {
+            bounds.min += active_offset;
+            bounds.max += active_offset;
+        }
+        return frustum->is_visible(bounds);
+    };
+
+    scene_shader.set_uniform("selected", false);
+
+    for (size_t i = 0; i < floors_manager_.floors.size(); i++)
     {
-        for (auto& mesh : floor.meshes)
+        auto& floor = floors_manager_.floors[i];
+        auto object_count = static_cast<int>(floor.meshes.size());
+
+        if (!floor_range.contains(floor.real_floor))
         {
-            if (mesh.id == current_id)
+            render_stats_.hidden_floors++;
+            if (floor_range.ghost_hidden_floors && (!frustum || frustum->is_visible(floor.bounds)))
             {
-                mesh.id = new_id;
-                break;
+                ghost_draws.push_back(&floor);
             }
+            continue;
         }
 
-        for (auto& mesh : floor.meshes_2d)
+        // Floors without selected objects can be drawn using their optimised mesh, which can only
+        // be culled as a whole as it has no per-object draw commands
+        if (optimise_geometry && !floors_with_active[i])
         {
-            if (mesh.id == current_id)
+            if (frustum && !frustum->is_visible(floor.bounds))
             {
-                mesh.id = new_id;
-                break;
+                render_stats_.culled_objects += object_count;
+                render_stats_.culled_floors++;
+                continue;
             }
+            draw_optimised(floor);
+            render_stats_.drawn_objects += object_count;
+            continue;
         }
 
-        for (auto& object : floor.objects)
+        if (!frustum)
         {
-            if (object.object_id == current_id)
+            // Most floors have no selected objects, so can be drawn using the pre-built commands
+            render_stats_.drawn_objects += object_count;
+            if (!floors_with_active[i])
             {
-                object.object_id = new_id;
-                break;
+                floor.batch.draw();
+                continue;
             }
+
+            auto [active, inactive] =
+                floor.batch.partition([&](ObjectId id) { return selection.contains(id); });
+            floor.batch.draw(inactive);
+            active_draws.emplace_back(&floor.batch, active);
+            continue;
         }
+
+        // Reject the whole floor first, which is not possible when selected objects may have been
+        // moved outside of the floor's bounds
+        if (!floors_with_active[i] && !frustum->is_visible(floor.bounds))
+        {
+            render_stats_.culled_objects += object_count;
+            render_stats_.culled_floors++;
+            continue;
+        }
+
+        auto [active, inactive] = floor.batch.partition(
+            [&](ObjectId id) { return selection.contains(id); },
+            [&](ObjectId id) { return is_visible(floor, id); });
+        floor.batch.draw(inactive);
+        if (active.count > 0)
+        {
+            active_draws.emplace_back(&floor.batch, active);
+        }
+
+        render_stats_.drawn_objects += active.count + inactive.count;
+        render_stats_.culled_objects += object_count - (active.count + inactive.count);
     }
-}
 
-void EditorLevel::render(gl::Shader& scene_shader, const std::vector<ObjectId>& active_objects,
-                         int current_floor, const glm::vec3& selected_offset)
-{
+    // Render the selected object seperate
 
-    std::vector<LevelObjectsMesh3D*> p_active;
+    scene_shader.set_uniform("selected", true);
+
+    scene_shader.set_model_matrix(create_model_matrix({.position = selected_offset / TILE_SIZE_F}));
+    for (auto [batch, range] : active_draws)
+    {
+        batch->draw(range);
+    }
 
     scene_shader.set_uniform("selected", false);
 
-    for (auto& floor : floors_manager_.floors)
+    // Ghosted floors are drawn without textures or per-object culling to keep them cheap, and
+    // without writing depth such that they never hide the floors being edited
+    if (!ghost_draws.empty())
     {
-        // Render floors only from the current floor and below
-        if (floor.real_floor > current_floor)
-        {
-            // continue;
-        }
+        scene_shader.set_uniform("ghosted", true);
+        scene_shader.set_model_matrix(create_model_matrix({}));
+        gl::enable(gl::Capability::Blend);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glDepthMask(GL_FALSE);
 
-        for (auto& object : floor.meshes)
+        for (auto p_floor : ghost_draws)
         {
-            if (!object.mesh.has_buffered())
-            {
-                continue;
-            }
-
-            if (contains(active_objects, object.id))
+            if (optimise_geometry)
             {
-                p_active.push_back(&object.mesh);
+                draw_optimised(*p_floor);
             }
             else
             {
-                object.mesh.bind().draw_elements();
+                p_floor->batch.draw();
             }
         }
-    }
-
-    // Render the selected object seperate
 
-    scene_shader.set_uniform("selected", true);
-
-    scene_shader.set_uniform("model_matrix",
-                             create_model_matrix({.position = selected_offset / TILE_SIZE_F}));
-    for (auto mesh : p_active)
-    {
-        mesh->bind().draw_elements();
+        glDepthMask(GL_TRUE);
+        gl::disable(gl::Capability::Blend);
+        scene_shader.set_uniform("ghosted", false);
     }
 
-    scene_shader.set_uniform("selected", false);
+    scene_shader.set_uniform("use_object_offsets", false);
 }
 
-void EditorLevel::render_2d(gl::Shader& scene_shader_2d,
-                            const std::vector<ObjectId>& active_objects, int current_floor,
-                            const glm::vec2& selected_offset)
+void EditorLevel::render_2d(gl::Shader& scene_shader_2d, const Selection& selection,
+                            int current_floor, const glm::vec2& selected_offset)
 {
-    auto render_group = [&](const std::vector<Floor::LevelMesh<Mesh2DWorld>*>& group)
+    auto render_group = [&](const std::vector<const Floor::LevelMesh<Mesh2DWorld>*>& group)
     {
         for (auto object : group)
         {
@@ -196,150 +408,253 @@ void EditorLevel::render_2d(gl::Shader& scene_shader_2d,
         }
     };
 
-    // Sort the objects into groups
-    // "current" refers to objects on the current floor
-    // "below" refers to objects on the floor below
-    std::vector<Floor::LevelMesh<Mesh2DWorld>*> p_active;
-    std::vector<Floor::LevelMesh<Mesh2DWorld>*> p_below;
-    std::vector<Floor::LevelMesh<Mesh2DWorld>*> p_current;
-
-    std::vector<Floor::LevelMesh<Mesh2DWorld>*> p_active_wall;
-    std::vector<Floor::LevelMesh<Mesh2DWorld>*> p_below_wall;
-    std::vector<Floor::LevelMesh<Mesh2DWorld>*> p_current_wall;
-
-    for (auto& floor : floors_manager_.floors)
+    // The draw lists only need to be rebuilt when the selection changes, rather than every frame
+    if (draw_list_2d_selection_version_ != selection.get_version())
     {
-        // Render floors only from the current floor and below
-        if (floor.real_floor == current_floor - 1)
-        {
-            for (auto& object : floor.meshes_2d)
-            {
-                object.primitive == gl::PrimitiveType::Lines ? p_below_wall.push_back(&object)
-                                                             : p_below.push_back(&object);
-            }
-        }
-        else if (floor.real_floor == current_floor)
+        draw_list_2d_selection_version_ = selection.get_version();
+        for (auto& floor : floors_manager_.floors)
         {
-            for (auto& object : floor.meshes_2d)
-            {
-                if (!object.mesh.has_buffered())
-                {
-                    continue;
-                }
-
-                if (contains(active_objects, object.id))
-                {
-                    object.primitive == gl::PrimitiveType::Lines ? p_active_wall.push_back(&object)
-                                                                 : p_active.push_back(&object);
-                }
-                else
-                {
-                    object.primitive == gl::PrimitiveType::Lines ? p_current_wall.push_back(&object)
-                                                                 : p_current.push_back(&object);
-                }
-            }
+            floor.draw_list_2d_needs_rebuild = true;
         }
     }
 
+    // "current" refers to objects on the current floor
+    // "below" refers to objects on the floor below
+    static const Floor::DrawList2D empty_draw_list;
+    const Floor::DrawList2D* p_below = &empty_draw_list;
+    const Floor::DrawList2D* p_current = &empty_draw_list;
+    if (auto floor = floors_manager_.find_floor(current_floor - 1))
+    {
+        update_draw_list_2d(**floor, selection);
+        p_below = &(*floor)->draw_list_2d;
+    }
+    if (auto floor = floors_manager_.find_floor(current_floor))
+    {
+        update_draw_list_2d(**floor, selection);
+        p_current = &(*floor)->draw_list_2d;
+    }
+
     // Render the objects on the floor below
     scene_shader_2d.set_uniform("use_texture_alpha_channel", true);
-    scene_shader_2d.set_uniform("model_matrix", create_model_matrix({}));
+    scene_shader_2d.set_model_matrix(create_model_matrix({}));
     glLineWidth(2);
     scene_shader_2d.set_uniform("is_selected", false);
     scene_shader_2d.set_uniform("on_floor_below", true);
 
+    // Selection is only shown on the current floor, so selected objects below are drawn as normal
     scene_shader_2d.set_uniform("use_texture", false);
-    render_group(p_below_wall);
+    render_group(p_below->walls);
+    render_group(p_below->active_walls);
     scene_shader_2d.set_uniform("use_texture", true);
-    render_group(p_below);
+    render_group(p_below->shapes);
+    render_group(p_below->active_shapes);
 
     // Render objects on the current floor
     scene_shader_2d.set_uniform("on_floor_below", false);
 
     scene_shader_2d.set_uniform("use_texture", true);
-    render_group(p_current);
+    render_group(p_current->shapes);
 
     scene_shader_2d.set_uniform("use_texture", false);
-    render_group(p_current_wall);
+    render_group(p_current->walls);
 
     // Render the selected objects
     glLineWidth(3);
     scene_shader_2d.set_uniform("is_selected", true);
-    scene_shader_2d.set_uniform(
-        "model_matrix",
+    scene_shader_2d.set_model_matrix(
         create_model_matrix({.position = {selected_offset.x, selected_offset.y, 0}}));
 
     scene_shader_2d.set_uniform("use_texture", false);
-    render_group(p_active_wall);
+    render_group(p_current->active_walls);
 
     scene_shader_2d.set_uniform("use_texture", true);
-    render_group(p_active);
+    render_group(p_current->active_shapes);
 }
 
-void EditorLevel::render_to_picker(gl::Shader& picker_shader) const
+void EditorLevel::render_to_picker(gl::Shader& picker_shader, const FloorRange& floor_range)
 {
-    picker_shader.set_uniform("model_matrix", create_model_matrix({}));
+    update_batches();
+
+    // The batches pass the object ID via gl_BaseInstance, which is added to the object_id uniform
+    picker_shader.set_model_matrix(create_model_matrix({}));
+    picker_shader.set_uniform("object_id", 0);
+    geometry_cache_.bind_offsets();
+    picker_shader.set_uniform("use_object_offsets", true);
     for (auto& floor : floors_manager_.floors)
     {
-        for (auto& object : floor.meshes)
+        if (floor_range.contains(floor.real_floor))
         {
-            if (!object.mesh.has_buffered())
-            {
-                continue;
-            }
+            floor.batch.draw();
+        }
+    }
+    picker_shader.set_uniform("use_object_offsets", false);
+}
 
-            picker_shader.set_uniform("object_id", object.id);
-            object.mesh.bind().draw_elements();
+void EditorLevel::render_subset_to_picker(gl::Shader& picker_shader, const Selection& selection,
+                                          const FloorRange& floor_range)
+{
+    update_batches();
+    auto floors_with_objects = find_floors_with_objects(selection.get_objects());
+
+    picker_shader.set_model_matrix(create_model_matrix({}));
+    picker_shader.set_uniform("object_id", 0);
+    geometry_cache_.bind_offsets();
+    picker_shader.set_uniform("use_object_offsets", true);
+    for (size_t i = 0; i < floors_manager_.floors.size(); i++)
+    {
+        auto& floor = floors_manager_.floors[i];
+        if (floors_with_objects[i] && floor_range.contains(floor.real_floor))
+        {
+            auto& batch = floor.batch;
+            batch.draw(batch.partition([&](ObjectId id) { return selection.contains(id); }).first);
         }
     }
+    picker_shader.set_uniform("use_object_offsets", false);
 }
 
-void EditorLevel::render_subset_to_picker(gl::Shader& picker_shader,
-                                          const std::vector<ObjectId>& objects) const
+void EditorLevel::update_batches()
 {
-    picker_shader.set_uniform("model_matrix", create_model_matrix({}));
     for (auto& floor : floors_manager_.floors)
     {
+        if (!floor.batch_needs_rebuild)
+        {
+            continue;
+        }
+
+        floor.batch.clear();
+        floor.bounds = {};
         for (auto& object : floor.meshes)
         {
-            if (!object.mesh.has_buffered() || std::ranges::find(objects, object.id) == objects.end())
-            {
-                continue;
-            }
+            floor.batch.add(object.id, object.geometry());
+            floor.bounds.expand(object.bounds);
+        }
+        floor.batch.buffer();
+        floor.batch_needs_rebuild = false;
+    }
+}
+
+void EditorLevel::update_optimised_mesh(Floor& floor)
+{
+    if (!floor.optimised_mesh_needs_rebuild)
+    {
+        return;
+    }
+
+    GeometryOptimiser optimiser;
+    for (auto& object : floor.meshes)
+    {
+        // Pillars are the only objects that enclose a volume, the rest are surfaces that can be
+        // seen from both sides
+        auto& level_object = *floor.objects.get(find_location(object.id)->object);
+        bool closed = std::holds_alternative<PillarObject>(level_object.object_type);
+
+        auto& geometry = object.geometry();
+        optimiser.add(geometry.vertices, geometry.indices,
+                      geometry_cache_.get_object_offset(object.id), object.id, closed);
+    }
+
+    floor.optimised_mesh.clear();
+    MeshBuilder builder(floor.optimised_mesh);
+    floor.optimisation_stats = optimiser.build(builder);
+    floor.optimised_mesh.update();
+    floor.optimised_mesh_needs_rebuild = false;
+}
 
-            if (object.id)
+void EditorLevel::update_draw_list_2d(Floor& floor, const Selection& selection)
+{
+    if (!floor.draw_list_2d_needs_rebuild)
+    {
+        return;
+    }
 
-            picker_shader.set_uniform("object_id", object.id);
-            object.mesh.bind().draw_elements();
+    auto& draw_list = floor.draw_list_2d;
+    draw_list.shapes.clear();
+    draw_list.walls.clear();
+    draw_list.active_shapes.clear();
+    draw_list.active_walls.clear();
+
+    for (auto& object : floor.meshes_2d)
+    {
+        if (!object.mesh.has_buffered() || object.mesh.indices_count() == 0)
+        {
+            continue;
+        }
+
+        bool is_wall = object.primitive == gl::PrimitiveType::Lines;
+        if (selection.contains(object.id))
+        {
+            (is_wall ? draw_list.active_walls : draw_list.active_shapes).push_back(&object);
+        }
+        else
+        {
+            (is_wall ? draw_list.walls : draw_list.shapes).push_back(&object);
         }
     }
+    floor.draw_list_2d_needs_rebuild = false;
+}
+
+std::vector<bool>
+EditorLevel::find_floors_with_objects(const std::vector<ObjectId>& object_ids) const
+{
+    std::vector<bool> floors(floors_manager_.floors.size(), false);
+    for (auto id : object_ids)
+    {
+        if (auto location = find_location(id))
+        {
+            floors[location->floor_index] = true;
+        }
+    }
+    return floors;
+}
+
+std::optional<ObjectId> EditorLevel::pick_object(const Ray& ray, const FloorRange& floor_range)
+{
+    auto filter = [&](ObjectId id) { return is_in_floor_range(id, floor_range); };
+    if (auto hit = picking_bvh_.cast_ray(ray, filter))
+    {
+        return hit->id;
+    }
+    return {};
+}
+
+std::optional<ObjectId> EditorLevel::pick_object(const Ray& ray, const Selection& selection,
+                                                 const FloorRange& floor_range)
+{
+    auto filter = [&](ObjectId id)
+    {
+        return selection.contains(id) && is_in_floor_range(id, floor_range);
+    };
+    if (auto hit = picking_bvh_.cast_ray(ray, filter))
+    {
+        return hit->id;
+    }
+    return {};
 }
 
 LevelObject* EditorLevel::try_select(glm::vec2 selection_tile, const LevelObject* p_active_object,
                                      int current_floor)
 {
-    for (auto& floor : floors_manager_.floors)
+    // 2D Selection can only happen for objects on the current floor
+    auto floor = floors_manager_.find_floor(current_floor);
+    if (!floor)
+    {
+        return nullptr;
+    }
+
+    std::vector<ObjectId> candidates;
+    (*floor)->spatial_grid.query(selection_tile, candidates);
+    for (auto id : candidates)
     {
-        // 2D Selection can only happen for objects on the current floor
-        if (floor.real_floor != current_floor)
+        if (p_active_object && p_active_object->object_id == id)
         {
             continue;
         }
 
-        for (auto& object : floor.objects)
+        auto object = get_object(id);
+        if (object && object->try_select_2d(selection_tile))
         {
-            if (object.try_select_2d(selection_tile))
-            {
-                if (p_active_object && p_active_object->object_id == object.object_id)
-                {
-                    continue;
-                }
-                return &object;
-            }
+            return object;
         }
-
-        // Found the right floor so can exit early
-        break;
     }
     return nullptr;
 }
@@ -347,50 +662,33 @@ LevelObject* EditorLevel::try_select(glm::vec2 selection_tile, const LevelObject
 void EditorLevel::select_within(const Rectangle& selection_area, Selection& selection,
                                 int floor_number)
 {
-    for (auto& floor : floors_manager_.floors)
+    auto floor = floors_manager_.find_floor(floor_number);
+    if (!floor)
     {
-        if (floor.real_floor != floor_number)
-        {
-            continue;
-        }
+        return;
+    }
 
-        for (auto& object : floor.objects)
+    std::vector<ObjectId> candidates;
+    (*floor)->spatial_grid.query(selection_area, candidates);
+    for (auto id : candidates)
+    {
+        auto object = get_object(id);
+        if (object && object->is_within(selection_area))
         {
-            if (object.is_within(selection_area))
-            {
-                selection.add_to_selection(object.object_id);
-            }
+            selection.add_to_selection(id);
         }
-
-        // Found the right floor so can exit early
-        break;
     }
 }
 
 std::vector<LevelObject*> EditorLevel::get_objects(const std::vector<ObjectId>& object_ids)
 {
-    // Find objects with the given ID - maybe there is better way than a triple nested loop?
     std::vector<LevelObject*> objects;
     objects.reserve(object_ids.size());
-    for (auto& id : object_ids)
+    for (auto id : object_ids)
     {
-        bool found = false;
-        for (auto& floor : floors_manager_.floors)
+        if (auto object = get_object(id))
         {
-            for (auto& object : floor.objects)
-            {
-                if (object.object_id == id)
-                {
-                    objects.push_back(&object);
-                    found = true;
-                    break;
-                }
-            }
-
-            if (found)
-            {
-                break;
-            }
+            objects.push_back(object);
         }
     }
     return objects;
@@ -405,6 +703,39 @@ LevelObject* EditorLevel::get_object(ObjectId object_id)
     return nullptr;
 }
 
+LevelObject* EditorLevel::get_object(const ObjectHandle& handle)
+{
+    if (handle.floor_index >= floors_manager_.floors.size())
+    {
+        return nullptr;
+    }
+    return floors_manager_.floors[handle.floor_index].objects.get(handle.slot);
+}
+
+std::optional<ObjectHandle> EditorLevel::get_object_handle(ObjectId object_id) const
+{
+    if (auto location = find_location(object_id))
+    {
+        return ObjectHandle{.floor_index = location->floor_index, .slot = location->object};
+    }
+    return std::nullopt;
+}
+
+std::vector<ObjectHandle>
+EditorLevel::get_object_handles(const std::vector<ObjectId>& object_ids) const
+{
+    std::vector<ObjectHandle> handles;
+    handles.reserve(object_ids.size());
+    for (auto id : object_ids)
+    {
+        if (auto handle = get_object_handle(id))
+        {
+            handles.push_back(*handle);
+        }
+    }
+    return handles;
+}
+
 std::optional<int> EditorLevel::get_object_floor(ObjectId object_id)
 {
     if (auto object = find_object_and_floor(object_id))
@@ -417,29 +748,17 @@ std::optional<int> EditorLevel::get_object_floor(ObjectId object_id)
 std::pair<std::vector<LevelObject>, std::vector<int>>
 EditorLevel::copy_objects_and_floors(const std::vector<ObjectId>& object_ids) const
 {
-    // Copy objects with the given ID - maybe there is better way than a triple nested loop?
     std::vector<LevelObject> objects;
     std::vector<int> floors;
-    for (auto& id : object_ids)
+    objects.reserve(object_ids.size());
+    floors.reserve(object_ids.size());
+    for (auto id : object_ids)
     {
-        bool found = false;
-        for (auto& floor : floors_manager_.floors)
+        if (auto location = find_location(id))
         {
-            for (auto& object : floor.objects)
-            {
-                if (object.object_id == id)
-                {
-                    objects.push_back(object);
-                    floors.push_back(floor.real_floor);
-                    found = true;
-                    break;
-                }
-            }
-
-            if (found)
-            {
-                break;
-            }
+            auto& floor = floors_manager_.floors[location->floor_index];
+            objects.push_back(*floor.objects.get(location->object));
+            floors.push_back(floor.real_floor);
         }
     }
 
@@ -470,92 +789,169 @@ void EditorLevel::clear_level()
 {
     reset_light_settings();
     current_id_ = 0;
+    object_locations_.clear();
+    picking_bvh_.clear();
     floors_manager_.clear();
+    geometry_cache_.clear();
 }
 
-bool EditorLevel::serialise(LevelFileIO& level_file_io)
+std::optional<FloorsSnapshot> EditorLevel::snapshot_floors() const
 {
-    if (do_serialise(level_file_io))
-    {
-        changes_made_since_last_save_ = false;
-        return true;
-    }
-    return false;
+    return floors_manager_.snapshot();
 }
 
 std::optional<std::pair<LevelObject*, int>> EditorLevel::find_object_and_floor(ObjectId object_id)
 {
-    for (auto& floor : floors_manager_.floors)
+    if (auto location = find_location(object_id))
     {
-        for (auto& object : floor.objects)
-        {
-            if (object.object_id == object_id)
-                return {{&object, floor.real_floor}};
-        }
+        auto& floor = floors_manager_.floors[location->floor_index];
+        return {{floor.objects.get(location->object), floor.real_floor}};
     }
-
     return std::nullopt;
 }
 
-bool EditorLevel::do_serialise(LevelFileIO& level_file_io) const
+const EditorLevel::ObjectLocation* EditorLevel::find_location(ObjectId object_id) const
 {
-    auto output = floors_manager_.serialise(level_file_io);
+    auto itr = object_locations_.find(object_id);
+    return itr != object_locations_.end() ? &itr->second : nullptr;
+}
 
-    if (output)
-    {
-        level_file_io.write_floors(output);
-        return true;
-    }
-    else
-    {
-        return false;
-    }
+bool EditorLevel::is_in_floor_range(ObjectId object_id, const FloorRange& floor_range) const
+{
+    auto p_location = find_location(object_id);
+    return p_location &&
+           floor_range.contains(floors_manager_.floors[p_location->floor_index].real_floor);
 }
 
-bool EditorLevel::deserialise(const LevelFileIO& level_file_io)
+bool EditorLevel::deserialise(LevelFileIO& level_file_io)
 {
     // Clear the current level
     clear_level();
 
-    // Iterate through the floors in the input json
-    for (auto& floor_object : level_file_io.get_floors())
+    // The objects are read first and added once their meshes have been generated
+    std::vector<LoadedObject> loaded_objects;
+    if (auto p_binary_floors = level_file_io.get_binary_floors())
     {
-        if (!floor_object.contains("floor") || !floor_object.contains("objects"))
+        if (!load_binary_floors(*p_binary_floors, loaded_objects))
         {
-            std::println(std::cerr, "Invalid floor object in level file");
             return false;
         }
+    }
+    else if (!load_json_floors(level_file_io, loaded_objects))
+    {
+        return false;
+    }
 
-        int floor_number = floor_object["floor"];
-        auto& floor = floors_manager_.ensure_floor_exists(floor_number);
+    // Generating the meshes is most of the time spent loading, and each object's meshes are
+    // independent of the others, so is spread across threads. Only uploading the meshes needs to
+    // happen on this thread as it requires the OpenGL context.
+    parallel_for(loaded_objects.size(),
+                 [&](size_t i)
+                 {
+                     // Shared geometry is generated when the first object using it is added
+                     auto& loaded = loaded_objects[i];
+                     if (!GeometryCache::make_key(loaded.object, loaded.floor_number))
+                     {
+                         loaded.object.to_geometry(loaded.floor_number, loaded.mesh);
+                     }
+                     std::tie(loaded.mesh_2d, loaded.primitive_2d) =
+                         loaded.object.to_2d_geometry(*p_drawing_pad_texture_map_);
+                 });
+
+    // Added in the same order as they were read, such that the IDs are assigned the same as when
+    // each object was added as soon as it was read
+    for (auto& loaded : loaded_objects)
+    {
+        auto& floor = **floors_manager_.find_floor(loaded.floor_number);
+        add_object_with_geometry(loaded.object, floor, std::move(loaded.mesh),
+                                 std::move(loaded.mesh_2d), loaded.primitive_2d);
+    }
 
-        // Load the objects for the current floor
-        auto object_types = floor_object["objects"];
+    saved_revision_ = revision_;
+    return true;
+}
 
-        load_objects(object_types, "platform", floor, [&](LevelObject& level_object, auto& json)
-                     { level_object.deserialise_as<PlatformObject>(json, level_file_io); });
+bool EditorLevel::load_json_floors(LevelFileIO& level_file_io,
+                                   std::vector<LoadedObject>& loaded_objects)
+{
+    auto on_floor = [&](int floor_number) { floors_manager_.ensure_floor_exists(floor_number); };
 
-        load_objects(object_types, "wall", floor, [&](LevelObject& level_object, auto& json)
-                     { level_object.deserialise_as<WallObject>(json, level_file_io); });
+    // The objects are appended to "loaded_objects" rather than added to the level, such that their
+    // meshes can be generated together
+    auto on_object = [&](int floor_number, const std::string& type, const nlohmann::json& json)
+    {
+        LevelObject level_object{0};
+        bool is_valid = false;
+        if (type == "platform")
+        {
+            is_valid = level_object.deserialise_as<PlatformObject>(json, level_file_io);
+        }
+        else if (type == "wall")
+        {
+            is_valid = level_object.deserialise_as<WallObject>(json, level_file_io);
+        }
+        else if (type == "polygon_platform")
+        {
+            is_valid = level_object.deserialise_as<PolygonPlatformObject>(json, level_file_io);
+        }
+        else if (type == "pillar")
+        {
+            is_valid = level_object.deserialise_as<PillarObject>(json, level_file_io);
+        }
+        else if (type == "ramp")
+        {
+            is_valid = level_object.deserialise_as<RampObject>(json, level_file_io);
+        }
 
-        load_objects(object_types, "polygon_platform", floor,
-                     [&](LevelObject& level_object, auto& json)
-                     { level_object.deserialise_as<PolygonPlatformObject>(json, level_file_io); });
+        if (is_valid)
+        {
+            loaded_objects.push_back({.object = level_object, .floor_number = floor_number});
+        }
+        else
+        {
+            std::println(std::cerr, "Skipping invalid {} object on floor {}", type, floor_number);
+        }
+        return true;
+    };
 
-        load_objects(object_types, "pillar", floor, [&](LevelObject& level_object, auto& json)
-                     { level_object.deserialise_as<PillarObject>(json, level_file_io); });
+    return level_file_io.read_json_floors(on_floor, on_object);
+}
 
-        load_objects(object_types, "ramp", floor, [&](LevelObject& level_object, auto& json)
-                     { level_object.deserialise_as<RampObject>(json, level_file_io); });
-    }
+bool EditorLevel::load_binary_floors(const LevelBinaryReader& reader,
+                                     std::vector<LoadedObject>& loaded_objects)
+{
+    for (size_t floor_index = 0; floor_index < reader.floor_count(); floor_index++)
+    {
+        int floor_number = reader.get_floor_number(floor_index);
+        floors_manager_.ensure_floor_exists(floor_number);
 
-    changes_made_since_last_save_ = false;
+        auto on_object = [&](const LevelObject& object)
+        { loaded_objects.push_back({.object = object, .floor_number = floor_number}); };
+        if (!reader.read_floor(floor_index, on_object))
+        {
+            std::println(std::cerr, "Invalid objects on floor {} in level file", floor_number);
+            return false;
+        }
+    }
     return true;
 }
 
+std::uint64_t EditorLevel::get_revision() const
+{
+    return revision_;
+}
+
+void EditorLevel::mark_saved(std::uint64_t revision)
+{
+    if (revision == revision_)
+    {
+        saved_revision_ = revision;
+    }
+}
+
 bool EditorLevel::changes_made_since_last_save() const
 {
-    return changes_made_since_last_save_;
+    return revision_ != saved_revision_;
 }
 
 int EditorLevel::last_placed_id() const
@@ -585,6 +981,56 @@ void EditorLevel::display_settings_gui()
     ImGui::End();
 }
 
+void EditorLevel::display_mesh_arena_gui()
+{
+    if (ImGui::Begin("Mesh Arena"))
+    {
+        auto display_arena = [](const char* name, const gl::BufferArena& arena)
+        {
+            ImGui::Text("%s: %u / %u (%zu blocks)", name, arena.used_count(), arena.capacity(),
+                        arena.block_count());
+        };
+        auto& arena = MeshArena<VertexLevelObjects>::get();
+        display_arena("Vertices", arena.get_vertex_arena());
+        display_arena("Indices (16 bit)", arena.get_index_arena(true));
+        display_arena("Indices (32 bit)", arena.get_index_arena(false));
+        ImGui::Text("Shared geometries: %zu", geometry_cache_.size());
+
+        if (ImGui::Button("Defragment"))
+        {
+            defragment_meshes();
+        }
+    }
+    ImGui::End();
+}
+
+void EditorLevel::display_render_stats_gui()
+{
+    if (ImGui::Begin("Render Stats"))
+    {
+        ImGui::Text("Objects Drawn: %d", render_stats_.drawn_objects);
+        ImGui::Text("Objects Culled: %d", render_stats_.culled_objects);
+        ImGui::Text("Floors Culled: %d", render_stats_.culled_floors);
+        ImGui::Text("Floors Outside Range: %d", render_stats_.hidden_floors);
+        ImGui::Text("Optimised Floors: %d (%d triangles removed)", render_stats_.optimised_floors,
+                    render_stats_.optimised_triangles_removed);
+    }
+    ImGui::End();
+}
+
+void EditorLevel::defragment_meshes()
+{
+    // Defragmenting moves the meshes, so the batches' draw commands are no longer valid
+    if (MeshArena<VertexLevelObjects>::get().defragment())
+    {
+        for (auto& floor : floors_manager_.floors)
+        {
+            floor.batch_needs_rebuild = true;
+        }
+    }
+    MeshArena<Vertex2DWorld>::get().defragment();
+}
+
 void EditorLevel::reset_light_settings()
 {
     main_light_ = MainLight{};
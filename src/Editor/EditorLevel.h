@@ -1,7 +1,9 @@
 #pragma once
 
 #include <functional>
+#include <limits>
 #include <memory>
+#include <unordered_map>
 
 #include <nlohmann/json.hpp>
 
@@ -9,11 +11,30 @@
 #include "../Graphics/OpenGL/Shader.h"
 #include "EditorState.h"
 #include "FloorManager.h"
+#include "GeometryCache.h"
 #include "LevelObjects/LevelObject.h"
+#include "PickingBVH.h"
 
 class LevelFileIO;
+class LevelBinaryReader;
 class LevelTextures;
 
+/// The floors to draw in the 3D view, such that tall levels do not pay for every floor while only
+/// a few are being edited
+struct FloorRange
+{
+    int min_floor = std::numeric_limits<int>::min();
+    int max_floor = std::numeric_limits<int>::max();
+
+    /// Floors outside of the range are drawn faded in a single cheap pass, rather than skipped
+    bool ghost_hidden_floors = false;
+
+    bool contains(int floor) const
+    {
+        return floor >= min_floor && floor <= max_floor;
+    }
+};
+
 /**
  * @brief The editor representation of a level.
  *
@@ -53,17 +74,33 @@ class EditorLevel
     /// Renders the level in 3D using the given shader and highlights the active object.
     /// Assumes the camera, shader, and other OpenGL states are set up correctly.
     /// The "selected_offset" can be used to offset the selected objects
-    void render(gl::Shader& scene_shader, const std::vector<ObjectId>& active_objects,
-                int current_floor, const glm::vec3& selected_offset);
+    /// Objects outside of the given frustum are not drawn. If no frustum is given, every object is
+    /// drawn.
+    /// When "optimise_geometry" is set, floors without selected objects are drawn using their
+    /// optimised mesh (See Floor::optimised_mesh).
+    void render(gl::Shader& scene_shader, const Selection& selection,
+                const FloorRange& floor_range, const glm::vec3& selected_offset,
+                const std::optional<Frustum>& frustum, bool optimise_geometry);
 
     /// Render the 2D view of the level using the given shader and highlight the active object.
     /// Assumes the camera, shader, and other OpenGL states are set up correctly.
-    void render_2d(gl::Shader& scene_shader, const std::vector<ObjectId>& active_objects,
-                   int current_floor, const glm::vec2& selected_offset);
+    void render_2d(gl::Shader& scene_shader, const Selection& selection, int current_floor,
+                   const glm::vec2& selected_offset);
+
+    // Render the scene to the picker texture, using the object ID as the single-colour channel.
+    // Only floors within the range are drawn, such that hidden floors cannot be picked.
+    void render_to_picker(gl::Shader& picker_shader, const FloorRange& floor_range);
+    void render_subset_to_picker(gl::Shader& picker_shader, const Selection& selection,
+                                 const FloorRange& floor_range);
+
+    /// Finds the closest object hit by the given ray, ignoring objects on floors outside of the
+    /// range. This gives the same result as rendering to the picker texture, without needing to
+    /// render or read back from the GPU.
+    std::optional<ObjectId> pick_object(const Ray& ray, const FloorRange& floor_range);
 
-    // Render the scene to the picker texture, using the object ID as the single-colour channel
-    void render_to_picker(gl::Shader& picker_shader) const;
-    void render_subset_to_picker(gl::Shader& picker_shader, const std::vector<ObjectId>& objects) const;
+    /// Same as pick_object, but only the selected objects can be hit (Like render_subset_to_picker)
+    std::optional<ObjectId> pick_object(const Ray& ray, const Selection& selection,
+                                        const FloorRange& floor_range);
 
     /// Try to select a level object at the given tile position. Returns nullptr if no object is
     /// found.
@@ -75,6 +112,13 @@ class EditorLevel
 
     std::vector<LevelObject*> get_objects(const std::vector<ObjectId>& object_ids);
     LevelObject* get_object(ObjectId object_id);
+
+    /// Returns nullptr if the object the handle refers to has since been removed
+    LevelObject* get_object(const ObjectHandle& handle);
+
+    /// Handles to objects are safe to hold on to across edits, unlike LevelObject pointers
+    std::optional<ObjectHandle> get_object_handle(ObjectId object_id) const;
+    std::vector<ObjectHandle> get_object_handles(const std::vector<ObjectId>& object_ids) const;
     std::optional<int> get_object_floor(ObjectId object_id);
 
     std::pair<std::vector<LevelObject>, std::vector<int>>
@@ -88,8 +132,16 @@ class EditorLevel
     /// @brief  Clears all floors and their objects, and resetting the level.
     void clear_level();
 
-    bool serialise(LevelFileIO& level_file_io);
-    bool deserialise(const LevelFileIO& level_file_io);
+    /// Copies the objects of every floor such that they can be saved on another thread (See
+    /// BackgroundLevelSaver). The level is only marked as saved once "mark_saved" is called.
+    std::optional<FloorsSnapshot> snapshot_floors() const;
+    bool deserialise(LevelFileIO& level_file_io);
+
+    /// Incremented with every change to the level's objects
+    std::uint64_t get_revision() const;
+
+    /// Marks the level as saved, unless it has been changed since the given revision was saved
+    void mark_saved(std::uint64_t revision);
 
     bool changes_made_since_last_save() const;
 
@@ -97,29 +149,101 @@ class EditorLevel
     int last_placed_id() const;
 
     void display_settings_gui();
+
+    /// Shows how much of the MeshArena is used, with the option to defragment it
+    void display_mesh_arena_gui();
+
+    /// Shows how many objects were drawn and culled by the last call to "render"
+    void display_render_stats_gui();
+
+    /// Compacts the MeshArena used by the level's meshes
+    void defragment_meshes();
+
     void reset_light_settings();
     const MainLight& get_light_settings() const;
 
   private:
-    std::optional<std::pair<LevelObject*, int>> find_object_and_floor(ObjectId object_id);
+    /// Counts from the last call to "render", shown in the debug GUI
+    struct RenderStats
+    {
+        int drawn_objects = 0;
+        int culled_objects = 0;
+        int culled_floors = 0;
 
-    bool do_serialise(LevelFileIO& level_file_io) const;
+        /// Floors outside of the FloorRange, including those drawn ghosted
+        int hidden_floors = 0;
 
-    /// Loads the level from the given JSON object, where "LoadFunc" should be a function
-    /// deserialises the given json to an object.
-    template <typename LoadFunc>
-    void load_objects(nlohmann::json& json, const char* object_key, Floor& floor, LoadFunc func)
+        /// Triangles removed from the floors drawn using their optimised mesh
+        int optimised_floors = 0;
+        int optimised_triangles_removed = 0;
+    };
+
+    /// Where an object and its meshes are stored within the floors
+    struct ObjectLocation
     {
-        if (json.find(object_key) != json.end())
-        {
-            for (auto& object : json[object_key])
-            {
-                LevelObject level_object{0};
-                func(level_object, object);
-                add_object(level_object, floor);
-            }
-        }
-    }
+        /// Index into FloorManager::floors
+        size_t floor_index = 0;
+
+        /// Handles into the floor's objects, meshes and meshes_2d
+        SlotMapHandle object;
+        SlotMapHandle mesh;
+        SlotMapHandle mesh_2d;
+
+        /// Set when the object's 3D geometry is shared via the GeometryCache
+        std::optional<GeometryCache::Key> shared_geometry;
+    };
+
+    /// An object read from the level file, waiting for its meshes to be generated before it is
+    /// added to the level
+    struct LoadedObject
+    {
+        LevelObject object;
+        int floor_number = 0;
+
+        LevelObjectsMesh3D mesh;
+        Mesh2DWorld mesh_2d;
+        gl::PrimitiveType primitive_2d = gl::PrimitiveType::Triangles;
+    };
+
+    /// Same as "add_object", but uses already generated meshes rather than generating them. The 3D
+    /// mesh is not used (so can be left empty) when the object's geometry can be shared.
+    LevelObject& add_object_with_geometry(const LevelObject& object, Floor& floor,
+                                          LevelObjectsMesh3D mesh, Mesh2DWorld mesh_2d,
+                                          gl::PrimitiveType primitive_2d);
+
+    std::optional<std::pair<LevelObject*, int>> find_object_and_floor(ObjectId object_id);
+
+    /// Returns nullptr if there is no object with the given ID
+    const ObjectLocation* find_location(ObjectId object_id) const;
+
+    /// Whether the object is on a floor within the range
+    bool is_in_floor_range(ObjectId object_id, const FloorRange& floor_range) const;
+
+    /// Rebuilds the batches of floors where objects have been added or removed since the last draw
+    void update_batches();
+
+    /// Rebuilds the floor's optimised mesh if any of its 3D meshes have changed since it was built
+    void update_optimised_mesh(Floor& floor);
+
+    /// Points the 3D mesh at the shared geometry for the given key, releasing the shared geometry
+    /// it used before
+    const GeometryCache::Entry&
+    use_shared_geometry(Floor::LevelMesh<LevelObjectsMesh3D>& level_mesh, ObjectLocation& location,
+                        const GeometryCache::Key& key);
+
+    /// Rebuilds the 2D draw list of the given floor if objects have been added or removed, or if
+    /// the selection has changed since it was last built
+    void update_draw_list_2d(Floor& floor, const Selection& selection);
+
+    /// Returns a flag for each floor (indexed the same as FloorManager::floors) set if any of the
+    /// given objects are on it
+    std::vector<bool> find_floors_with_objects(const std::vector<ObjectId>& object_ids) const;
+
+    /// Reads the objects of each floor of the JSON or binary level, creating the floors as they are
+    /// read. Returns false if the level is invalid.
+    bool load_json_floors(LevelFileIO& level_file_io, std::vector<LoadedObject>& loaded_objects);
+    bool load_binary_floors(const LevelBinaryReader& reader,
+                            std::vector<LoadedObject>& loaded_objects);
 
   private:
     FloorManager floors_manager_;
@@ -127,7 +251,27 @@ class EditorLevel
     /// Keeps track of the current object id, increments with each object added
     ObjectId current_id_ = 0;
 
-    bool changes_made_since_last_save_ = false;
+    /// Maps object IDs to where they are stored such that lookups do not need to search every
+    /// floor. This must be kept in sync whenever objects are added, removed or have their ID changed
+    std::unordered_map<ObjectId, ObjectLocation> object_locations_;
+
+    /// The 3D geometry of every object, used for picking objects using a ray cast. This must be
+    /// kept in sync with the 3D meshes
+    PickingBVH picking_bvh_;
+
+    /// Geometry shared between objects that only differ in position, and where each is drawn
+    GeometryCache geometry_cache_;
+
+    RenderStats render_stats_;
+
+    /// Version of the selection the floors' 2D draw lists were built with, such that they are only
+    /// rebuilt when it changes
+    std::optional<std::uint64_t> draw_list_2d_selection_version_;
+
+    /// There are changes since the last save when the revision differs from the saved revision.
+    /// Saves finish after the level may have been edited further, so a flag cannot be cleared.
+    std::uint64_t revision_ = 0;
+    std::uint64_t saved_revision_ = 0;
 
     const LevelTextures* p_drawing_pad_texture_map_ = nullptr;
 };
@@ -26,6 +26,37 @@ struct EditorSettings
 
     bool always_show_3d_gizmos = false;
 
+    /// Select objects in the 3D view using a ray cast on the CPU rather than the picker framebuffer
+    bool ray_cast_picking = true;
+
+    /// Skip drawing objects that are outside of the 3D camera's view
+    bool frustum_culling = true;
+
+    /// Only draw the floors near the current floor in the 3D view
+    bool limit_visible_floors = false;
+    int visible_floors_below = 2;
+    int visible_floors_above = 0;
+
+    /// Draw the floors outside of the visible range faded, rather than not at all
+    bool ghost_hidden_floors = true;
+
+    /// Draw floors without selected objects with their hidden faces removed and coplanar faces
+    /// merged
+    bool optimise_floor_geometry = false;
+
+    /// How many frames the result of the 3D mouse-over picker can lag behind the mouse. Once a
+    /// result is this many frames old the CPU waits for the GPU to finish it, so higher values
+    /// stall less often. 0 waits for the result on the same frame
+    int max_pick_latency_frames = 2;
+
+    /// Save levels in the memory mapped binary format rather than JSON, which is quicker to save
+    /// and load. Off by default as binary levels can only be opened by builds with the same
+    /// LEVEL_BINARY_VERSION, so should be exported to JSON from the file menu to keep them.
+    bool save_levels_as_binary = false;
+
+    /// The zlib compression level (1-9) used when saving levels as JSON
+    int level_compression_level = 6;
+
     void save() const
     {
         nlohmann::json output = {
@@ -43,6 +74,16 @@ struct EditorSettings
             {"render_main_light", render_main_light},
             {"show_level_settings", show_level_settings},
             {"always_show_3d_gizmos", always_show_3d_gizmos},
+            {"ray_cast_picking", ray_cast_picking},
+            {"frustum_culling", frustum_culling},
+            {"limit_visible_floors", limit_visible_floors},
+            {"visible_floors_below", visible_floors_below},
+            {"visible_floors_above", visible_floors_above},
+            {"ghost_hidden_floors", ghost_hidden_floors},
+            {"optimise_floor_geometry", optimise_floor_geometry},
+            {"max_pick_latency_frames", max_pick_latency_frames},
+            {"save_levels_as_binary", save_levels_as_binary},
+            {"level_compression_level", level_compression_level},
         };
 
         std::ofstream settings_file("settings.json");
@@ -71,6 +112,16 @@ struct EditorSettings
             render_main_light               = input.value("render_main_light", render_main_light);
             show_level_settings             = input.value("show_level_settings", show_level_settings);
             always_show_3d_gizmos             = input.value("show_level_settings", always_show_3d_gizmos);
+            ray_cast_picking                = input.value("ray_cast_picking", ray_cast_picking);
+            frustum_culling                 = input.value("frustum_culling", frustum_culling);
+            limit_visible_floors            = input.value("limit_visible_floors", limit_visible_floors);
+            visible_floors_below            = input.value("visible_floors_below", visible_floors_below);
+            visible_floors_above            = input.value("visible_floors_above", visible_floors_above);
+            ghost_hidden_floors             = input.value("ghost_hidden_floors", ghost_hidden_floors);
+            optimise_floor_geometry         = input.value("optimise_floor_geometry", optimise_floor_geometry);
+            max_pick_latency_frames         = input.value("max_pick_latency_frames", max_pick_latency_frames);
+            save_levels_as_binary           = input.value("save_levels_as_binary", save_levels_as_binary);
+            level_compression_level         = input.value("level_compression_level", level_compression_level);
             // clang-format on
         }
     }
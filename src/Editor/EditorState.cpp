@@ -1,73 +1,118 @@
 #include "EditorState.h"
 
+#include <utility>
+
 #include "LevelObjects/LevelObject.h"
 
-namespace
+Selection::BatchUpdate::BatchUpdate(Selection& selection)
+    : selection_(selection)
 {
-    template <typename T>
-    bool exists(T object, std::vector<T> array)
+    selection_.batch_depth_++;
+}
+
+Selection::BatchUpdate::~BatchUpdate()
+{
+    if (--selection_.batch_depth_ == 0 && selection_.notification_pending_)
     {
-        for (auto item : array)
-        {
-            if (item == object)
-            {
-                return true;
-            }
-        }
-        return false;
+        selection_.notification_pending_ = false;
+        selection_.notify_callbacks(std::exchange(selection_.p_pending_object_, nullptr));
     }
-} // namespace
+}
 
 void Selection::set_selection(LevelObject* object)
 {
-    p_active_object = object;
-
-    objects.clear();
-    if (object && !exists(object->object_id, objects))
+    clear_objects();
+    active_object = object ? std::optional{object->object_id} : std::nullopt;
+    if (object)
     {
-        objects.push_back(object->object_id);
+        add_object(object->object_id);
     }
     notify_callbacks(object);
 }
 
 void Selection::add_to_selection(LevelObject* object)
 {
-    p_active_object = objects.empty() ? object : nullptr;
-
-    if (object && !exists(object->object_id, objects))
+    active_object = objects_.empty() && object ? std::optional{object->object_id} : std::nullopt;
+    if (object)
     {
-        objects.push_back(object->object_id);
+        add_object(object->object_id);
     }
     notify_callbacks(object);
 }
 
 void Selection::add_to_selection(ObjectId id)
 {
-    if (!exists(id, objects))
-    {
-        objects.push_back(id);
-    }
+    add_object(id);
 }
 
 void Selection::clear_selection()
 {
-    objects.clear();
-    p_active_object = nullptr;
+    clear_objects();
+    active_object = std::nullopt;
     notify_callbacks(nullptr);
 }
 
 bool Selection::single_object_is_selected() const
 {
-    return p_active_object && objects.size() == 1;
+    return active_object && objects_.size() == 1;
 }
 
 bool Selection::has_selection() const
 {
-    return p_active_object || !objects.empty();
+    return active_object || !objects_.empty();
+}
+
+bool Selection::contains(ObjectId id) const
+{
+    return id >= 0 && static_cast<size_t>(id) < selected_bits_.size() && selected_bits_[id];
+}
+
+const std::vector<ObjectId>& Selection::get_objects() const
+{
+    return objects_;
+}
+
+std::uint64_t Selection::get_version() const
+{
+    return version_;
+}
+
+void Selection::add_object(ObjectId id)
+{
+    if (contains(id) || id < 0)
+    {
+        return;
+    }
+
+    if (static_cast<size_t>(id) >= selected_bits_.size())
+    {
+        selected_bits_.resize(static_cast<size_t>(id) + 1, false);
+    }
+    selected_bits_[id] = true;
+    objects_.push_back(id);
+    version_++;
+}
+
+void Selection::clear_objects()
+{
+    // Only the bits of selected objects are reset, rather than every bit
+    for (auto id : objects_)
+    {
+        selected_bits_[id] = false;
+    }
+    objects_.clear();
+    version_++;
 }
 
 void Selection::notify_callbacks(LevelObject* object)
 {
+    if (batch_depth_ > 0)
+    {
+        notification_pending_ = true;
+        p_pending_object_ = object;
+        return;
+    }
+
     for (auto& callback : on_selection_changed)
     {
         callback(object, !single_object_is_selected());
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
+#include <optional>
 #include <unordered_set>
 
 #include <SFML/Window/Mouse.hpp>
@@ -11,19 +14,37 @@
 struct LevelObject;
 
 /// Stores the currently selected objects in the editor, along with their floors.
+///
+/// The objects are stored both as a list in the order they were selected, and as a bit per object
+/// ID such that checking if an object is selected does not need to search the list.
 struct Selection
 {
     /// Callback for handling objects being created, where the second arg is True if there are
     /// multiple selections
     using SelectionAddedToCallback = std::move_only_function<void(LevelObject*, bool)>;
 
-    std::vector<SelectionAddedToCallback> on_selection_changed;
+    /// Defers the on_selection_changed callbacks until it goes out of scope, such that changing
+    /// the selection many times (eg selecting thousands of objects) only notifies once. The
+    /// callbacks are given the object from the last change, which must still exist at that point.
+    class BatchUpdate
+    {
+      public:
+        BatchUpdate(Selection& selection);
+        ~BatchUpdate();
 
-    /// List of object IDs that are currently selected.
-    std::vector<ObjectId> objects;
+        BatchUpdate(const BatchUpdate&) = delete;
+        BatchUpdate& operator=(const BatchUpdate&) = delete;
+
+      private:
+        Selection& selection_;
+    };
 
-    /// Pointer to the FIRST object in the selection. Convenience for GUI display, and fast access.
-    LevelObject* p_active_object = nullptr;
+    std::vector<SelectionAddedToCallback> on_selection_changed;
+
+    /// ID of the FIRST object in the selection. Convenience for GUI display, and fast access via
+    /// EditorLevel::get_object. Stored as an ID rather than a pointer as pointers are invalidated
+    /// when objects are added or removed from the level.
+    std::optional<ObjectId> active_object;
 
     /// Clear the selection, setting it to the given object.
     void set_selection(LevelObject* object);
@@ -40,8 +61,37 @@ struct Selection
     bool single_object_is_selected() const;
     bool has_selection() const;
 
+    /// Returns true if the given object is selected, without searching the list of objects
+    bool contains(ObjectId id) const;
+
+    /// The selected object IDs, in the order they were selected
+    const std::vector<ObjectId>& get_objects() const;
+
+    /// Incremented whenever the selection changes, such that anything built from the selection
+    /// can check if it is out of date
+    std::uint64_t get_version() const;
+
   private:
+    /// Adds to the list and bits, without notifying
+    void add_object(ObjectId id);
+
+    /// Clears the list and bits, without notifying
+    void clear_objects();
+
     void notify_callbacks(LevelObject* object);
+
+    /// List of object IDs that are currently selected.
+    std::vector<ObjectId> objects_;
+
+    /// Indexed by ObjectId, set if the object is selected. Grows to fit the largest selected ID.
+    std::vector<bool> selected_bits_;
+
+    std::uint64_t version_ = 0;
+
+    /// Callbacks are deferred while this is above 0 (See BatchUpdate)
+    int batch_depth_ = 0;
+    bool notification_pending_ = false;
+    LevelObject* p_pending_object_ = nullptr;
 };
 
 /// State about mouse picking
@@ -1,5 +1,29 @@
 #include "FloorManager.h"
 
+#include <algorithm>
+#include <array>
+
+#include "LevelBinaryFormat.h"
+
+namespace
+{
+    /// Objects are loaded grouped by their type, in the order of the type names as the JSON sorts
+    /// its object types by name (See LevelBinaryReader::read_floor)
+    int get_load_order(const LevelObject& object)
+    {
+        // Indexed by the index of the object's type within the LevelObject::object_type variant
+        constexpr std::array LOAD_ORDER = {
+            4, // Wall
+            1, // Platform
+            2, // PolygonPlatform
+            0, // Pillar
+            3, // Ramp
+        };
+        static_assert(LOAD_ORDER.size() == std::variant_size_v<decltype(LevelObject::object_type)>);
+        return LOAD_ORDER[object.object_type.index()];
+    }
+} // namespace
+
 Floor& FloorManager::ensure_floor_exists(int floor_number)
 {
     if (floors.empty())
@@ -60,9 +84,10 @@ void FloorManager::clear()
     max_floor = 0;
 }
 
-std::optional<nlohmann::json> FloorManager::serialise(LevelFileIO& level_file_io) const
+std::optional<FloorsSnapshot> FloorManager::snapshot() const
 {
-    nlohmann::json output;
+    FloorsSnapshot snapshot;
+    snapshot.floors.reserve(floors.size());
 
     // Floors are saved from bottom to top
     for (int floor_number = min_floor; floor_number < max_floor + 1; floor_number++)
@@ -71,16 +96,45 @@ std::optional<nlohmann::json> FloorManager::serialise(LevelFileIO& level_file_io
         if (!floor_opt)
         {
             std::println(std::cerr, "Could not save floor {} as it does not exist", floor_number);
-            return false;
+            return {};
         }
-        auto& floor = **floor_opt;
 
+        auto& floor = snapshot.floors.emplace_back(floor_number);
+        floor.objects.assign((*floor_opt)->objects.begin(), (*floor_opt)->objects.end());
+        std::ranges::stable_sort(floor.objects, {}, get_load_order);
+    }
+    return snapshot;
+}
+
+std::optional<nlohmann::json> FloorManager::serialise(LevelFileIO& level_file_io) const
+{
+    if (auto floors_snapshot = snapshot())
+    {
+        return floors_snapshot->serialise(level_file_io);
+    }
+    return {};
+}
+
+std::optional<std::string> FloorManager::serialise_binary(std::uint64_t save_id) const
+{
+    if (auto floors_snapshot = snapshot())
+    {
+        return floors_snapshot->serialise_binary(save_id);
+    }
+    return {};
+}
+
+nlohmann::json FloorsSnapshot::serialise(LevelFileIO& level_file_io) const
+{
+    nlohmann::json output;
+    for (auto& floor : floors)
+    {
         // Objects are grouped together by their type to optimize the json
         std::unordered_map<std::string, nlohmann::json> object_map;
 
         // Create a json object for the current floor
         nlohmann::json current_floor;
-        current_floor["floor"] = floor_number;
+        current_floor["floor"] = floor.floor_number;
         current_floor["objects"] = {};
 
         // Iterate through all objects on the floor and group them by type
@@ -101,3 +155,18 @@ std::optional<nlohmann::json> FloorManager::serialise(LevelFileIO& level_file_io
 
     return output;
 }
+
+std::string FloorsSnapshot::serialise_binary(std::uint64_t save_id) const
+{
+    LevelBinaryWriter writer;
+    for (auto& floor : floors)
+    {
+        writer.begin_floor(floor.floor_number);
+        for (auto& object : floor.objects)
+        {
+            writer.add_object(object);
+        }
+    }
+
+    return writer.finish(save_id);
+}
\ No newline at end of file
@@ -3,8 +3,12 @@
 #include <optional>
 #include <vector>
 
+#include "../Graphics/GeometryOptimiser.h"
 #include "../Graphics/Mesh.h"
+#include "../Graphics/MeshBatch.h"
+#include "../Util/SlotMap.h"
 #include "LevelObjects/LevelObject.h"
+#include "SpatialGrid.h"
 
 class LevelFileIO;
 
@@ -18,10 +22,24 @@ struct Floor
         /// modified.
         ObjectId id;
 
-        /// The mesh for the level object.
+        /// The mesh for the level object. Left empty when the geometry is shared.
         MeshType mesh;
 
+        /// Set when the object shares its geometry with other objects with the same properties
+        /// (See GeometryCache), in which case it is drawn offset by the object's position
+        const MeshType* p_shared_mesh = nullptr;
+
         gl::PrimitiveType primitive = gl::PrimitiveType::Triangles;
+
+        /// Bounds of the mesh's vertices, used to skip drawing 3D meshes outside of the camera's
+        /// view. Not set for 2D meshes.
+        BoundingBox bounds;
+
+        /// The mesh to draw, either the object's own mesh or its shared mesh
+        const MeshType& geometry() const
+        {
+            return p_shared_mesh ? *p_shared_mesh : mesh;
+        }
     };
 
     Floor(int floor)
@@ -29,12 +47,86 @@ struct Floor
     {
     }
 
-    std::vector<LevelObject> objects;
-    std::vector<LevelMesh<LevelObjectsMesh3D>> meshes;
-    std::vector<LevelMesh<Mesh2DWorld>> meshes_2d;
+    SlotMap<LevelObject> objects;
+    SlotMap<LevelMesh<LevelObjectsMesh3D>> meshes;
+    SlotMap<LevelMesh<Mesh2DWorld>> meshes_2d;
+
+    /// The 3D meshes packed together such that the floor can be drawn with a single draw call. The
+    /// meshes above only keep the CPU-side geometry, which the batch is rebuilt from.
+    MeshBatch<VertexLevelObjects> batch;
+
+    /// Set when 3D meshes are added, removed or change size, such that the batch is rebuilt before
+    /// the next draw
+    bool batch_needs_rebuild = false;
+
+    /// Bounds of every 3D mesh on the floor, such that floors outside of the camera's view can be
+    /// skipped without testing each mesh. Recalculated when the batch is rebuilt, and expanded
+    /// when a mesh is updated in between.
+    BoundingBox bounds;
+
+    /// Every 3D mesh on the floor combined with hidden faces removed and coplanar faces merged (See
+    /// GeometryOptimiser). This has no per-object draw commands, so is only drawn when the floor
+    /// has no selected objects, and is only built when geometry optimisation is enabled.
+    LevelObjectsMesh3D optimised_mesh;
+    GeometryOptimiserStats optimisation_stats;
+
+    /// Set when any 3D mesh on the floor is added, removed or changed
+    bool optimised_mesh_needs_rebuild = true;
+
+    /// The 2D meshes sorted into the groups drawn by EditorLevel::render_2d, such that they are not
+    /// re-sorted every frame. Meshes without geometry are left out.
+    struct DrawList2D
+    {
+        std::vector<const LevelMesh<Mesh2DWorld>*> shapes;
+        std::vector<const LevelMesh<Mesh2DWorld>*> walls;
+        std::vector<const LevelMesh<Mesh2DWorld>*> active_shapes;
+        std::vector<const LevelMesh<Mesh2DWorld>*> active_walls;
+    } draw_list_2d;
+
+    /// Set when 2D meshes are added or removed, or the selection changes, such that the draw list
+    /// is rebuilt before the next draw. The draw list points into meshes_2d, so must be rebuilt
+    /// whenever the slot map's values move.
+    bool draw_list_2d_needs_rebuild = true;
+
+    /// Used to find objects at a given point or area in the 2D view without checking every object
+    SpatialGrid spatial_grid;
+
     int real_floor = 0;
 };
 
+/// Handle to an object in the level. Unlike a LevelObject pointer, this is safe to hold across edits
+/// as looking it up via EditorLevel::get_object returns nullptr once the object has been removed.
+struct ObjectHandle
+{
+    /// Index into FloorManager::floors
+    size_t floor_index = 0;
+    SlotMapHandle slot;
+
+    bool operator==(const ObjectHandle& other) const = default;
+};
+
+/// A copy of the objects on every floor, from the bottom floor to the top. Unlike the floors this
+/// holds no meshes, so is cheap to take and can be serialised on another thread while the level
+/// continues to be edited.
+///
+/// The objects are in the order they are loaded when the level is next opened, such that the ID
+/// each object is given when loaded is its index within the snapshot (See EditJournal).
+struct FloorsSnapshot
+{
+    struct FloorObjects
+    {
+        int floor_number = 0;
+        std::vector<LevelObject> objects;
+    };
+    std::vector<FloorObjects> floors;
+
+    /// Serialise all of the floors into a JSON object.
+    nlohmann::json serialise(LevelFileIO& level_file_io) const;
+
+    /// Serialise all of the floors into the binary level format (See LevelBinaryWriter).
+    std::string serialise_binary(std::uint64_t save_id) const;
+};
+
 /// Wrapper for managing multiple floors in a level.
 struct FloorManager
 {
@@ -53,8 +145,15 @@ struct FloorManager
     /// @brief Clears all floors and resets the manager.
     void clear();
 
+    /// Copies the objects of every floor. Returns nothing if any floor between the min and max
+    /// floor does not exist.
+    std::optional<FloorsSnapshot> snapshot() const;
+
     /// Serialise all of the floors into a JSON object.
     std::optional<nlohmann::json> serialise(LevelFileIO& level_file_io) const;
+
+    /// Serialise all of the floors into the binary level format (See LevelBinaryWriter).
+    std::optional<std::string> serialise_binary(std::uint64_t save_id) const;
 };
 
 /**
@@ -0,0 +1,231 @@
+#include "GeometryCache.h"
+
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+namespace
+{
+    template <typename T>
+    void hash_combine(std::size_t& seed, const T& value)
+    {
+        seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+    void hash_combine(std::size_t& seed, const TextureProp& texture)
+    {
+        hash_combine(seed, texture.id);
+        hash_combine(seed, texture.colour.r);
+        hash_combine(seed, texture.colour.g);
+        hash_combine(seed, texture.colour.b);
+        hash_combine(seed, texture.colour.a);
+    }
+
+    void hash_combine(std::size_t& seed, const glm::vec2& vector)
+    {
+        hash_combine(seed, vector.x);
+        hash_combine(seed, vector.y);
+    }
+
+    std::size_t hash_properties(const PillarProps& props)
+    {
+        std::size_t seed = 0;
+        hash_combine(seed, props.texture);
+        hash_combine(seed, props.style);
+        hash_combine(seed, props.size);
+        hash_combine(seed, props.base_height);
+        hash_combine(seed, props.height);
+        hash_combine(seed, props.angled);
+        return seed;
+    }
+
+    std::size_t hash_properties(const PlatformProps& props)
+    {
+        std::size_t seed = 0;
+        hash_combine(seed, props.texture_top);
+        hash_combine(seed, props.texture_bottom);
+        hash_combine(seed, props.size);
+        hash_combine(seed, props.base);
+        hash_combine(seed, props.style);
+        hash_combine(seed, props.direction);
+        return seed;
+    }
+
+    std::size_t hash_properties(const RampProps& props)
+    {
+        std::size_t seed = 0;
+        hash_combine(seed, props.texture_top);
+        hash_combine(seed, props.texture_bottom);
+        hash_combine(seed, props.size);
+        hash_combine(seed, props.start_height);
+        hash_combine(seed, props.end_height);
+        hash_combine(seed, props.direction);
+        hash_combine(seed, props.style);
+        return seed;
+    }
+
+    template <typename T>
+    constexpr bool has_shareable_geometry =
+        std::is_same_v<T, PillarObject> || std::is_same_v<T, PlatformObject> ||
+        std::is_same_v<T, RampObject>;
+} // namespace
+
+bool GeometryCache::Key::operator==(const Key& other) const
+{
+    if (floor_number != other.floor_number || object.index() != other.object.index())
+    {
+        return false;
+    }
+    return std::visit(
+        [&](const auto& lhs)
+        {
+            using T = std::decay_t<decltype(lhs)>;
+            return lhs.properties == std::get<T>(other.object).properties;
+        },
+        object);
+}
+
+std::size_t GeometryCache::KeyHash::operator()(const Key& key) const
+{
+    auto seed = std::visit([](const auto& object) { return hash_properties(object.properties); },
+                           key.object);
+    hash_combine(seed, key.object.index());
+    hash_combine(seed, key.floor_number);
+    return seed;
+}
+
+std::optional<GeometryCache::Key> GeometryCache::make_key(const LevelObject& level_object,
+                                                          int floor_number)
+{
+    return std::visit(
+        [&](const auto& object) -> std::optional<Key>
+        {
+            using T = std::decay_t<decltype(object)>;
+            if constexpr (has_shareable_geometry<T>)
+            {
+                return Key{.object = T{.properties = object.properties},
+                           .floor_number = floor_number};
+            }
+            return std::nullopt;
+        },
+        level_object.object_type);
+}
+
+glm::vec3 GeometryCache::get_offset(const LevelObject& level_object)
+{
+    return std::visit(
+        [&](const auto& object)
+        {
+            using T = std::decay_t<decltype(object)>;
+            if constexpr (has_shareable_geometry<T>)
+            {
+                auto& position = object.parameters.position;
+                return glm::vec3{position.x, 0, position.y} / TILE_SIZE_F;
+            }
+            return glm::vec3{0};
+        },
+        level_object.object_type);
+}
+
+const GeometryCache::Entry& GeometryCache::acquire(const Key& key)
+{
+    auto [itr, inserted] = entries_.try_emplace(key);
+    auto& entry = itr->second;
+    if (inserted)
+    {
+        std::visit([&](const auto& object)
+                   { object_to_geometry(object, key.floor_number, entry.mesh); },
+                   key.object);
+        entry.mesh.update();
+        entry.bounds = entry.mesh.calculate_bounds();
+    }
+    entry.references++;
+    return entry;
+}
+
+void GeometryCache::release(const Key& key)
+{
+    auto itr = entries_.find(key);
+    if (itr != entries_.end() && --itr->second.references <= 0)
+    {
+        entries_.erase(itr);
+    }
+}
+
+void GeometryCache::set_offset(ObjectId id, const glm::vec3& offset)
+{
+    auto index = static_cast<size_t>(id);
+    if (index >= offsets_.size())
+    {
+        offsets_.resize(index + 1, glm::vec4{0});
+    }
+
+    offsets_[index] = {offset, 0};
+    if (dirty_begin_ == dirty_end_)
+    {
+        dirty_begin_ = index;
+        dirty_end_ = index + 1;
+    }
+    else
+    {
+        dirty_begin_ = std::min(dirty_begin_, index);
+        dirty_end_ = std::max(dirty_end_, index + 1);
+    }
+}
+
+glm::vec3 GeometryCache::get_object_offset(ObjectId id) const
+{
+    auto index = static_cast<size_t>(id);
+    return index < offsets_.size() ? glm::vec3{offsets_[index]} : glm::vec3{0};
+}
+
+void GeometryCache::set_object_id(ObjectId current_id, ObjectId new_id)
+{
+    auto index = static_cast<size_t>(current_id);
+    if (index < offsets_.size())
+    {
+        auto offset = glm::vec3{offsets_[index]};
+        set_offset(current_id, glm::vec3{0});
+        set_offset(new_id, offset);
+    }
+}
+
+void GeometryCache::bind_offsets()
+{
+    // The buffer is recreated with room to grow, as storage created by glNamedBufferStorage
+    // cannot be resized
+    if (offsets_.size() > offsets_capacity_ || offsets_capacity_ == 0)
+    {
+        offsets_capacity_ = std::max<size_t>(offsets_.size() * 2, 256);
+        std::vector<glm::vec4> data(offsets_capacity_, glm::vec4{0});
+        std::ranges::copy(offsets_, data.begin());
+
+        offsets_buffer_.reset();
+        offsets_buffer_.buffer_data(data);
+        dirty_begin_ = dirty_end_ = 0;
+    }
+    else if (dirty_begin_ != dirty_end_)
+    {
+        glNamedBufferSubData(offsets_buffer_.id, sizeof(glm::vec4) * dirty_begin_,
+                             sizeof(glm::vec4) * (dirty_end_ - dirty_begin_),
+                             offsets_.data() + dirty_begin_);
+        dirty_begin_ = dirty_end_ = 0;
+    }
+
+    offsets_buffer_.bind_buffer_base(gl::BindBufferTarget::ShaderStorageBuffer, OFFSETS_BINDING);
+}
+
+void GeometryCache::clear()
+{
+    entries_.clear();
+    offsets_.clear();
+    dirty_begin_ = dirty_end_ = 0;
+
+    // Forces the buffer to be recreated, such that offsets of the previous level are not kept
+    offsets_capacity_ = 0;
+}
+
+size_t GeometryCache::size() const
+{
+    return entries_.size();
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <optional>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "../Graphics/Mesh.h"
+#include "../Graphics/OpenGL/BufferObject.h"
+#include "EditConstants.h"
+#include "LevelObjects/LevelObject.h"
+
+/**
+ * @brief Shares the 3D geometry of objects whose geometry only depends on their properties and
+ * floor, such that objects that only differ in position (eg copy-pasted or grid-filled pillars,
+ * platforms and ramps) are generated and stored in the MeshArena once.
+ *
+ * The shared geometry is generated at the origin, and each object using it is drawn offset by its
+ * position. The offsets are stored in a shader storage buffer indexed by object ID, which shaders
+ * index using gl_BaseInstance as MeshBatch passes the object ID as the base instance. Objects with
+ * their own geometry have an offset of 0.
+ *
+ * Entries are reference counted, and freed once the last object using them is removed.
+ */
+class GeometryCache
+{
+  public:
+    /// The shader storage buffer binding the offsets are bound to
+    static constexpr GLuint OFFSETS_BINDING = 1;
+
+    /// Identifies shared geometry. The object's parameters (ie position) are left as default.
+    struct Key
+    {
+        std::variant<PillarObject, PlatformObject, RampObject> object;
+        int floor_number = 0;
+
+        bool operator==(const Key& other) const;
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    struct Entry
+    {
+        /// The geometry of the object at the origin, buffered once for every object using it
+        LevelObjectsMesh3D mesh;
+        BoundingBox bounds;
+        int references = 0;
+    };
+
+    /// Returns nullopt if the object's geometry depends on more than its properties and floor, so
+    /// cannot be shared. This is the case for walls and polygon platforms, which are defined by
+    /// their points and have their textures mapped in world space.
+    [[nodiscard]] static std::optional<Key> make_key(const LevelObject& object, int floor_number);
+
+    /// The offset the shared geometry must be drawn at for the given object
+    [[nodiscard]] static glm::vec3 get_offset(const LevelObject& object);
+
+    /// Gets the shared geometry, generating and buffering it if no other object is using it. Each
+    /// call must be matched by a call to "release" once the object no longer uses the geometry.
+    const Entry& acquire(const Key& key);
+    void release(const Key& key);
+
+    /// Sets the offset the given object's geometry is drawn at
+    void set_offset(ObjectId id, const glm::vec3& offset);
+
+    /// The offset the given object's geometry is drawn at, which is 0 when it is not shared
+    [[nodiscard]] glm::vec3 get_object_offset(ObjectId id) const;
+
+    /// Moves the offset of the object from one ID to another (eg when undoing a removal)
+    void set_object_id(ObjectId current_id, ObjectId new_id);
+
+    /// Uploads the offsets changed since the last call, and binds them to OFFSETS_BINDING
+    void bind_offsets();
+
+    void clear();
+
+    [[nodiscard]] size_t size() const;
+
+  private:
+    std::unordered_map<Key, Entry, KeyHash> entries_;
+
+    /// The offset of each object, indexed by object ID
+    std::vector<glm::vec4> offsets_;
+    gl::BufferObject offsets_buffer_;
+
+    /// The number of offsets the buffer was created with, recreated when there are more objects
+    size_t offsets_capacity_ = 0;
+
+    /// Range of offsets changed since they were last uploaded
+    size_t dirty_begin_ = 0;
+    size_t dirty_end_ = 0;
+};
\ No newline at end of file
@@ -539,7 +539,7 @@ void load_objects(const nlohmann::json& json, const char* json_key, FloorManager
     for (auto& object : objects)
     {
         auto& floor = new_level.ensure_floor_exists(object.floor);
-        floor.objects.push_back(LevelObject{object.object});
+        floor.objects.insert(LevelObject{object.object});
     }
 }
 
@@ -581,7 +581,7 @@ void load_floors(const nlohmann::json& json, FloorManager& new_level)
     for (auto& legacy_floor : legacy_floors)
     {
         auto& floor = new_level.ensure_floor_exists(floor_n++);
-        floor.objects.push_back(LevelObject{legacy_floor});
+        floor.objects.insert(LevelObject{legacy_floor});
     }
 }
 
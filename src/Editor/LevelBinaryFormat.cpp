@@ -0,0 +1,738 @@
+#include "LevelBinaryFormat.h"
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <print>
+
+namespace
+{
+    static_assert(std::endian::native == std::endian::little,
+                  "The binary level format is read and written as little endian");
+
+    constexpr std::array<char, 4> MAGIC = {'C', 'L', 'Y', 'B'};
+
+    /// The object sections of each floor, in the order they are written. They are read in the
+    /// order of their type names instead (See LevelBinaryReader::read_floor).
+    constexpr std::size_t SECTION_COUNT = 5;
+
+    struct Header
+    {
+        std::array<char, 4> magic = MAGIC;
+        std::uint32_t version = LEVEL_BINARY_VERSION;
+        std::uint32_t floor_count = 0;
+        std::uint32_t colour_count = 0;
+        std::uint32_t ring_count = 0;
+        std::uint32_t point_count = 0;
+        std::uint64_t colours_offset = 0;
+        std::uint64_t floors_offset = 0;
+        std::uint64_t rings_offset = 0;
+        std::uint64_t points_offset = 0;
+        std::uint64_t save_id = 0;
+    };
+
+    struct SectionEntry
+    {
+        std::uint64_t offset = 0;
+        std::uint32_t count = 0;
+        std::uint32_t record_size = 0;
+    };
+
+    struct FloorEntry
+    {
+        std::int32_t floor_number = 0;
+        std::uint32_t padding = 0;
+        std::array<SectionEntry, SECTION_COUNT> sections;
+    };
+
+    // =======================================
+    //      Object Records
+    // =======================================
+    struct TextureRecord
+    {
+        std::int32_t id = 0;
+        std::uint32_t colour_index = 0;
+    };
+
+    struct PlatformRecord
+    {
+        constexpr static std::size_t SECTION = 0;
+
+        glm::vec2 position;
+        TextureRecord texture_top;
+        TextureRecord texture_bottom;
+        glm::vec2 size;
+        float base;
+        std::uint32_t style;
+        std::uint32_t direction;
+    };
+
+    struct WallRecord
+    {
+        constexpr static std::size_t SECTION = 1;
+
+        glm::vec2 start;
+        glm::vec2 end;
+        TextureRecord texture_front;
+        TextureRecord texture_back;
+        float start_base_height;
+        float start_height;
+        float end_base_height;
+        float end_height;
+        std::uint32_t style;
+    };
+
+    struct PolygonPlatformRecord
+    {
+        constexpr static std::size_t SECTION = 2;
+
+        glm::vec2 position;
+        TextureRecord texture_top;
+        TextureRecord texture_bottom;
+        float base;
+        std::uint32_t visible;
+        std::uint32_t first_ring;
+        std::uint32_t ring_count;
+    };
+
+    struct PillarRecord
+    {
+        constexpr static std::size_t SECTION = 3;
+
+        glm::vec2 position;
+        TextureRecord texture;
+        std::uint32_t style;
+        float size;
+        float base_height;
+        float height;
+        std::uint32_t angled;
+    };
+
+    struct RampRecord
+    {
+        constexpr static std::size_t SECTION = 4;
+
+        glm::vec2 position;
+        TextureRecord texture_top;
+        TextureRecord texture_bottom;
+        glm::vec2 size;
+        float start_height;
+        float end_height;
+        std::uint32_t direction;
+        std::uint32_t style;
+    };
+
+    // The sizes are part of the format, so changing any of these requires a new version
+    static_assert(sizeof(Header) == 64);
+    static_assert(sizeof(FloorEntry) == 88);
+    static_assert(sizeof(PlatformRecord) == 44);
+    static_assert(sizeof(WallRecord) == 52);
+    static_assert(sizeof(PolygonPlatformRecord) == 40);
+    static_assert(sizeof(PillarRecord) == 36);
+    static_assert(sizeof(RampRecord) == 48);
+
+    constexpr std::array<std::uint32_t, SECTION_COUNT> RECORD_SIZES = {
+        sizeof(PlatformRecord), sizeof(WallRecord), sizeof(PolygonPlatformRecord),
+        sizeof(PillarRecord),   sizeof(RampRecord),
+    };
+
+    // =======================================
+    //      Object <-> Record Conversions
+    // =======================================
+    template <typename TextureFunc>
+    PlatformRecord to_record(const PlatformObject& platform, TextureFunc&& texture)
+    {
+        auto& props = platform.properties;
+        return {
+            .position = platform.parameters.position,
+            .texture_top = texture(props.texture_top),
+            .texture_bottom = texture(props.texture_bottom),
+            .size = props.size,
+            .base = props.base,
+            .style = static_cast<std::uint32_t>(props.style),
+            .direction = static_cast<std::uint32_t>(props.direction),
+        };
+    }
+
+    template <typename TextureFunc>
+    WallRecord to_record(const WallObject& wall, TextureFunc&& texture)
+    {
+        auto& props = wall.properties;
+        return {
+            .start = wall.parameters.line.start,
+            .end = wall.parameters.line.end,
+            .texture_front = texture(props.texture_front),
+            .texture_back = texture(props.texture_back),
+            .start_base_height = props.start_base_height,
+            .start_height = props.start_height,
+            .end_base_height = props.end_base_height,
+            .end_height = props.end_height,
+            .style = static_cast<std::uint32_t>(props.style),
+        };
+    }
+
+    /// The rings are written separately as they are not fixed size
+    template <typename TextureFunc>
+    PolygonPlatformRecord to_record(const PolygonPlatformObject& polygon, TextureFunc&& texture)
+    {
+        auto& props = polygon.properties;
+        return {
+            .position = polygon.parameters.position,
+            .texture_top = texture(props.texture_top),
+            .texture_bottom = texture(props.texture_bottom),
+            .base = props.base,
+            .visible = props.visible,
+            .first_ring = 0,
+            .ring_count = 0,
+        };
+    }
+
+    template <typename TextureFunc>
+    PillarRecord to_record(const PillarObject& pillar, TextureFunc&& texture)
+    {
+        auto& props = pillar.properties;
+        return {
+            .position = pillar.parameters.position,
+            .texture = texture(props.texture),
+            .style = static_cast<std::uint32_t>(props.style),
+            .size = props.size,
+            .base_height = props.base_height,
+            .height = props.height,
+            .angled = props.angled,
+        };
+    }
+
+    template <typename TextureFunc>
+    RampRecord to_record(const RampObject& ramp, TextureFunc&& texture)
+    {
+        auto& props = ramp.properties;
+        return {
+            .position = ramp.parameters.position,
+            .texture_top = texture(props.texture_top),
+            .texture_bottom = texture(props.texture_bottom),
+            .size = props.size,
+            .start_height = props.start_height,
+            .end_height = props.end_height,
+            .direction = static_cast<std::uint32_t>(props.direction),
+            .style = static_cast<std::uint32_t>(props.style),
+        };
+    }
+
+    template <typename TextureFunc>
+    PlatformObject from_record(const PlatformRecord& record, TextureFunc&& texture)
+    {
+        PlatformObject platform;
+        auto& props = platform.properties;
+        platform.parameters.position = record.position;
+        props.texture_top = texture(record.texture_top);
+        props.texture_bottom = texture(record.texture_bottom);
+        props.size = record.size;
+        props.base = record.base;
+        props.style = static_cast<PlatformStyle>(record.style);
+        props.direction = static_cast<Direction>(record.direction);
+        return platform;
+    }
+
+    template <typename TextureFunc>
+    WallObject from_record(const WallRecord& record, TextureFunc&& texture)
+    {
+        WallObject wall;
+        auto& props = wall.properties;
+        wall.parameters.line = {record.start, record.end};
+        props.texture_front = texture(record.texture_front);
+        props.texture_back = texture(record.texture_back);
+        props.start_base_height = record.start_base_height;
+        props.start_height = record.start_height;
+        props.end_base_height = record.end_base_height;
+        props.end_height = record.end_height;
+        props.style = static_cast<WallStyle>(record.style);
+        return wall;
+    }
+
+    template <typename TextureFunc>
+    PolygonPlatformObject from_record(const PolygonPlatformRecord& record, TextureFunc&& texture)
+    {
+        PolygonPlatformObject polygon;
+        auto& props = polygon.properties;
+        polygon.parameters.position = record.position;
+        props.texture_top = texture(record.texture_top);
+        props.texture_bottom = texture(record.texture_bottom);
+        props.base = record.base;
+        props.visible = record.visible != 0;
+        return polygon;
+    }
+
+    template <typename TextureFunc>
+    PillarObject from_record(const PillarRecord& record, TextureFunc&& texture)
+    {
+        PillarObject pillar;
+        auto& props = pillar.properties;
+        pillar.parameters.position = record.position;
+        props.texture = texture(record.texture);
+        props.style = static_cast<PillarStyle>(record.style);
+        props.size = record.size;
+        props.base_height = record.base_height;
+        props.height = record.height;
+        props.angled = record.angled != 0;
+        return pillar;
+    }
+
+    template <typename TextureFunc>
+    RampObject from_record(const RampRecord& record, TextureFunc&& texture)
+    {
+        RampObject ramp;
+        auto& props = ramp.properties;
+        ramp.parameters.position = record.position;
+        props.texture_top = texture(record.texture_top);
+        props.texture_bottom = texture(record.texture_bottom);
+        props.size = record.size;
+        props.start_height = record.start_height;
+        props.end_height = record.end_height;
+        props.direction = static_cast<Direction>(record.direction);
+        props.style = static_cast<RampStyle>(record.style);
+        return ramp;
+    }
+
+    // =======================================
+    //      Reading Helpers
+    // =======================================
+    bool is_in_bounds(std::span<const std::byte> data, std::uint64_t offset, std::uint64_t size)
+    {
+        return offset <= data.size() && size <= data.size() - offset;
+    }
+
+    /// Copies the values out of the file rather than pointing into it, as the offsets are not
+    /// guaranteed to be aligned for the type if the file is corrupt
+    template <typename T>
+    bool read_values(std::span<const std::byte> data, std::uint64_t offset, T* p_values,
+                     std::uint64_t count = 1)
+    {
+        if (count > data.size() / sizeof(T) || !is_in_bounds(data, offset, count * sizeof(T)))
+        {
+            return false;
+        }
+        if (count > 0)
+        {
+            std::memcpy(p_values, data.data() + offset, count * sizeof(T));
+        }
+        return true;
+    }
+
+    /// Calls "func" with each record of the type's section, stopping if it returns false
+    template <typename Record, typename Func>
+    bool for_each_record(std::span<const std::byte> data, const FloorEntry& floor, Func&& func)
+    {
+        auto& section = floor.sections[Record::SECTION];
+        if (section.record_size != sizeof(Record) ||
+            !is_in_bounds(data, section.offset, std::uint64_t{section.count} * sizeof(Record)))
+        {
+            return false;
+        }
+
+        for (std::uint32_t i = 0; i < section.count; i++)
+        {
+            Record record;
+            std::memcpy(&record, data.data() + section.offset + i * sizeof(Record), sizeof(Record));
+            if (!func(record))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // =======================================
+    //      Single Object Records
+    // =======================================
+    template <typename T>
+    void append_value(std::vector<std::byte>& output, const T& value)
+    {
+        auto p_value = reinterpret_cast<const std::byte*>(&value);
+        output.insert(output.end(), p_value, p_value + sizeof(T));
+    }
+
+    /// Reads values from the start of "input" and advances past them
+    template <typename T>
+    bool take_values(std::span<const std::byte>& input, T* p_values, std::uint64_t count = 1)
+    {
+        if (!read_values(input, 0, p_values, count))
+        {
+            return false;
+        }
+        input = input.subspan(count * sizeof(T));
+        return true;
+    }
+
+    /// The colour is stored in place of the colour index, as there is no colour table
+    TextureRecord to_inline_texture(const TextureProp& prop)
+    {
+        return {.id = prop.id, .colour_index = std::bit_cast<std::uint32_t>(prop.colour)};
+    }
+
+    TextureProp from_inline_texture(const TextureRecord& record)
+    {
+        return {.id = record.id, .colour = std::bit_cast<glm::u8vec4>(record.colour_index)};
+    }
+
+    template <typename Record>
+    std::optional<LevelObject> take_object_record(std::span<const std::byte>& input)
+    {
+        Record record;
+        if (!take_values(input, &record))
+        {
+            return {};
+        }
+        return LevelObject{from_record(record, from_inline_texture)};
+    }
+
+    /// Polygon records are followed by their rings, each a u32 point count and then its points
+    template <>
+    std::optional<LevelObject> take_object_record<PolygonPlatformRecord>(
+        std::span<const std::byte>& input)
+    {
+        PolygonPlatformRecord record;
+        if (!take_values(input, &record))
+        {
+            return {};
+        }
+
+        auto polygon = from_record(record, from_inline_texture);
+        auto& geometry = polygon.properties.geometry;
+        geometry.clear();
+        for (std::uint32_t i = 0; i < record.ring_count; i++)
+        {
+            std::uint32_t point_count = 0;
+            if (!take_values(input, &point_count) ||
+                point_count > input.size() / sizeof(glm::vec2))
+            {
+                return {};
+            }
+
+            auto& ring = geometry.emplace_back(point_count);
+            take_values(input, ring.data(), point_count);
+        }
+        return LevelObject{polygon};
+    }
+} // namespace
+
+// =======================================
+//      LevelBinaryWriter
+// =======================================
+void LevelBinaryWriter::begin_floor(int floor_number)
+{
+    auto& floor = floors_.emplace_back();
+    floor.floor_number = floor_number;
+    floor.sections.resize(SECTION_COUNT);
+}
+
+void LevelBinaryWriter::add_object(const LevelObject& object)
+{
+    assert(!floors_.empty() && "\"begin_floor\" must be called before adding objects");
+
+    auto texture = [&](const TextureProp& prop) -> TextureRecord
+    { return {.id = prop.id, .colour_index = get_colour_index(prop.colour)}; };
+
+    std::visit(
+        [&]<typename T>(const T& typed_object)
+        {
+            auto record = to_record(typed_object, texture);
+            if constexpr (std::is_same_v<T, PolygonPlatformObject>)
+            {
+                auto& geometry = typed_object.properties.geometry;
+                record.first_ring = static_cast<std::uint32_t>(rings_.size());
+                record.ring_count = static_cast<std::uint32_t>(geometry.size());
+                for (auto& ring : geometry)
+                {
+                    rings_.emplace_back(static_cast<std::uint32_t>(points_.size()),
+                                        static_cast<std::uint32_t>(ring.size()));
+                    points_.insert(points_.end(), ring.begin(), ring.end());
+                }
+            }
+            add_record(record);
+        },
+        object.object_type);
+}
+
+std::string LevelBinaryWriter::finish(std::uint64_t save_id) const
+{
+    std::string output(sizeof(Header), '\0');
+
+    // Appends the bytes as a new table, returning where it starts
+    auto append_table = [&](const void* p_data, std::size_t size) -> std::uint64_t
+    {
+        output.resize((output.size() + 7) & ~std::size_t{7});
+        auto offset = output.size();
+        if (size > 0)
+        {
+            output.append(static_cast<const char*>(p_data), size);
+        }
+        return offset;
+    };
+
+    Header header;
+    header.save_id = save_id;
+    header.floor_count = static_cast<std::uint32_t>(floors_.size());
+    header.colour_count = static_cast<std::uint32_t>(colours_.size());
+    header.ring_count = static_cast<std::uint32_t>(rings_.size());
+    header.point_count = static_cast<std::uint32_t>(points_.size());
+    header.colours_offset = append_table(colours_.data(), colours_.size() * sizeof(glm::u8vec4));
+
+    std::vector<FloorEntry> floor_entries(floors_.size());
+    for (std::size_t i = 0; i < floors_.size(); i++)
+    {
+        auto& floor = floors_[i];
+        floor_entries[i].floor_number = floor.floor_number;
+        for (std::size_t section = 0; section < SECTION_COUNT; section++)
+        {
+            auto& records = floor.sections[section];
+            floor_entries[i].sections[section] = {
+                .offset = append_table(records.data(), records.size()),
+                .count = static_cast<std::uint32_t>(records.size() / RECORD_SIZES[section]),
+                .record_size = RECORD_SIZES[section],
+            };
+        }
+    }
+    header.floors_offset =
+        append_table(floor_entries.data(), floor_entries.size() * sizeof(FloorEntry));
+    header.rings_offset = append_table(rings_.data(), rings_.size() * sizeof(glm::uvec2));
+    header.points_offset = append_table(points_.data(), points_.size() * sizeof(glm::vec2));
+
+    std::memcpy(output.data(), &header, sizeof(Header));
+    return output;
+}
+
+template <typename Record>
+void LevelBinaryWriter::add_record(const Record& record)
+{
+    auto& section = floors_.back().sections[Record::SECTION];
+    auto p_record = reinterpret_cast<const std::byte*>(&record);
+    section.insert(section.end(), p_record, p_record + sizeof(Record));
+}
+
+std::uint32_t LevelBinaryWriter::get_colour_index(glm::u8vec4 colour)
+{
+    for (std::size_t i = 0; i < colours_.size(); i++)
+    {
+        if (colours_[i] == colour)
+        {
+            return static_cast<std::uint32_t>(i);
+        }
+    }
+    colours_.push_back(colour);
+    return static_cast<std::uint32_t>(colours_.size() - 1);
+}
+
+// =======================================
+//      Single Object Records
+// =======================================
+void write_object_record(std::vector<std::byte>& output, const LevelObject& object)
+{
+    std::visit(
+        [&]<typename T>(const T& typed_object)
+        {
+            auto record = to_record(typed_object, to_inline_texture);
+            append_value(output, static_cast<std::uint8_t>(decltype(record)::SECTION));
+            if constexpr (std::is_same_v<T, PolygonPlatformObject>)
+            {
+                auto& geometry = typed_object.properties.geometry;
+                record.ring_count = static_cast<std::uint32_t>(geometry.size());
+                append_value(output, record);
+                for (auto& ring : geometry)
+                {
+                    append_value(output, static_cast<std::uint32_t>(ring.size()));
+                    for (auto& point : ring)
+                    {
+                        append_value(output, point);
+                    }
+                }
+            }
+            else
+            {
+                append_value(output, record);
+            }
+        },
+        object.object_type);
+}
+
+std::optional<LevelObject> read_object_record(std::span<const std::byte>& input)
+{
+    std::uint8_t section = 0;
+    if (!take_values(input, &section))
+    {
+        return {};
+    }
+
+    switch (section)
+    {
+        case PlatformRecord::SECTION:
+            return take_object_record<PlatformRecord>(input);
+        case WallRecord::SECTION:
+            return take_object_record<WallRecord>(input);
+        case PolygonPlatformRecord::SECTION:
+            return take_object_record<PolygonPlatformRecord>(input);
+        case PillarRecord::SECTION:
+            return take_object_record<PillarRecord>(input);
+        case RampRecord::SECTION:
+            return take_object_record<RampRecord>(input);
+        default:
+            return {};
+    }
+}
+
+// =======================================
+//      LevelBinaryReader
+// =======================================
+bool LevelBinaryReader::open(const std::filesystem::path& path)
+{
+    if (!file_.open(path))
+    {
+        std::println(std::cerr, "Could not map level file {}", path.string());
+        return false;
+    }
+    auto data = file_.data();
+
+    Header header;
+    if (!read_values(data, 0, &header) || header.magic != MAGIC)
+    {
+        std::println(std::cerr, "{} is not a binary level file", path.string());
+        return false;
+    }
+    if (header.version != LEVEL_BINARY_VERSION)
+    {
+        std::println(std::cerr, "{} is binary level version {}, expected version {}",
+                     path.string(), header.version, LEVEL_BINARY_VERSION);
+        return false;
+    }
+
+    // The counts are checked against the file size before anything is allocated from them, so a
+    // corrupt count fails to open rather than trying to allocate gigabytes
+    if (!is_in_bounds(data, header.colours_offset,
+                      std::uint64_t{header.colour_count} * sizeof(glm::u8vec4)) ||
+        !is_in_bounds(data, header.floors_offset,
+                      std::uint64_t{header.floor_count} * sizeof(FloorEntry)) ||
+        !is_in_bounds(data, header.rings_offset,
+                      std::uint64_t{header.ring_count} * sizeof(glm::uvec2)) ||
+        !is_in_bounds(data, header.points_offset,
+                      std::uint64_t{header.point_count} * sizeof(glm::vec2)))
+    {
+        std::println(std::cerr, "Binary level file {} is truncated", path.string());
+        return false;
+    }
+
+    colours_.resize(header.colour_count);
+    std::vector<FloorEntry> floors(header.floor_count);
+    read_values(data, header.colours_offset, colours_.data(), header.colour_count);
+    read_values(data, header.floors_offset, floors.data(), header.floor_count);
+
+    // Floors are written from bottom to top without gaps, which the floor manager relies on when
+    // the floors are created
+    floor_numbers_.clear();
+    for (auto& floor : floors)
+    {
+        if (!floor_numbers_.empty() && floor.floor_number != floor_numbers_.back() + 1)
+        {
+            std::println(std::cerr, "Binary level file {} has missing floors", path.string());
+            return false;
+        }
+        floor_numbers_.push_back(floor.floor_number);
+    }
+    floors_offset_ = header.floors_offset;
+    rings_offset_ = header.rings_offset;
+    points_offset_ = header.points_offset;
+    ring_count_ = header.ring_count;
+    point_count_ = header.point_count;
+    save_id_ = header.save_id;
+    return true;
+}
+
+std::size_t LevelBinaryReader::floor_count() const
+{
+    return floor_numbers_.size();
+}
+
+int LevelBinaryReader::get_floor_number(std::size_t floor_index) const
+{
+    return floor_numbers_[floor_index];
+}
+
+std::uint64_t LevelBinaryReader::get_save_id() const
+{
+    return save_id_;
+}
+
+bool LevelBinaryReader::read_floor(std::size_t floor_index,
+                                   const std::function<void(const LevelObject&)>& on_object) const
+{
+    auto data = file_.data();
+
+    FloorEntry floor;
+    if (!read_values(data, floors_offset_ + floor_index * sizeof(FloorEntry), &floor))
+    {
+        return false;
+    }
+
+    // Set rather than returned by the texture function to avoid checking every texture
+    bool textures_valid = true;
+    auto texture = [&](const TextureRecord& record) -> TextureProp
+    {
+        if (record.colour_index >= colours_.size())
+        {
+            textures_valid = false;
+            return {};
+        }
+        return {.id = record.id, .colour = colours_[record.colour_index]};
+    };
+
+    auto read_object = [&](const auto& record)
+    {
+        LevelObject object{from_record(record, texture)};
+        if (textures_valid)
+        {
+            on_object(object);
+        }
+        return textures_valid;
+    };
+
+    auto read_polygon = [&](const PolygonPlatformRecord& record)
+    {
+        if (std::uint64_t{record.first_ring} + record.ring_count > ring_count_)
+        {
+            return false;
+        }
+
+        auto polygon = from_record(record, texture);
+        auto& geometry = polygon.properties.geometry;
+        geometry.resize(record.ring_count);
+        for (std::uint32_t i = 0; i < record.ring_count; i++)
+        {
+            glm::uvec2 ring;
+            auto ring_offset = rings_offset_ + (record.first_ring + i) * sizeof(glm::uvec2);
+            if (!read_values(data, ring_offset, &ring) ||
+                std::uint64_t{ring.x} + ring.y > point_count_)
+            {
+                return false;
+            }
+
+            geometry[i].resize(ring.y);
+            read_values(data, points_offset_ + ring.x * sizeof(glm::vec2), geometry[i].data(),
+                        ring.y);
+        }
+
+        if (textures_valid)
+        {
+            on_object(LevelObject{polygon});
+        }
+        return textures_valid;
+    };
+
+    // Read in a fixed order such that objects are given the same IDs each time the file is loaded.
+    // This is the order of the type names, the same as the JSON which sorts its object types by
+    // name, such that the IDs are the same whichever format is loaded (See FloorsSnapshot).
+    return for_each_record<PillarRecord>(data, floor, read_object) &&
+           for_each_record<PlatformRecord>(data, floor, read_object) &&
+           for_each_record<PolygonPlatformRecord>(data, floor, read_polygon) &&
+           for_each_record<RampRecord>(data, floor, read_object) &&
+           for_each_record<WallRecord>(data, floor, read_object);
+}
\ No newline at end of file
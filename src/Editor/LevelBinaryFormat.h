@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "../Util/MappedFile.h"
+#include "LevelObjects/LevelObject.h"
+
+/// Bumped whenever the layout of any of the binary level records change. Files of any other
+/// version are rejected, with JSON being the format for moving levels between versions.
+constexpr static std::uint32_t LEVEL_BINARY_VERSION = 2;
+
+/// Writes floors of level objects to the binary level format (.clb). Rather than one object at a
+/// time, the file is laid out as tables such that it can be read straight from a mapped file:
+///
+///  Header   - Magic "CLYB", the version, the offset and size of each table below, and the ID of
+///             the save (See EditJournal)
+///  Colours  - Each unique colour once, referenced by index by each texture
+///  Sections - Arrays of fixed size records, one array per object type per floor
+///  Floors   - Per floor, the floor number and the offset, count and record size of the section
+///             holding each object type
+///  Rings    - Polygon platform outlines and holes, each a range of the points table
+///  Points   - The points of every polygon platform ring
+///
+/// All values are little endian and each table is aligned to 8 bytes. Positions are stored in
+/// world pixels as they are in memory, rather than in tiles as with the JSON.
+class LevelBinaryWriter
+{
+  public:
+    /// Starts a new floor, which following objects are added to
+    void begin_floor(int floor_number);
+
+    void add_object(const LevelObject& object);
+
+    /// Lays out the floors and tables written so far into the file contents
+    [[nodiscard]] std::string finish(std::uint64_t save_id) const;
+
+  private:
+    struct FloorSections
+    {
+        int floor_number = 0;
+        std::vector<std::vector<std::byte>> sections;
+    };
+
+    template <typename Record>
+    void add_record(const Record& record);
+
+    std::uint32_t get_colour_index(glm::u8vec4 colour);
+
+    std::vector<FloorSections> floors_;
+    std::vector<glm::u8vec4> colours_;
+
+    /// First point and point count of each polygon ring
+    std::vector<glm::uvec2> rings_;
+    std::vector<glm::vec2> points_;
+};
+
+/// Appends a single object as its record, with its colours and polygon rings stored inline rather
+/// than in tables. Used where objects are written one at a time (See EditJournal).
+void write_object_record(std::vector<std::byte>& output, const LevelObject& object);
+
+/// Reads an object written by write_object_record from the start of "input", advancing "input"
+/// past it. Returns nothing if the record is corrupt.
+std::optional<LevelObject> read_object_record(std::span<const std::byte>& input);
+
+/// Reads levels written by LevelBinaryWriter. The file is mapped into memory and each object is
+/// decoded from its record when its floor is read.
+class LevelBinaryReader
+{
+  public:
+    /// Maps the file and validates the header and the floors directory
+    bool open(const std::filesystem::path& path);
+
+    [[nodiscard]] std::size_t floor_count() const;
+    [[nodiscard]] int get_floor_number(std::size_t floor_index) const;
+    [[nodiscard]] std::uint64_t get_save_id() const;
+
+    /// Decodes each object on the floor, calling "on_object" for each object grouped by type in
+    /// the order of the type names (pillars, platforms, polygon platforms, ramps then walls), and
+    /// in the order they were written within each type. This is the order the JSON is read in, and
+    /// the order objects are given their IDs when loaded (See FloorsSnapshot). Returns false if any
+    /// of the floor's records are corrupt.
+    bool read_floor(std::size_t floor_index,
+                    const std::function<void(const LevelObject&)>& on_object) const;
+
+  private:
+    MappedFile file_;
+    std::vector<glm::u8vec4> colours_;
+    std::vector<int> floor_numbers_;
+
+    std::uint64_t floors_offset_ = 0;
+    std::uint64_t rings_offset_ = 0;
+    std::uint64_t points_offset_ = 0;
+    std::uint32_t ring_count_ = 0;
+    std::uint32_t point_count_ = 0;
+    std::uint64_t save_id_ = 0;
+};
\ No newline at end of file
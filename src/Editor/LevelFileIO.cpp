@@ -5,62 +5,348 @@
 
 #include <SFML/System/Clock.hpp>
 #include <SFML/System/Time.hpp>
-#include <zlib.h>
 
+#include "../Util/AppendFile.h"
 #include "../Util/ImGuiExtras.h"
 #include "../Util/Util.h"
+#include "../Util/ZlibStream.h"
 
 namespace
 {
-    std::optional<std::string> compress_data(const std::string& json_dump)
+    /// Reads a JSON level (See FloorManager::serialise) as a stream of SAX events. Only the values
+    /// of a single object are built into a JSON value at a time, which is passed to "on_object"
+    /// once complete such that it can be read by each object's "object_deserialise" function.
+    class LevelJsonSax : public nlohmann::json_sax<nlohmann::json>
     {
-        // Get the size of the compressed data
-        std::string compressed;
-        auto size = static_cast<uLong>(json_dump.size());
-        auto compressed_length = compressBound(size);
-        compressed.resize(compressed_length);
+        /// Where in the level the parser is, such that values can be read into the right place
+        enum class Context
+        {
+            Document,
+            Root,
+            Meta,
+            Colours,
+            Colour,
+            Floors,
+            Floor,
+            ObjectTypes,
+            Objects,
+            Skip,
+        };
+
+        /// Objects read before their floor number or the colours, which is not the case for levels
+        /// saved by the editor as the keys are saved in order, but could be for edited files
+        struct PendingObject
+        {
+            std::optional<int> floor_number;
+            std::string type;
+            nlohmann::json json;
+        };
+
+      public:
+        LevelJsonSax(std::vector<glm::u8vec4>& colours, int& version, std::uint64_t& save_id,
+                     const LevelFileIO::JsonFloorFunc& on_floor,
+                     const LevelFileIO::JsonObjectFunc& on_object)
+            : colours_(colours)
+            , version_(version)
+            , save_id_(save_id)
+            , on_floor_(on_floor)
+            , on_object_(on_object)
+        {
+        }
 
-        int result = compress(reinterpret_cast<Bytef*>(&compressed[0]), &compressed_length,
-                              reinterpret_cast<const Bytef*>(json_dump.c_str()), size);
-        if (result != Z_OK)
+        bool null() override
         {
-            std::println(std::cerr, "Error compressing data");
-            return {};
+            return read_value(nullptr);
         }
-        compressed.resize(compressed_length);
-        return compressed;
-    }
 
-    std::optional<std::string> decompress_from_file(const std::filesystem::path& path,
-                                                    std::size_t size)
-    {
-        // Open the binary file
-        std::ifstream compressed_file(path.string(), std::ios::binary);
-        if (!compressed_file.is_open())
+        bool boolean(bool value) override
         {
-            std::println(std::cerr, "Could not open level file for {}", path.string());
-            return {};
+            return read_value(value);
         }
 
-        // Read the contents to a string
-        std::string contents((std::istreambuf_iterator<char>(compressed_file)),
-                             std::istreambuf_iterator<char>());
+        bool number_integer(number_integer_t value) override
+        {
+            return read_value(value);
+        }
 
-        // Decompress the data a string
-        std::string decompressed;
-        decompressed.resize(size);
-        auto size_zlib = static_cast<uLongf>(size);
-        int result = uncompress(reinterpret_cast<Bytef*>(&decompressed[0]), &size_zlib,
-                                reinterpret_cast<const Bytef*>(contents.c_str()),
-                                static_cast<uLongf>(contents.size()));
-        // Checks
-        if (result != Z_OK)
+        bool number_unsigned(number_unsigned_t value) override
         {
-            std::println(std::cerr, "Error decompressing file: {}", path.string());
-            return {};
+            return read_value(value);
         }
-        return decompressed;
-    }
+
+        bool number_float(number_float_t value, const string_t&) override
+        {
+            return read_value(value);
+        }
+
+        bool string(string_t& value) override
+        {
+            return read_value(std::move(value));
+        }
+
+        bool binary(binary_t&) override
+        {
+            return read_value(nullptr);
+        }
+
+        bool start_object(std::size_t) override
+        {
+            return start(false);
+        }
+
+        bool end_object() override
+        {
+            return end();
+        }
+
+        bool start_array(std::size_t) override
+        {
+            return start(true);
+        }
+
+        bool end_array() override
+        {
+            return end();
+        }
+
+        bool key(string_t& key) override
+        {
+            key_ = std::move(key);
+            return true;
+        }
+
+        bool parse_error(std::size_t position, const std::string&,
+                         const nlohmann::json::exception& exception) override
+        {
+            std::println(std::cerr, "Error reading level file at {}: {}", position,
+                         exception.what());
+            return false;
+        }
+
+      private:
+        template <typename T>
+        bool read_value(T&& value)
+        {
+            if (!object_stack_.empty())
+            {
+                add_to_object(std::forward<T>(value));
+                return true;
+            }
+
+            if constexpr (std::is_arithmetic_v<std::remove_cvref_t<T>>)
+            {
+                switch (contexts_.back())
+                {
+                    case Context::Meta:
+                        if (key_ == "version")
+                        {
+                            version_ = static_cast<int>(value);
+                        }
+                        else if (key_ == "save_id")
+                        {
+                            save_id_ = static_cast<std::uint64_t>(value);
+                        }
+                        break;
+
+                    case Context::Colour:
+                        if (colour_component_ < 4)
+                        {
+                            colour_[colour_component_++] = static_cast<std::uint8_t>(value);
+                        }
+                        break;
+
+                    case Context::Floor:
+                        if (key_ == "floor")
+                        {
+                            floor_number_ = static_cast<int>(value);
+                            on_floor_(*floor_number_);
+                        }
+                        break;
+
+                    default:
+                        break;
+                }
+            }
+
+            if (contexts_.back() == Context::Objects)
+            {
+                std::println(std::cerr, "Invalid {} object in level file", type_);
+                return false;
+            }
+            return true;
+        }
+
+        bool start(bool is_array)
+        {
+            // Values within an object are built up to be deserialised once the object is complete
+            if (!object_stack_.empty() || contexts_.back() == Context::Objects)
+            {
+                auto value = is_array ? nlohmann::json::array() : nlohmann::json::object();
+                object_stack_.push_back(add_to_object(std::move(value)));
+                return true;
+            }
+
+            auto context = next_context(is_array);
+            switch (context)
+            {
+                case Context::Colour:
+                    colour_ = glm::u8vec4{255};
+                    colour_component_ = 0;
+                    break;
+
+                case Context::Floor:
+                    floor_number_.reset();
+                    break;
+
+                case Context::Objects:
+                    type_ = key_;
+                    break;
+
+                default:
+                    break;
+            }
+            contexts_.push_back(context);
+            return true;
+        }
+
+        bool end()
+        {
+            if (!object_stack_.empty())
+            {
+                object_stack_.pop_back();
+                return object_stack_.empty() ? add_object() : true;
+            }
+
+            auto context = contexts_.back();
+            contexts_.pop_back();
+            switch (context)
+            {
+                case Context::Colour:
+                    colours_.push_back(colour_);
+                    break;
+
+                case Context::Colours:
+                    colours_read_ = true;
+                    return flush_pending_objects();
+
+                case Context::Floor:
+                    if (!floor_number_)
+                    {
+                        std::println(std::cerr, "Floor object in level file has no floor number");
+                        return false;
+                    }
+                    for (auto& pending : pending_)
+                    {
+                        pending.floor_number = pending.floor_number.value_or(*floor_number_);
+                    }
+                    return !colours_read_ || flush_pending_objects();
+
+                case Context::Root:
+                    return flush_pending_objects();
+
+                default:
+                    break;
+            }
+            return true;
+        }
+
+        Context next_context(bool is_array) const
+        {
+            switch (contexts_.back())
+            {
+                case Context::Document:
+                    return is_array ? Context::Skip : Context::Root;
+
+                case Context::Root:
+                    if (key_ == "colours" && is_array)
+                    {
+                        return Context::Colours;
+                    }
+                    if (key_ == "floors" && is_array)
+                    {
+                        return Context::Floors;
+                    }
+                    return key_ == "meta" && !is_array ? Context::Meta : Context::Skip;
+
+                case Context::Colours:
+                    return is_array ? Context::Colour : Context::Skip;
+
+                case Context::Floors:
+                    return is_array ? Context::Skip : Context::Floor;
+
+                case Context::Floor:
+                    return key_ == "objects" && !is_array ? Context::ObjectTypes : Context::Skip;
+
+                case Context::ObjectTypes:
+                    return is_array ? Context::Objects : Context::Skip;
+
+                default:
+                    return Context::Skip;
+            }
+        }
+
+        nlohmann::json* add_to_object(nlohmann::json value)
+        {
+            if (object_stack_.empty())
+            {
+                object_ = std::move(value);
+                return &object_;
+            }
+
+            auto& parent = *object_stack_.back();
+            if (parent.is_array())
+            {
+                parent.push_back(std::move(value));
+                return &parent.back();
+            }
+            return &(parent[key_] = std::move(value));
+        }
+
+        bool add_object()
+        {
+            if (pending_.empty() && colours_read_ && floor_number_)
+            {
+                return on_object_(*floor_number_, type_, object_);
+            }
+            pending_.push_back({floor_number_, type_, std::move(object_)});
+            return true;
+        }
+
+        bool flush_pending_objects()
+        {
+            for (auto& pending : pending_)
+            {
+                if (!on_object_(pending.floor_number.value_or(0), pending.type, pending.json))
+                {
+                    return false;
+                }
+            }
+            pending_.clear();
+            return true;
+        }
+
+        std::vector<glm::u8vec4>& colours_;
+        int& version_;
+        std::uint64_t& save_id_;
+        const LevelFileIO::JsonFloorFunc& on_floor_;
+        const LevelFileIO::JsonObjectFunc& on_object_;
+
+        std::vector<Context> contexts_ = {Context::Document};
+        std::string key_;
+
+        glm::u8vec4 colour_{255};
+        int colour_component_ = 0;
+        bool colours_read_ = false;
+
+        std::optional<int> floor_number_;
+        std::string type_;
+
+        /// The object currently being read, and the arrays and objects within it that are open
+        nlohmann::json object_;
+        std::vector<nlohmann::json*> object_stack_;
+
+        std::vector<PendingObject> pending_;
+    };
 
     std::filesystem::path make_level_directory_path(const std::string& level_name)
     {
@@ -72,6 +358,11 @@ namespace
         return make_level_directory_path(level_name) / std::string(level_name + ".cly");
     }
 
+    std::filesystem::path make_binary_level_path(const std::string& level_name)
+    {
+        return make_level_directory_path(level_name) / std::string(level_name + ".clb");
+    }
+
     std::filesystem::path make_uncompressed_level_path(const std::string& level_name)
     {
         return make_level_directory_path(level_name) / std::string(level_name + ".cly.json");
@@ -94,6 +385,35 @@ namespace
         return nlohmann::json::parse(meta_file);
     }
 
+    /// Writes the file via a temporary file next to it, which is renamed over the file once
+    /// "write_file" has written it successfully. Renaming within the same directory replaces the
+    /// file atomically, so the file is never left partially written.
+    template <typename WriteFunc>
+    bool write_file_atomically(const std::filesystem::path& path, WriteFunc&& write_file)
+    {
+        auto temp_path = path;
+        temp_path += ".tmp";
+
+        // The file must be on disk before it replaces the old file, otherwise a crash soon after
+        // could leave the renamed file empty
+        std::error_code error;
+        if (!write_file(temp_path) || !sync_file(temp_path))
+        {
+            std::println(std::cerr, "Error writing {}", path.string());
+            std::filesystem::remove(temp_path, error);
+            return false;
+        }
+
+        std::filesystem::rename(temp_path, path, error);
+        if (error)
+        {
+            std::println(std::cerr, "Error replacing {}: {}", path.string(), error.message());
+            std::filesystem::remove(temp_path, error);
+            return false;
+        }
+        return true;
+    }
+
 } // namespace
 
 bool level_file_exists(const std::string level_name)
@@ -106,42 +426,27 @@ bool level_file_exists(const std::filesystem::path level_name)
     return level_file_exists(level_name.stem().string());
 }
 
-bool LevelFileIO::open(const std::string& level_name, bool load_uncompressed)
+std::filesystem::path make_level_journal_path(const std::string& level_name)
 {
-    //==========
-    //  Helpers
-    // =========
-    size_t size = 0;
-    auto load_metadata = [&](const nlohmann::json& meta)
-    {
-        version_ = meta["version"];
-        size = meta["size"];
-    };
-
-    auto load_colours = [&]()
-    {
-        for (auto& object : json_["colours"])
-        {
-            colours_.push_back({object[0], object[1], object[2], object[3]});
-        }
-    };
+    return make_level_directory_path(level_name) / std::string(level_name + ".journal");
+}
 
+bool LevelFileIO::open(const std::string& level_name, bool load_uncompressed)
+{
     //====================================
     //  Load from the uncompressed format
     // ===================================
+    // The JSON formats are only checked here, and are streamed from the file by "read_json_floors"
     if (load_uncompressed)
     {
         auto path = make_uncompressed_level_path(level_name);
-        std::ifstream file(path);
-        if (!file.is_open())
+        if (!std::filesystem::exists(path))
         {
             std::println(std::cerr, "Could not open file {}", path.string());
             return false;
         }
-        json_ = nlohmann::json::parse(file);
-        load_metadata(json_["meta"]);
-        load_colours();
-
+        json_path_ = path;
+        json_compressed_ = false;
         return true;
     }
 
@@ -153,20 +458,34 @@ bool LevelFileIO::open(const std::string& level_name, bool load_uncompressed)
     // Load metadata from the metafile
     if (auto metadata = get_metafile_content(level_name))
     {
-        load_metadata(*metadata);
+        version_ = (*metadata)["version"];
+        bool is_binary = metadata->value("format", "json") == "binary";
 
-        // Load objects from the binary file
-        if (auto decompressed = decompress_from_file(path, size))
+        // The objects are decoded from the mapped file when deserialised
+        if (is_binary)
         {
-            json_ = nlohmann::json::parse(*decompressed);
-
-            // Load additional data
-            load_colours();
+            auto binary_path = make_binary_level_path(level_name);
+            if (binary_reader_.emplace().open(binary_path))
+            {
+                format_ = LevelFileFormat::Binary;
+                save_id_ = binary_reader_->get_save_id();
+                std::println("Successfully opened {}", binary_path.string());
+                return true;
+            }
+            binary_reader_.reset();
+            return false;
+        }
 
-            std::println("Successfully opened {}", path.string());
-            return true;
+        if (!std::filesystem::exists(path))
+        {
+            std::println(std::cerr, "Could not open level file for {}", path.string());
+            return false;
         }
-        return false;
+        json_path_ = path;
+        json_compressed_ = true;
+
+        std::println("Successfully opened {}", path.string());
+        return true;
     }
     else
     {
@@ -177,17 +496,8 @@ bool LevelFileIO::open(const std::string& level_name, bool load_uncompressed)
 
 bool LevelFileIO::save(const std::string& level_name, bool save_uncompressed)
 {
-    auto path = make_level_path(level_name);
-
-    // Add additional data to the compressed JSON prior to saving
-    json_["colours"] = {};
-    for (auto& colour : colours_)
-    {
-        json_["colours"].push_back({colour.r, colour.g, colour.b, colour.a});
-    }
-
-    // Convert to a string ready for saving
-    auto json_dump = json_.dump();
+    bool is_binary = format_ == LevelFileFormat::Binary;
+    auto path = is_binary ? make_binary_level_path(level_name) : make_level_path(level_name);
 
     // All level files are saved to a a directory.
     // TODO: Sanitize the level name to ensure the directory is a valid filename across all
@@ -198,13 +508,65 @@ bool LevelFileIO::save(const std::string& level_name, bool save_uncompressed)
         std::filesystem::create_directories(directory);
     }
 
+    //=========================
+    //      Write the floors
+    // ========================
+    std::size_t size = 0;
+    if (is_binary)
+    {
+        auto write_binary = [&](const std::filesystem::path& temp_path)
+        {
+            std::ofstream binary_file(temp_path, std::ios::binary);
+            binary_file.write(binary_floors_.data(), binary_floors_.size());
+            binary_file.close();
+            return !binary_file.fail();
+        };
+        if (!write_file_atomically(path, write_binary))
+        {
+            return false;
+        }
+        size = binary_floors_.size();
+    }
+    else
+    {
+        // Add additional data to the compressed JSON prior to saving, the binary format holds its
+        // own colour table
+        write_colours();
+
+        // The save ID is stored with the floors rather than in the metafile, as the two files are
+        // replaced one after the other and the journal must only be replayed onto the floors it
+        // follows
+        json_["meta"] = {{"version", version_}, {"save_id", save_id_}};
+
+        // The JSON is written straight into the compressor rather than being dumped to a string
+        auto write_compressed = [&](const std::filesystem::path& temp_path)
+        {
+            DeflateStreamBuffer compressed_file(temp_path, compression_level_);
+            std::ostream stream(&compressed_file);
+            stream << json_;
+
+            // The last block is only counted once it has been compressed by "finish"
+            if (!compressed_file.finish())
+            {
+                return false;
+            }
+            size = compressed_file.get_uncompressed_size();
+            return true;
+        };
+        if (!write_file_atomically(path, write_compressed))
+        {
+            return false;
+        }
+    }
+
     //===========================
     //      Write the metadata
     // ==========================
     nlohmann::json meta;
     meta["level_name"] = level_name;
     meta["version"] = version_;
-    meta["size"] = json_dump.size();
+    meta["size"] = size;
+    meta["format"] = is_binary ? "binary" : "json";
     meta["saved_date"] = get_epoch();
 
     // Persistent data between saves
@@ -217,31 +579,89 @@ bool LevelFileIO::save(const std::string& level_name, bool save_uncompressed)
         meta["created_date"] = meta["saved_date"];
     }
 
-    std::ofstream meta_file(make_meta_path(level_name));
-    meta_file << meta;
-    json_["meta"] = meta;
+    // The metadata is replaced after the floors, such that it never refers to floors in a format
+    // that failed to save
+    auto write_meta = [&](const std::filesystem::path& temp_path)
+    {
+        std::ofstream meta_file(temp_path);
+        meta_file << meta;
+        meta_file.close();
+        return !meta_file.fail();
+    };
+    if (!write_file_atomically(make_meta_path(level_name), write_meta))
+    {
+        return false;
+    }
 
     //==================================
     //  Save to the uncompressed format
     // =================================
-    if (save_uncompressed)
+    if (save_uncompressed && !is_binary)
     {
-        std::ofstream basic_file(make_uncompressed_level_path(level_name.c_str()));
-        basic_file << json_;
+        json_["meta"].update(meta);
+        write_uncompressed(make_uncompressed_level_path(level_name));
+    }
+
+    std::println("Successfully saved to {}", path.string());
+    return true;
+}
+
+bool LevelFileIO::export_json(const std::string& level_name)
+{
+    auto path = make_uncompressed_level_path(level_name);
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+
+    // The export has no save ID, as it is not a save of the level that the journal follows
+    write_colours();
+    json_["meta"] = {
+        {"level_name", level_name},
+        {"version", version_},
+        {"saved_date", get_epoch()},
+    };
+    if (!write_uncompressed(path))
+    {
+        return false;
     }
 
-    //================================
-    //  Save to the compressed format
-    // ===============================
-    auto compressed = compress_data(json_dump);
-    if (compressed)
+    std::println("Successfully exported to {}", path.string());
+    return true;
+}
+
+void LevelFileIO::write_colours()
+{
+    json_["colours"] = {};
+    for (auto& colour : colours_)
     {
-        std::ofstream compressed_file(path.string(), std::ios::binary);
-        compressed_file << *compressed;
-        std::println("Successfully saved to {}", path.string());
-        return true;
+        json_["colours"].push_back({colour.r, colour.g, colour.b, colour.a});
     }
-    return false;
+}
+
+bool LevelFileIO::write_uncompressed(const std::filesystem::path& path) const
+{
+    auto write_json = [&](const std::filesystem::path& temp_path)
+    {
+        std::ofstream basic_file(temp_path);
+        basic_file << json_;
+        basic_file.close();
+        return !basic_file.fail();
+    };
+    return write_file_atomically(path, write_json);
+}
+
+void LevelFileIO::set_compression_level(int compression_level)
+{
+    compression_level_ = compression_level;
+}
+
+void LevelFileIO::set_save_id(std::uint64_t save_id)
+{
+    save_id_ = save_id;
+}
+
+std::uint64_t LevelFileIO::get_save_id() const
+{
+    return save_id_;
 }
 
 void LevelFileIO::serialise_texture(nlohmann::json& object, const TextureProp& prop)
@@ -286,11 +706,40 @@ int LevelFileIO::add_colour(glm::u8vec4 colour)
 void LevelFileIO::write_floors(const nlohmann::json& floors)
 {
     json_["floors"] = floors;
+    format_ = LevelFileFormat::Json;
 }
 
-nlohmann::json LevelFileIO::get_floors() const
+void LevelFileIO::write_floors_binary(std::string floors)
 {
-    return json_["floors"];
+    binary_floors_ = std::move(floors);
+    format_ = LevelFileFormat::Binary;
+}
+
+LevelFileFormat LevelFileIO::get_format() const
+{
+    return format_;
+}
+
+const LevelBinaryReader* LevelFileIO::get_binary_floors() const
+{
+    return binary_reader_ ? &*binary_reader_ : nullptr;
+}
+
+bool LevelFileIO::read_json_floors(const JsonFloorFunc& on_floor, const JsonObjectFunc& on_object)
+{
+    colours_.clear();
+    save_id_ = 0;
+    LevelJsonSax sax(colours_, version_, save_id_, on_floor, on_object);
+
+    if (!json_compressed_)
+    {
+        std::ifstream file(json_path_);
+        return file.is_open() && nlohmann::json::sax_parse(file, &sax);
+    }
+
+    InflateStreamBuffer buffer(json_path_);
+    std::istream stream(&buffer);
+    return buffer.is_open() && nlohmann::json::sax_parse(stream, &sax) && !buffer.has_error();
 }
 
 void LevelFileSelectGUI::show()
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <functional>
+
+#include "LevelBinaryFormat.h"
 #include "LevelObjects/LevelObjectTypes.h"
 #include <nlohmann/json.hpp>
 
@@ -14,23 +17,71 @@ bool level_file_exists(const std::string level_file_name);
 /// @brief  Checks if the given level file exists. Assumes the file is in the "levels" directory.
 bool level_file_exists(const std::filesystem::path level_file_name);
 
+/// The path of the journal of edits made to the level since it was last saved (See EditJournal)
+std::filesystem::path make_level_journal_path(const std::string& level_file_name);
+
+enum class LevelFileFormat
+{
+    /// Compressed JSON (.cly), used for exporting and moving levels between versions
+    Json,
+
+    /// Memory mapped binary (.clb), see LevelBinaryWriter for the layout
+    Binary,
+};
+
 /// Helper class for loading and saving editor level files.
 class LevelFileIO
 {
   public:
-    /// Opens the given file ready to be deserialised
+    /// Called with each floor number of a JSON level as it is read
+    using JsonFloorFunc = std::function<void(int floor_number)>;
+
+    /// Called with each object of a JSON level and the name of its type (See FloorManager), which
+    /// can return false to stop reading
+    using JsonObjectFunc = std::function<bool(int floor_number, const std::string& type,
+                                              const nlohmann::json& object)>;
+
+    /// Opens the given file ready to be deserialised. The level is opened in the format it was last
+    /// saved in, unless "load_uncompressed" is set which always loads the uncompressed JSON.
     bool open(const std::string& level_file_name, bool load_uncompressed);
 
-    /// Save the current serialised json to disk + metadata about the level. "write_floors" should
-    /// be called first.
+    /// Save the current serialised floors to disk + metadata about the level. "write_floors" or
+    /// "write_floors_binary" should be called first, which sets the format to save as.
+    /// Each file is written to a temporary file first which then replaces the existing file, such
+    /// that a failed save leaves the previously saved level intact.
     bool save(const std::string& level_file_name, bool save_uncompressed);
 
+    /// Writes the floors set by "write_floors" to the uncompressed JSON (.cly.json) only, as a copy
+    /// of the level for moving it between versions. The level's own files and metadata are left as
+    /// they are, so the level is still opened from the format it was saved in.
+    bool export_json(const std::string& level_file_name);
+
+    /// Sets the zlib compression level (1-9) of the compressed JSON, which is 6 by default
+    void set_compression_level(int compression_level);
+
+    /// Identifies each save of a level, such that the edit journal is only replayed onto the save
+    /// it was written for. The ID is saved with the floors, so for JSON levels is only known once
+    /// the floors have been read. Levels saved without an ID have the ID 0.
+    void set_save_id(std::uint64_t save_id);
+    std::uint64_t get_save_id() const;
+
     /// Writes the floors to the current json. This assumes floors is an array of floors and their
     /// objects (See FloorManager)
     void write_floors(const nlohmann::json& floors);
 
-    /// Gets the "floors" object from the json object.
-    nlohmann::json get_floors() const;
+    /// Sets the floors to be saved in the binary format (See FloorManager)
+    void write_floors_binary(std::string floors);
+
+    /// The format of the floors that were opened or written
+    LevelFileFormat get_format() const;
+
+    /// Gets the reader for the floors if the level was opened from the binary format
+    const LevelBinaryReader* get_binary_floors() const;
+
+    /// Streams the floors of the opened JSON level from the file. Each object is passed to
+    /// "on_object" as it is read, so neither the decompressed file nor the JSON document is ever
+    /// held in memory.
+    bool read_json_floors(const JsonFloorFunc& on_floor, const JsonObjectFunc& on_object);
 
     /// Write a TextureProp to the current JSON. This caches the colour if is a new one, otherwise
     /// it saves the index of a previously saved colour.
@@ -40,14 +91,31 @@ class LevelFileIO
     TextureProp deserialise_texture(const nlohmann::json& object) const;
 
   private:
+    /// Adds the colours the textures refer to (See serialise_texture) to the JSON
+    void write_colours();
+
+    /// Replaces the uncompressed JSON file at the path with the JSON
+    bool write_uncompressed(const std::filesystem::path& path) const;
+
     int find_colour_index(glm::u8vec4 colour) const;
     int add_colour(glm::u8vec4 colour);
 
     std::vector<glm::u8vec4> colours_;
 
     int version_ = 0;
+    std::uint64_t save_id_ = 0;
+
+    LevelFileFormat format_ = LevelFileFormat::Json;
+    int compression_level_ = 6;
 
     nlohmann::json json_;
+
+    /// The JSON level opened by "open", which is read by "read_json_floors"
+    std::filesystem::path json_path_;
+    bool json_compressed_ = true;
+
+    std::string binary_floors_;
+    std::optional<LevelBinaryReader> binary_reader_;
 };
 
 class LevelFileSelectGUI
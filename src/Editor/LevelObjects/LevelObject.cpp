@@ -157,15 +157,30 @@ std::string LevelObject::to_type_string() const
 
 LevelObjectsMesh3D LevelObject::to_geometry(int floor_number) const
 {
-    return std::visit([&](const auto& object) -> LevelObjectsMesh3D
-                      { return object_to_geometry(object, floor_number); }, object_type);
+    LevelObjectsMesh3D mesh;
+    to_geometry(floor_number, mesh);
+    return mesh;
+}
+
+void LevelObject::to_geometry(int floor_number, LevelObjectsMesh3D& mesh) const
+{
+    std::visit([&](const auto& object) { object_to_geometry(object, floor_number, mesh); },
+               object_type);
 }
 
 std::pair<Mesh2DWorld, gl::PrimitiveType>
 LevelObject::to_2d_geometry(const LevelTextures& drawing_pad_texture_map) const
 {
-    return std::visit([&](auto&& object)
-                      { return object_to_geometry_2d(object, drawing_pad_texture_map); },
+    Mesh2DWorld mesh;
+    auto primitive = to_2d_geometry(drawing_pad_texture_map, mesh);
+    return {std::move(mesh), primitive};
+}
+
+gl::PrimitiveType LevelObject::to_2d_geometry(const LevelTextures& drawing_pad_texture_map,
+                                              Mesh2DWorld& mesh) const
+{
+    return std::visit([&](const auto& object)
+                      { return object_to_geometry_2d(object, drawing_pad_texture_map, mesh); },
                       object_type);
 }
 
@@ -188,11 +203,50 @@ bool LevelObject::is_within(const Rectangle& selection_area)
                       object_type);
 }
 
+Rectangle LevelObject::get_bounds_2d() const
+{
+    return std::visit([&](const auto& object) { return object_get_bounds_2d(object); },
+                      object_type);
+}
+
 void LevelObject::move(glm::vec2 offset)
 {
     std::visit([&](auto&& object) { object_move(object, offset); }, object_type);
 }
 
+std::optional<glm::vec2> LevelObject::find_translation(const LevelObject& moved) const
+{
+    if (object_type.index() != moved.object_type.index())
+    {
+        return std::nullopt;
+    }
+
+    return std::visit(
+        [&](const auto& object) -> std::optional<glm::vec2>
+        {
+            using T = std::decay_t<decltype(object)>;
+            if constexpr (std::is_same_v<T, PolygonPlatformObject>)
+            {
+                return std::nullopt;
+            }
+            else
+            {
+                auto& other = std::get<T>(moved.object_type);
+                auto offset = object_get_position(other) - object_get_position(object);
+
+                auto translated = object;
+                object_move(translated, offset);
+                if (translated.properties != other.properties ||
+                    translated.parameters != other.parameters)
+                {
+                    return std::nullopt;
+                }
+                return offset;
+            }
+        },
+        object_type);
+}
+
 void LevelObject::rotate(glm::vec2 point)
 {
     float degrees = 90.0f;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <variant>
 
 #include <glad/glad.h>
@@ -54,10 +55,17 @@ struct LevelObject
     /// Converts the object to a 3D mesh for rendering.
     [[nodiscard]] LevelObjectsMesh3D to_geometry(int floor_number) const;
 
+    /// Replaces the geometry of the given mesh with the object's, reusing the mesh's buffers.
+    void to_geometry(int floor_number, LevelObjectsMesh3D& mesh) const;
+
     /// Converts the object to a 2D mesh for rendering.
     [[nodiscard]] std::pair<Mesh2DWorld, gl::PrimitiveType>
     to_2d_geometry(const LevelTextures& drawing_pad_texture_map) const;
 
+    /// Replaces the geometry of the given 2D mesh with the object's, reusing the mesh's buffers.
+    gl::PrimitiveType to_2d_geometry(const LevelTextures& drawing_pad_texture_map,
+                                     Mesh2DWorld& mesh) const;
+
     /// Converts the object to a string representation.
     [[nodiscard]] std::string to_string() const;
 
@@ -67,9 +75,19 @@ struct LevelObject
     /// Checks if the object is entirely within the given selection area.
     [[nodiscard]] bool is_within(const Rectangle& selection_area);
 
+    /// Gets the area covered by the object in the 2D view in world pixels. This includes any area
+    /// where try_select_2d could succeed.
+    [[nodiscard]] Rectangle get_bounds_2d() const;
+
     /// Moves the object by the given offset.
     void move(glm::vec2 offset);
 
+    /// If "moved" is this object moved using "move" with nothing else changed, returns the offset
+    /// it was moved by, such that its geometry can be translated rather than regenerated. Polygon
+    /// platforms always return nullopt as their textures are mapped in world space, so their
+    /// geometry changes by more than a translation.
+    [[nodiscard]] std::optional<glm::vec2> find_translation(const LevelObject& moved) const;
+
     /// Moves the object 90-degrees clockwise around the given point
     void rotate(glm::vec2 point);
 
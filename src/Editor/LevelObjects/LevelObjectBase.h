@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../Graphics/Mesh.h"
+#include "../../Graphics/MeshBuilder.h"
 
 class LevelTextures;
 
@@ -26,13 +27,40 @@ void object_rotate(T& object, glm::vec2 rotation_origin, float degrees);
 template <typename T>
 [[nodiscard]] glm::vec2 object_get_position(const T& object);
 
+template <typename T>
+[[nodiscard]] Rectangle object_get_bounds_2d(const T& object);
+
 template <typename T>
 [[nodiscard]] SerialiseResponse object_serialise(const T& object, LevelFileIO& level_file_io);
 
+/// Appends the 2D geometry of the object to the builder, returning the primitive to draw it with
+template <typename T>
+gl::PrimitiveType object_to_geometry_2d(const T& object,
+                                        const LevelTextures& drawing_pad_texture_map,
+                                        MeshBuilder<Vertex2DWorld>& builder);
+
+/// Appends the 3D geometry of the object to the builder
+template <typename T>
+void object_to_geometry(const T& object, int floor_number,
+                        MeshBuilder<VertexLevelObjects>& builder);
+
+/// Replaces the geometry of the mesh with the 2D geometry of the object, reusing its buffers
 template <typename T>
-[[nodiscard]] std::pair<Mesh2DWorld, gl::PrimitiveType>
-object_to_geometry_2d(const T& object, const LevelTextures& drawing_pad_texture_map);
+gl::PrimitiveType object_to_geometry_2d(const T& object,
+                                        const LevelTextures& drawing_pad_texture_map,
+                                        Mesh2DWorld& mesh)
+{
+    mesh.clear();
+    MeshBuilder builder(mesh);
+    return object_to_geometry_2d(object, drawing_pad_texture_map, builder);
+}
 
+/// Replaces the geometry of the mesh with the 3D geometry of the object, reusing its buffers
 template <typename T>
-[[nodiscard]] LevelObjectsMesh3D object_to_geometry(const T& object, int floor_number);
+void object_to_geometry(const T& object, int floor_number, LevelObjectsMesh3D& mesh)
+{
+    mesh.clear();
+    MeshBuilder builder(mesh);
+    object_to_geometry(object, floor_number, builder);
+}
 
@@ -76,6 +76,12 @@ template <>
     return pillar.parameters.position;
 }
 
+template <>
+[[nodiscard]] Rectangle object_get_bounds_2d(const PillarObject& pillar)
+{
+    return to_rectangle(pillar);
+}
+
 template <>
 SerialiseResponse object_serialise(const PillarObject& pillar, LevelFileIO& level_file_io)
 {
@@ -125,21 +131,23 @@ bool object_deserialise(PillarObject& pillar_object, const nlohmann::json& json,
 }
 
 template <>
-std::pair<Mesh2DWorld, gl::PrimitiveType>
-object_to_geometry_2d(const PillarObject& pillar, const LevelTextures& drawing_pad_texture_map)
+gl::PrimitiveType object_to_geometry_2d(const PillarObject& pillar,
+                                        const LevelTextures& drawing_pad_texture_map,
+                                        MeshBuilder<Vertex2DWorld>& builder)
 {
     // TODO: Angled pillars
     auto& props = pillar.properties;
     auto texture = static_cast<float>(*drawing_pad_texture_map.get_texture("Pillar"));
 
-    return {generate_2d_quad_mesh(pillar.parameters.position - (props.size * TILE_SIZE_F / 2.0f),
-                                  {props.size * TILE_SIZE_F, props.size * TILE_SIZE_F}, texture,
-                                  props.texture.id, props.texture.colour),
-            gl::PrimitiveType::Triangles};
+    generate_2d_quad_mesh(builder, pillar.parameters.position - (props.size * TILE_SIZE_F / 2.0f),
+                          {props.size * TILE_SIZE_F, props.size * TILE_SIZE_F}, texture,
+                          props.texture.id, props.texture.colour);
+    return gl::PrimitiveType::Triangles;
 }
 
 template <>
-LevelObjectsMesh3D object_to_geometry(const PillarObject& pillar, int floor_number)
+void object_to_geometry(const PillarObject& pillar, int floor_number,
+                        MeshBuilder<VertexLevelObjects>& builder)
 {
     const auto& params = pillar.parameters;
     const auto& props = pillar.properties;
@@ -157,8 +165,6 @@ LevelObjectsMesh3D object_to_geometry(const PillarObject& pillar, int floor_numb
     float o = size / 2;
     auto p = glm::vec3{params.position.x, 0, params.position.y} / TILE_SIZE_F;
 
-    LevelObjectsMesh3D mesh;
-
     auto min_x = p.x - o;
     auto max_x = p.x + o;
 
@@ -170,7 +176,8 @@ LevelObjectsMesh3D object_to_geometry(const PillarObject& pillar, int floor_numb
         // TODO, work out the mesh layout for angled pillars
     }
 
-    mesh.vertices = {
+    builder.reserve(24, 36);
+    builder.add_vertices({
         {{max_x, h, max_z}, {size, h, texture}, {0.0f, 0.0f, 1.0f}, colour},
         {{min_x, h, max_z}, {0.0f, h, texture}, {0.0f, 0.0f, 1.0f}, colour},
         {{min_x, ob, max_z}, {0.0f, ob, texture}, {0.0f, 0.0f, 1.0f}, colour},
@@ -200,20 +207,11 @@ LevelObjectsMesh3D object_to_geometry(const PillarObject& pillar, int floor_numb
         {{max_x, ob, min_z}, {0.0f, 0, texture}, {0.0f, -1.0f, 0.0f}, colour},
         {{max_x, ob, max_z}, {0.0f, size, texture}, {0.0f, -1.0f, 0.0f}, colour},
         {{min_x, ob, max_z}, {size, size, texture}, {0.0f, -1.0f, 0.0f}, colour},
-    };
+    });
 
-    int index = 0;
-    for (int i = 0; i < 6; i++)
+    for (GLuint face = 0; face < 6; face++)
     {
-        mesh.indices.push_back(index);
-        mesh.indices.push_back(index + 1);
-        mesh.indices.push_back(index + 2);
-        mesh.indices.push_back(index + 2);
-        mesh.indices.push_back(index + 3);
-        mesh.indices.push_back(index);
-        index += 4;
+        builder.add_quad_indices(face * 4);
     }
-
-    return mesh;
     // clang-format on
 }
@@ -18,6 +18,8 @@ enum class PillarStyle
 struct PillarParameters
 {
     glm::vec2 position{0};
+
+    bool operator==(const PillarParameters& other) const = default;
 };
 
 struct PillarProps
@@ -66,10 +68,11 @@ template <>
                                                                LevelFileIO& level_file_io);
 
 template <>
-[[nodiscard]] std::pair<Mesh2DWorld, gl::PrimitiveType>
+gl::PrimitiveType
 object_to_geometry_2d<PillarObject>(const PillarObject& pillar,
-                                    const LevelTextures& drawing_pad_texture_map);
+                                    const LevelTextures& drawing_pad_texture_map,
+                                    MeshBuilder<Vertex2DWorld>& builder);
 
 template <>
-[[nodiscard]] LevelObjectsMesh3D object_to_geometry<PillarObject>(const PillarObject& pillar,
-                                                                  int floor_number);
+void object_to_geometry<PillarObject>(const PillarObject& pillar, int floor_number,
+                                      MeshBuilder<VertexLevelObjects>& builder);
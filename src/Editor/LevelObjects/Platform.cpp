@@ -114,6 +114,12 @@ template <>
     return platform.parameters.position;
 }
 
+template <>
+[[nodiscard]] Rectangle object_get_bounds_2d(const PlatformObject& platform)
+{
+    return object_to_rectangle(platform);
+}
+
 template <>
 SerialiseResponse object_serialise(const PlatformObject& platform, LevelFileIO& level_file_io)
 {
@@ -163,8 +169,9 @@ bool object_deserialise(PlatformObject& platform, const nlohmann::json& json,
 }
 
 template <>
-std::pair<Mesh2DWorld, gl::PrimitiveType>
-object_to_geometry_2d(const PlatformObject& platform, const LevelTextures& drawing_pad_texture_map)
+gl::PrimitiveType object_to_geometry_2d(const PlatformObject& platform,
+                                        const LevelTextures& drawing_pad_texture_map,
+                                        MeshBuilder<Vertex2DWorld>& builder)
 {
     auto& params = platform.parameters;
     auto& props = platform.properties;
@@ -175,27 +182,28 @@ object_to_geometry_2d(const PlatformObject& platform, const LevelTextures& drawi
     switch (props.style)
     {
         case PlatformStyle::Triangle:
-            return {generate_2d_triangle_mesh(params.position, size, texture, texture_top_f,
-                                              props.texture_top.colour, props.direction),
-                    gl::PrimitiveType::Triangles};
+            generate_2d_triangle_mesh(builder, params.position, size, texture, texture_top_f,
+                                      props.texture_top.colour, props.direction);
+            break;
 
         case PlatformStyle::Diamond:
-            return {generate_2d_diamond_mesh(params.position, size, texture, texture_top_f,
-                                             props.texture_top.colour, Direction::Forward),
-                    gl::PrimitiveType::Triangles};
+            generate_2d_diamond_mesh(builder, params.position, size, texture, texture_top_f,
+                                     props.texture_top.colour, Direction::Forward);
+            break;
 
         // Default to quad
         default:
-            return {generate_2d_quad_mesh(params.position, size, texture, texture_top_f,
-                                          props.texture_top.colour, Direction::Forward),
-                    gl::PrimitiveType::Triangles};
+            generate_2d_quad_mesh(builder, params.position, size, texture, texture_top_f,
+                                  props.texture_top.colour, Direction::Forward);
+            break;
     }
+    return gl::PrimitiveType::Triangles;
 }
 
 namespace
 {
-    std::vector<VertexLevelObjects> create_quad_platform_vertices(const PlatformObject& platform,
-                                                                  float ob)
+    void add_quad_platform_vertices(MeshBuilder<VertexLevelObjects>& builder,
+                                    const PlatformObject& platform, float ob)
     {
         const auto& params = platform.parameters;
         const auto& props = platform.properties;
@@ -210,7 +218,7 @@ namespace
 
         auto p = glm::vec3{params.position.x, 0, params.position.y} / TILE_SIZE_F;
         // clang-format off
-        return {
+        builder.add_vertices({
             // Top
             {{p.x,          ob, p.z,        },  {0,     0,      texture_top},    {0, 1, 0}, colour_top},
             {{p.x,          ob, p.z + depth,},  {0,     depth,  texture_top},    {0, 1, 0}, colour_top},
@@ -222,12 +230,12 @@ namespace
             {{p.x,          ob, p.z + depth,},  {0,     depth,  texture_bottom},   {0, -1, 0}, colour_bottom},
             {{p.x + width,  ob, p.z + depth,},  {width, depth,  texture_bottom},   {0, -1, 0}, colour_bottom},
             {{p.x + width,  ob, p.z,        },  {width, 0,      texture_bottom},   {0, -1, 0}, colour_bottom},
-        };
+        });
         // clang-format on
     }
 
-    std::vector<VertexLevelObjects> create_diamond_platform_vertices(const PlatformObject& platform,
-                                                                     float ob)
+    void add_diamond_platform_vertices(MeshBuilder<VertexLevelObjects>& builder,
+                                       const PlatformObject& platform, float ob)
     {
         const auto& params = platform.parameters;
         const auto& props = platform.properties;
@@ -243,7 +251,7 @@ namespace
         auto p = glm::vec3{params.position.x, 0, params.position.y} / TILE_SIZE_F;
 
         // clang-format off
-        return {
+        builder.add_vertices({
             // Top
             {{p.x + width,     ob, p.z + depth / 2}, {width,     depth / 2, texture_top}, {0, 1, 0}, colour_top},
             {{p.x + width / 2, ob, p.z            }, {width / 2, 0,         texture_top}, {0, 1, 0}, colour_top},
@@ -255,12 +263,12 @@ namespace
             {{p.x + width / 2, ob, p.z            }, {width / 2, 0,         texture_bottom}, {0, -1, 0}, colour_bottom}, 
             {{p.x,             ob, p.z + depth / 2}, {0,         depth / 2, texture_bottom}, {0, -1, 0}, colour_bottom}, 
             {{p.x + width / 2, ob, p.z + depth    }, {width / 2, depth,     texture_bottom}, {0, -1, 0}, colour_bottom}, 
-        };
+        });
         // clang-format on
     }
 
-    std::vector<VertexLevelObjects>
-    create_triangle_platform_vertices(const PlatformObject& platform, float ob)
+    void add_triangle_platform_vertices(MeshBuilder<VertexLevelObjects>& builder,
+                                        const PlatformObject& platform, float ob)
     {
         const auto& params = platform.parameters;
         const auto& props = platform.properties;
@@ -288,7 +296,7 @@ namespace
         // Calculate the UVs using planar mapping to avoid stretching
         auto make_uv = [&](const glm::vec3& pos, float texture)
         { return glm::vec3{std::abs(pos.x - p.x), std::abs(pos.z - p.z), texture}; };
-        return {
+        builder.add_vertices({
             // Top
             {v[0], make_uv(v[0], texture_top), {0, 1, 0}, colour_top},
             {v[1], make_uv(v[1], texture_top), {0, 1, 0}, colour_top},
@@ -297,49 +305,49 @@ namespace
             {v[0], make_uv(v[0], texture_bottom), {0, -1, 0}, colour_bottom},
             {v[1], make_uv(v[1], texture_bottom), {0, -1, 0}, colour_bottom},
             {v[2], make_uv(v[2], texture_bottom), {0, -1, 0}, colour_bottom},
-        };
+        });
         // clang-format on
     }
 } // namespace
 
 template <>
-LevelObjectsMesh3D object_to_geometry(const PlatformObject& platform, int floor_number)
+void object_to_geometry(const PlatformObject& platform, int floor_number,
+                        MeshBuilder<VertexLevelObjects>& builder)
 {
     const auto& props = platform.properties;
 
     // Offset platform heights by a hair to prevent Z-fighting with PolygonPlatforms which can go
-    // underneath
-    float ob = props.base * FLOOR_HEIGHT + floor_number * FLOOR_HEIGHT + 0.00025f;
-    LevelObjectsMesh3D mesh;
-    mesh.vertices = [&]()
+    // underneath. This must not be lost when the position is packed for the GPU (See
+    // pack_position), which keeps at least 1/128 of a tile of precision within the world
+    float ob = props.base * FLOOR_HEIGHT + floor_number * FLOOR_HEIGHT + 1.0f / 128.0f;
+    builder.reserve(8, 12);
+    switch (props.style)
     {
-        switch (props.style)
-        {
-            case PlatformStyle::Triangle:
-                return create_triangle_platform_vertices(platform, ob);
+        case PlatformStyle::Triangle:
+            add_triangle_platform_vertices(builder, platform, ob);
+            break;
 
-            case PlatformStyle::Quad:
-                return create_quad_platform_vertices(platform, ob);
+        case PlatformStyle::Quad:
+            add_quad_platform_vertices(builder, platform, ob);
+            break;
 
-            case PlatformStyle::Diamond:
-                return create_diamond_platform_vertices(platform, ob);
-        }
-        return std::vector<VertexLevelObjects>{};
-    }();
+        case PlatformStyle::Diamond:
+            add_diamond_platform_vertices(builder, platform, ob);
+            break;
+    }
 
     if (props.style == PlatformStyle::Triangle)
     {
-        mesh.indices = {// Front
-                        0, 1, 2,
-                        // Back
-                        5, 4, 3};
+        builder.add_indices({// Front
+                             0, 1, 2,
+                             // Back
+                             5, 4, 3});
     }
     else
     {
-        mesh.indices = {// Front
-                        0, 1, 2, 2, 3, 0,
-                        // Back
-                        6, 5, 4, 4, 7, 6};
+        builder.add_indices({// Front
+                             0, 1, 2, 2, 3, 0,
+                             // Back
+                             6, 5, 4, 4, 7, 6});
     }
-    return mesh;
 }
@@ -9,6 +9,8 @@
 struct PlatformParameters
 {
     glm::vec2 position{0};
+
+    bool operator==(const PlatformParameters& other) const = default;
 };
 
 enum class PlatformStyle
@@ -64,9 +66,10 @@ template <>
 [[nodiscard]] SerialiseResponse object_serialise<PlatformObject>(const PlatformObject& platform,
                                                                  LevelFileIO& level_file_io);
 template <>
-[[nodiscard]] std::pair<Mesh2DWorld, gl::PrimitiveType>
+gl::PrimitiveType
 object_to_geometry_2d<PlatformObject>(const PlatformObject& platform,
-                                      const LevelTextures& drawing_pad_texture_map);
+                                      const LevelTextures& drawing_pad_texture_map,
+                                      MeshBuilder<Vertex2DWorld>& builder);
 template <>
-[[nodiscard]] LevelObjectsMesh3D object_to_geometry<PlatformObject>(const PlatformObject& platform,
-                                                                    int floor_number);
+void object_to_geometry<PlatformObject>(const PlatformObject& platform, int floor_number,
+                                        MeshBuilder<VertexLevelObjects>& builder);
@@ -1,7 +1,5 @@
 #include "PolygonPlatform.h"
 
-#include <earcut/earcut.hpp>
-
 #include "../../Graphics/MeshGeneration.h"
 #include "../../Util/Maths.h"
 #include "../../Util/Util.h"
@@ -95,6 +93,21 @@ template <>
     return poly.parameters.position;
 }
 
+template <>
+[[nodiscard]] Rectangle object_get_bounds_2d(const PolygonPlatformObject& poly)
+{
+    // Holes are always within the outer points, so only the outer points are needed
+    const auto& points = poly.properties.geometry[0];
+    glm::vec2 min = points[0];
+    glm::vec2 max = points[0];
+    for (auto& point : points)
+    {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+    return {.position = poly.parameters.position + min, .size = max - min};
+}
+
 template <>
 SerialiseResponse object_serialise(const PolygonPlatformObject& poly, LevelFileIO& level_file_io)
 {
@@ -189,10 +202,23 @@ bool object_deserialise(PolygonPlatformObject& poly, const nlohmann::json& json,
     return true;
 }
 
+namespace
+{
+    size_t count_points(const PolygonGeometry& geometry)
+    {
+        size_t count = 0;
+        for (auto& point_array : geometry)
+        {
+            count += point_array.size();
+        }
+        return count;
+    }
+} // namespace
+
 template <>
-std::pair<Mesh2DWorld, gl::PrimitiveType>
-object_to_geometry_2d(const PolygonPlatformObject& poly,
-                      const LevelTextures& drawing_pad_texture_map)
+gl::PrimitiveType object_to_geometry_2d(const PolygonPlatformObject& poly,
+                                        const LevelTextures& drawing_pad_texture_map,
+                                        MeshBuilder<Vertex2DWorld>& builder)
 {
     auto base_texture = static_cast<float>(*drawing_pad_texture_map.get_texture("PolygonPlatform"));
     const auto& params = poly.parameters;
@@ -202,8 +228,8 @@ object_to_geometry_2d(const PolygonPlatformObject& poly,
     auto texture_top = static_cast<float>(props.texture_top.id);
     auto colour_top = props.texture_top.colour;
 
-    Mesh2DWorld mesh;
-    auto earcut_indices = mapbox::earcut<>(props.geometry);
+    auto triangles = triangulate_polygon(props.geometry);
+    builder.reserve(count_points(props.geometry), triangles->size());
 
     // Top face
     for (auto& point_array : props.geometry)
@@ -212,20 +238,20 @@ object_to_geometry_2d(const PolygonPlatformObject& poly,
         {
             glm::vec2 world_pos{point.x + position.x, point.y + position.y};
             glm::vec2 tex_coords = world_pos / TILE_SIZE_F;
-            mesh.vertices.push_back({world_pos,
-                                     {tex_coords.x, tex_coords.y, base_texture},
-                                     {tex_coords.x, tex_coords.y, texture_top},
-                                     colour_top});
+            builder.add_vertex({world_pos,
+                                {tex_coords.x, tex_coords.y, base_texture},
+                                {tex_coords.x, tex_coords.y, texture_top},
+                                colour_top});
         }
     }
 
     // The indices vector is given in clockwise order, so must be reversed to get anti-clockwise
     // ordering for the top face.
-    for (auto i = earcut_indices.rbegin(); i != earcut_indices.rend(); ++i)
+    for (auto i = triangles->rbegin(); i != triangles->rend(); ++i)
     {
-        mesh.indices.push_back(*i);
+        builder.add_index(*i);
     }
-    return std::make_pair(std::move(mesh), gl::PrimitiveType::Triangles);
+    return gl::PrimitiveType::Triangles;
 }
 
 Mesh2DWorld object_to_outline_2d(const PolygonPlatformObject& poly)
@@ -259,14 +285,15 @@ Mesh2DWorld object_to_outline_2d(const PolygonPlatformObject& poly)
 }
 
 template <>
-LevelObjectsMesh3D object_to_geometry(const PolygonPlatformObject& poly, int floor_number)
+void object_to_geometry(const PolygonPlatformObject& poly, int floor_number,
+                        MeshBuilder<VertexLevelObjects>& builder)
 {
     const auto& params = poly.parameters;
     const auto& props = poly.properties;
 
     if (!props.visible)
     {
-        return LevelObjectsMesh3D{};
+        return;
     }
 
     auto ob = props.base * FLOOR_HEIGHT + floor_number * FLOOR_HEIGHT;
@@ -277,11 +304,12 @@ LevelObjectsMesh3D object_to_geometry(const PolygonPlatformObject& poly, int flo
     auto colour_top = props.texture_top.colour;
 
     auto p = glm::vec3{params.position.x / TILE_SIZE_F, 0, params.position.y / TILE_SIZE_F};
-    LevelObjectsMesh3D mesh;
 
     // Mapbox's Earcut triangulates the polygon's points and holes which gets a list of INDICES
-    // within all of of the "props.points" vectors.
-    auto earcut_indices = mapbox::earcut<>(props.geometry);
+    // within all of of the "props.points" vectors. The triangles are shared with the 2D geometry.
+    auto triangles = triangulate_polygon(props.geometry);
+    auto point_count = static_cast<GLuint>(count_points(props.geometry));
+    builder.reserve(point_count * 2, triangles->size() * 2);
 
     // Top face
     for (auto& point_array : props.geometry)
@@ -289,15 +317,15 @@ LevelObjectsMesh3D object_to_geometry(const PolygonPlatformObject& poly, int flo
         for (auto& point : point_array)
         {
             glm::vec3 pos = {point.x / TILE_SIZE_F + p.x, ob, point.y / TILE_SIZE_F + p.z};
-            mesh.vertices.push_back({pos, {pos.x, pos.z, texture_top}, {0, 1, 0}, colour_top});
+            builder.add_vertex({pos, {pos.x, pos.z, texture_top}, {0, 1, 0}, colour_top});
         }
     }
 
     // The indices vector is given in clockwise order, so must be reversed to get anti-clockwise
     // ordering for the top face.
-    for (auto i = earcut_indices.rbegin(); i != earcut_indices.rend(); ++i)
+    for (auto i = triangles->rbegin(); i != triangles->rend(); ++i)
     {
-        mesh.indices.push_back(*i);
+        builder.add_index(*i);
     }
 
     // Bottom face
@@ -306,23 +334,13 @@ LevelObjectsMesh3D object_to_geometry(const PolygonPlatformObject& poly, int flo
         for (auto& point : point_array)
         {
             glm::vec3 pos = {point.x / TILE_SIZE_F + p.x, ob, point.y / TILE_SIZE_F + p.z};
-            mesh.vertices.push_back(
-                {pos, {pos.x, pos.z, texture_bottom}, {0, 1, 0}, colour_bottom});
+            builder.add_vertex({pos, {pos.x, pos.z, texture_bottom}, {0, 1, 0}, colour_bottom});
         }
     }
 
-    for (auto& point_array : props.geometry)
+    // The bottom face's vertices follow on from the top face's
+    for (auto i : *triangles)
     {
-        for (auto& point : point_array)
-        {
-            glm::vec3 pos = {point.x / TILE_SIZE_F + p.x, ob, point.y / TILE_SIZE_F + p.z};
-        }
+        builder.add_index(i + point_count);
     }
-
-    auto max_index = *std::max_element(mesh.indices.cbegin(), mesh.indices.cend());
-    for (auto& i : earcut_indices)
-    {
-        mesh.indices.push_back(i + max_index + 1);
-    }
-    return mesh;
 }
@@ -3,6 +3,7 @@
 #include "../EditConstants.h"
 #include "LevelObjectBase.h"
 #include "LevelObjectTypes.h"
+#include "PolygonTriangulation.h"
 
 // =======================================
 //      Platform Object Types
@@ -10,6 +11,8 @@
 struct PolygonPlatformParameters
 {
     glm::vec2 position{0.0f};
+
+    bool operator==(const PolygonPlatformParameters& other) const = default;
 };
 
 struct PolygonPlatformProps
@@ -18,7 +21,7 @@ struct PolygonPlatformProps
 
     // Double vector for mapbox earcut, the first vector are the points around the polygon edge,
     // following vectors are holes within the polygon
-    std::vector<std::vector<glm::vec2>> geometry = {{
+    PolygonGeometry geometry = {{
         glm::vec2{0},
         glm::vec2{0, DEFAULT_SIZE},
         glm::vec2{DEFAULT_SIZE, DEFAULT_SIZE},
@@ -69,12 +72,13 @@ object_serialise<PolygonPlatformObject>(const PolygonPlatformObject& poly,
                                         LevelFileIO& level_file_io);
 
 template <>
-[[nodiscard]] std::pair<Mesh2DWorld, gl::PrimitiveType>
+gl::PrimitiveType
 object_to_geometry_2d<PolygonPlatformObject>(const PolygonPlatformObject& poly,
-                                             const LevelTextures& drawing_pad_texture_map);
+                                             const LevelTextures& drawing_pad_texture_map,
+                                             MeshBuilder<Vertex2DWorld>& builder);
 
 [[nodiscard]] Mesh2DWorld object_to_outline_2d(const PolygonPlatformObject& poly);
 
 template <>
-[[nodiscard]] LevelObjectsMesh3D
-object_to_geometry<PolygonPlatformObject>(const PolygonPlatformObject& poly, int floor_number);
+void object_to_geometry<PolygonPlatformObject>(const PolygonPlatformObject& poly, int floor_number,
+                                               MeshBuilder<VertexLevelObjects>& builder);
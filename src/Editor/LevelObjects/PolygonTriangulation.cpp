@@ -0,0 +1,285 @@
+#include "PolygonTriangulation.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "../../Util/Maths.h"
+#include "../../Util/Util.h"
+
+namespace
+{
+    /// Polygons large enough to be slow to triangulate are also large to store, so only a small
+    /// number of recent polygons are kept
+    constexpr size_t MAX_CACHED_POLYGONS = 64;
+
+    struct CachedTriangulation
+    {
+        size_t hash = 0;
+        PolygonGeometry geometry;
+        PolygonTriangles triangles;
+    };
+
+    /// Recently used polygons, most recent at the front
+    std::list<CachedTriangulation> recent_polygons;
+    std::unordered_map<size_t, std::list<CachedTriangulation>::iterator> polygons_by_hash;
+    std::mutex cache_mutex;
+
+    size_t hash_geometry(const PolygonGeometry& geometry)
+    {
+        size_t seed = geometry.size();
+        auto combine = [&](auto value)
+        { seed ^= std::hash<decltype(value)>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2); };
+
+        for (auto& point_array : geometry)
+        {
+            combine(point_array.size());
+            for (auto& point : point_array)
+            {
+                combine(point.x);
+                combine(point.y);
+            }
+        }
+        return seed;
+    }
+
+    /// If "geometry" has the same layout as "previous" with exactly one point moved, returns the
+    /// index of that point across all of the point arrays (as used by the triangle indices)
+    std::optional<GLuint> find_single_moved_point(const PolygonGeometry& previous,
+                                                  const PolygonGeometry& geometry)
+    {
+        if (previous.size() != geometry.size())
+        {
+            return std::nullopt;
+        }
+
+        std::optional<GLuint> moved;
+        GLuint index = 0;
+        for (size_t i = 0; i < geometry.size(); i++)
+        {
+            if (previous[i].size() != geometry[i].size())
+            {
+                return std::nullopt;
+            }
+
+            for (size_t j = 0; j < geometry[i].size(); j++, index++)
+            {
+                if (previous[i][j] != geometry[i][j])
+                {
+                    if (moved)
+                    {
+                        return std::nullopt;
+                    }
+                    moved = index;
+                }
+            }
+        }
+        return moved;
+    }
+
+    std::vector<glm::vec2> flatten(const PolygonGeometry& geometry)
+    {
+        std::vector<glm::vec2> points;
+        for (auto& point_array : geometry)
+        {
+            points.insert(points.end(), point_array.begin(), point_array.end());
+        }
+        return points;
+    }
+
+    float signed_area(const glm::vec2& a, const glm::vec2& b, const glm::vec2& c)
+    {
+        return (b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y);
+    }
+
+    /// Whether the segments a-b and c-d cross or touch, including when they are collinear and
+    /// overlap
+    bool segments_intersect(const glm::vec2& a, const glm::vec2& b, const glm::vec2& c,
+                            const glm::vec2& d)
+    {
+        auto side_a = signed_area(c, d, a);
+        auto side_b = signed_area(c, d, b);
+        auto side_c = signed_area(a, b, c);
+        auto side_d = signed_area(a, b, d);
+        if (((side_a > 0 && side_b < 0) || (side_a < 0 && side_b > 0)) &&
+            ((side_c > 0 && side_d < 0) || (side_c < 0 && side_d > 0)))
+        {
+            return true;
+        }
+
+        // Point "p" is known to be on the line through "start" and "end", so only need to check
+        // it is within their bounds
+        auto on_segment = [](const glm::vec2& start, const glm::vec2& end, const glm::vec2& p)
+        {
+            return p.x >= std::min(start.x, end.x) && p.x <= std::max(start.x, end.x) &&
+                   p.y >= std::min(start.y, end.y) && p.y <= std::max(start.y, end.y);
+        };
+        return (side_a == 0 && on_segment(c, d, a)) || (side_b == 0 && on_segment(c, d, b)) ||
+               (side_c == 0 && on_segment(a, b, c)) || (side_d == 0 && on_segment(a, b, d));
+    }
+
+    /// The triangles stay a valid triangulation after a point is moved as long as:
+    ///  - Every triangle using the point keeps its winding, as a flipped triangle would overlap its
+    ///    neighbours
+    ///  - No edge from the moved point crosses an edge of the outline or holes, which happens when
+    ///    the point is dragged across another part of the polygon
+    ///  - No other point is within the triangles using the moved point, which happens when a
+    ///    triangle is stretched over a hole
+    ///  - The point has not left the outline or moved into a hole
+    bool can_reuse_triangles(const std::vector<GLuint>& triangles, const PolygonGeometry& previous,
+                             const PolygonGeometry& geometry, GLuint moved_point)
+    {
+        auto previous_points = flatten(previous);
+        auto points = flatten(geometry);
+
+        // The edges of the outline and holes as pairs of point indices
+        std::vector<std::pair<GLuint, GLuint>> edges;
+        edges.reserve(points.size());
+        size_t moved_ring = 0;
+        GLuint ring_start = 0;
+        for (size_t i = 0; i < geometry.size(); i++)
+        {
+            auto ring_size = static_cast<GLuint>(geometry[i].size());
+            for (GLuint j = 0; j < ring_size; j++)
+            {
+                edges.emplace_back(ring_start + j, ring_start + (j + 1) % ring_size);
+            }
+            if (moved_point >= ring_start && moved_point < ring_start + ring_size)
+            {
+                moved_ring = i;
+            }
+            ring_start += ring_size;
+        }
+
+        auto& point = points[moved_point];
+        auto crosses_edge = [&](GLuint other)
+        {
+            for (auto [start, end] : edges)
+            {
+                // Edges sharing a point with the moved edge always meet at that point
+                if (start != moved_point && end != moved_point && start != other && end != other &&
+                    segments_intersect(point, points[other], points[start], points[end]))
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        // The edges either side of the moved point, which are not part of any triangle when earcut
+        // has skipped the point for being collinear
+        for (auto [start, end] : edges)
+        {
+            if ((start == moved_point && crosses_edge(end)) ||
+                (end == moved_point && crosses_edge(start)))
+            {
+                return false;
+            }
+        }
+        for (size_t i = 0; i < geometry.size(); i++)
+        {
+            // The outline must contain the point, and the holes must not
+            if (i != moved_ring && point_in_polygon(point, geometry[i]) != (i == 0))
+            {
+                return false;
+            }
+        }
+
+        // A point that earcut skipped needs new triangles once moved off of its line
+        bool is_point_used = false;
+        for (size_t i = 0; i + 2 < triangles.size(); i += 3)
+        {
+            std::array<GLuint, 3> triangle{triangles[i], triangles[i + 1], triangles[i + 2]};
+            if (std::ranges::find(triangle, moved_point) == triangle.end())
+            {
+                continue;
+            }
+            is_point_used = true;
+
+            auto& a = points[triangle[0]];
+            auto& b = points[triangle[1]];
+            auto& c = points[triangle[2]];
+            auto before = signed_area(previous_points[triangle[0]], previous_points[triangle[1]],
+                                      previous_points[triangle[2]]);
+            auto after = signed_area(a, b, c);
+            if (before == 0 || after == 0 || (before < 0) != (after < 0))
+            {
+                return false;
+            }
+
+            for (auto other : triangle)
+            {
+                if (other != moved_point && crosses_edge(other))
+                {
+                    return false;
+                }
+            }
+
+            for (GLuint j = 0; j < points.size(); j++)
+            {
+                if (std::ranges::find(triangle, j) == triangle.end() &&
+                    point_in_triangle(points[j], {a, b, c}))
+                {
+                    return false;
+                }
+            }
+        }
+        return is_point_used;
+    }
+
+    void add_to_cache(size_t hash, const PolygonGeometry& geometry, PolygonTriangles triangles)
+    {
+        if (auto itr = polygons_by_hash.find(hash); itr != polygons_by_hash.end())
+        {
+            recent_polygons.erase(itr->second);
+            polygons_by_hash.erase(itr);
+        }
+        else if (recent_polygons.size() >= MAX_CACHED_POLYGONS)
+        {
+            polygons_by_hash.erase(recent_polygons.back().hash);
+            recent_polygons.pop_back();
+        }
+
+        recent_polygons.push_front({hash, geometry, std::move(triangles)});
+        polygons_by_hash[hash] = recent_polygons.begin();
+    }
+} // namespace
+
+PolygonTriangles triangulate_polygon(const PolygonGeometry& geometry)
+{
+    auto hash = hash_geometry(geometry);
+    {
+        std::lock_guard lock(cache_mutex);
+        if (auto itr = polygons_by_hash.find(hash);
+            itr != polygons_by_hash.end() && itr->second->geometry == geometry)
+        {
+            recent_polygons.splice(recent_polygons.begin(), recent_polygons, itr->second);
+            return itr->second->triangles;
+        }
+
+        // Dragging a vertex only moves a single point, so the triangles of the polygon before the
+        // move can often be used as-is
+        for (auto& cached : recent_polygons)
+        {
+            auto moved_point = find_single_moved_point(cached.geometry, geometry);
+            if (moved_point &&
+                can_reuse_triangles(*cached.triangles, cached.geometry, geometry, *moved_point))
+            {
+                auto triangles = cached.triangles;
+                add_to_cache(hash, geometry, triangles);
+                return triangles;
+            }
+        }
+    }
+
+    // Earcut is run outside of the lock so polygons can be triangulated in parallel when loading
+    auto triangles = std::make_shared<const std::vector<GLuint>>(mapbox::earcut<GLuint>(geometry));
+
+    std::lock_guard lock(cache_mutex);
+    add_to_cache(hash, geometry, triangles);
+    return triangles;
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+/// The points of a polygon as used by mapbox earcut: the first vector is the outline of the
+/// polygon, and the following vectors are holes within it.
+using PolygonGeometry = std::vector<std::vector<glm::vec2>>;
+
+/// Triangles of a polygon as indices into its points, in the (clockwise) order given by earcut.
+using PolygonTriangles = std::shared_ptr<const std::vector<GLuint>>;
+
+/**
+ * @brief Triangulates the polygon using mapbox earcut, reusing the triangles of recent calls.
+ *
+ * Results are cached by the polygon's points, so the 2D and 3D geometry of a polygon platform
+ * share a triangulation. When the polygon is a recently triangulated polygon with a single point
+ * moved (eg when dragging a vertex), the triangles of that polygon are reused as long as the move
+ * does not flip or collapse a triangle, cross another edge, or cover a hole, avoiding re-running
+ * earcut.
+ *
+ * Safe to call from multiple threads.
+ */
+[[nodiscard]] PolygonTriangles triangulate_polygon(const PolygonGeometry& geometry);
\ No newline at end of file
@@ -129,6 +129,12 @@ template <>
     return ramp.parameters.position;
 }
 
+template <>
+[[nodiscard]] Rectangle object_get_bounds_2d(const RampObject& ramp)
+{
+    return object_to_rectangle(ramp);
+}
+
 template <>
 SerialiseResponse object_serialise(const RampObject& ramp, LevelFileIO& level_file_io)
 {
@@ -179,8 +185,9 @@ bool object_deserialise(RampObject& ramp, const nlohmann::json& json,
 }
 
 template <>
-std::pair<Mesh2DWorld, gl::PrimitiveType>
-object_to_geometry_2d(const RampObject& ramp, const LevelTextures& drawing_pad_texture_map)
+gl::PrimitiveType object_to_geometry_2d(const RampObject& ramp,
+                                        const LevelTextures& drawing_pad_texture_map,
+                                        MeshBuilder<Vertex2DWorld>& builder)
 {
     auto& params = ramp.parameters;
     auto& props = ramp.properties;
@@ -190,15 +197,16 @@ object_to_geometry_2d(const RampObject& ramp, const LevelTextures& drawing_pad_t
     if (is_tri_ramp(props.style))
     {
         glm::vec2 size = props.size * TILE_SIZE_F;
-        return {generate_2d_triangle_mesh(params.position, size, texture, texture_top_f,
-                                          props.texture_top.colour,
-                                          to_actual_tri_ramp_direction(props.style)),
-                gl::PrimitiveType::Triangles};
+        generate_2d_triangle_mesh(builder, params.position, size, texture, texture_top_f,
+                                  props.texture_top.colour,
+                                  to_actual_tri_ramp_direction(props.style));
     }
-
-    return {generate_2d_quad_mesh(ramp.parameters.position, props.size * TILE_SIZE_F, texture,
-                                  texture_top_f, props.texture_top.colour, props.direction),
-            gl::PrimitiveType::Triangles};
+    else
+    {
+        generate_2d_quad_mesh(builder, ramp.parameters.position, props.size * TILE_SIZE_F, texture,
+                              texture_top_f, props.texture_top.colour, props.direction);
+    }
+    return gl::PrimitiveType::Triangles;
 }
 
 namespace
@@ -290,9 +298,9 @@ namespace
         return std::make_tuple(uv_a, uv_b, uv_c);
     }
 
-    LevelObjectsMesh3D generate_flat_ramp_mesh(const RampObject& ramp, int floor_number,
-                                               const RampMeshParams& p, Direction direction,
-                                               RampStyle style)
+    void generate_flat_ramp_mesh(MeshBuilder<VertexLevelObjects>& builder, const RampObject& ramp,
+                                 int floor_number, const RampMeshParams& p, Direction direction,
+                                 RampStyle style)
     {
         auto [a, b, c, d] = calculate_ramp_vertex_positions(ramp, floor_number);
         auto [uv_a, uv_b, uv_c, uv_d] = generate_ramp_texture_coords(a, b, c, d);
@@ -300,10 +308,11 @@ namespace
         // Normal is the cross product between the directions of 3 points on the "plane"
         auto normal = glm::normalize(glm::cross(b - a, c - a));
 
-        LevelObjectsMesh3D mesh;
+        builder.reserve(8, 12);
+
         // clang-format off
         // UV Coords are intentionally swapped otherwise they textures appear upside-down
-        mesh.vertices = {
+        builder.add_vertices({
             // Top
             {a, {uv_c.x, uv_c.y, p.texture_top}, normal, p.colour_top},
             {b, {uv_d.x, uv_d.y, p.texture_top}, normal, p.colour_top},
@@ -315,39 +324,38 @@ namespace
             {b, {uv_d.x, uv_d.y, p.texture_bottom}, -normal, p.colour_bottom},
             {c, {uv_a.x, uv_a.y, p.texture_bottom}, -normal, p.colour_bottom},
             {d, {uv_b.x, uv_b.y, p.texture_bottom}, -normal, p.colour_bottom},
-        };
+        });
         // clang-format on
 
         if (style == RampStyle::TriRamp)
         {
-            mesh.indices = {
+            builder.add_indices({
                 2, 3, 0, // Top
                 4, 7, 6, // Bottom
-            };
+            });
         }
         else if (style == RampStyle::FlippedTriRamp)
         {
-            mesh.indices = {
+            builder.add_indices({
                 0, 1, 2, // Top
                 6, 5, 4, // Bottom
-            };
+            });
         }
         else
         {
-            mesh.indices = {
+            builder.add_indices({
                 0, 1, 2, 2, 3, 0, // Top
                 6, 5, 4, 4, 7, 6, // Bottom
-            };
+            });
         }
-        return mesh;
     }
 
-    LevelObjectsMesh3D generate_corner_ramp_mesh(const RampObject& ramp, int floor_number,
-                                                 const RampMeshParams& p, Direction direction,
-                                                 RampStyle style)
+    void generate_corner_ramp_mesh(MeshBuilder<VertexLevelObjects>& builder,
+                                   const RampObject& ramp, int floor_number,
+                                   const RampMeshParams& p, Direction direction, RampStyle style)
     {
         auto [a, b, c, d] = calculate_ramp_vertex_positions(ramp, floor_number);
-        LevelObjectsMesh3D mesh;
+        builder.reserve(12, 12);
 
         // For the lighting to be correct for corners, the two faces of the corner must be their own
         // triangle face such that they have their own normal vectors
@@ -362,7 +370,7 @@ namespace
             auto na = glm::normalize(glm::cross(c - b, d - c));
             auto nb = glm::normalize(glm::cross(a - b, d - a));
 
-            mesh.vertices = {
+            builder.add_vertices({
                 // Top
                 {b, {uv_b1.x, uv_b1.y, p.texture_top}, na, p.colour_top},
                 {c, {uv_c1.x, uv_c1.y, p.texture_top}, na, p.colour_top},
@@ -380,12 +388,12 @@ namespace
                 {b, {uv_b2.x, uv_b2.y, p.texture_bottom}, nb, p.colour_bottom},
                 {a, {uv_a2.x, uv_a2.y, p.texture_bottom}, nb, p.colour_bottom},
                 {d, {uv_d2.x, uv_d2.y, p.texture_bottom}, nb, p.colour_bottom},
-            };
+            });
 
-            mesh.indices = {
+            builder.add_indices({
                 0, 1, 2, 5, 4,  3, // Top
                 8, 7, 6, 9, 10, 11, // Bottom
-            };
+            });
         }
         else 
         {
@@ -397,7 +405,7 @@ namespace
             auto na = glm::normalize(glm::cross(b - a, c - b));
             auto nb = glm::normalize(glm::cross(d - c, a - d));
 
-            mesh.vertices = {
+            builder.add_vertices({
                 // Top
                 {a, {uv_a1.x, uv_a1.y, p.texture_top}, na, p.colour_top},
                 {b, {uv_b1.x, uv_b1.y, p.texture_top}, na, p.colour_top},
@@ -415,22 +423,20 @@ namespace
                 {c, {uv_c2.x, uv_c2.y, p.texture_bottom}, -nb, p.colour_bottom},
                 {d, {uv_d2.x, uv_d2.y, p.texture_bottom}, -nb, p.colour_bottom},
                 {a, {uv_a2.x, uv_a2.y, p.texture_bottom}, -nb, p.colour_bottom},
-            };
-            mesh.indices = {
+            });
+            builder.add_indices({
                 0, 1, 2, 3,  4,  5, // Top
                 8, 7, 6, 11, 10, 9, // Bottom
-            };
+            });
         }
         // clang-format on
-
-        return mesh;
     }
 } // namespace
 
 template <>
-LevelObjectsMesh3D object_to_geometry(const RampObject& ramp, int floor_number)
+void object_to_geometry(const RampObject& ramp, int floor_number,
+                        MeshBuilder<VertexLevelObjects>& builder)
 {
-    LevelObjectsMesh3D mesh;
     const auto& props = ramp.properties;
 
     RampMeshParams ramp_mesh_params{
@@ -443,13 +449,13 @@ LevelObjectsMesh3D object_to_geometry(const RampObject& ramp, int floor_number)
 
     if (props.style == RampStyle::InvertedCorner || props.style == RampStyle::Corner)
     {
-        return generate_corner_ramp_mesh(ramp, floor_number, ramp_mesh_params, props.direction,
-                                         props.style);
+        generate_corner_ramp_mesh(builder, ramp, floor_number, ramp_mesh_params, props.direction,
+                                  props.style);
     }
     else
     {
-        return generate_flat_ramp_mesh(ramp, floor_number, ramp_mesh_params, props.direction,
-                                       props.style);
+        generate_flat_ramp_mesh(builder, ramp, floor_number, ramp_mesh_params, props.direction,
+                                props.style);
     }
 }
 
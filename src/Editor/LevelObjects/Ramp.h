@@ -9,6 +9,8 @@
 struct RampParameters
 {
     glm::vec2 position{0};
+
+    bool operator==(const RampParameters& other) const = default;
 };
 
 enum class RampStyle
@@ -69,13 +71,14 @@ template <>
                                                              LevelFileIO& level_file_io);
 
 template <>
-[[nodiscard]] std::pair<Mesh2DWorld, gl::PrimitiveType>
+gl::PrimitiveType
 object_to_geometry_2d<RampObject>(const RampObject& ramp,
-                                  const LevelTextures& drawing_pad_texture_map);
+                                  const LevelTextures& drawing_pad_texture_map,
+                                  MeshBuilder<Vertex2DWorld>& builder);
 
 template <>
-[[nodiscard]] LevelObjectsMesh3D object_to_geometry<RampObject>(const RampObject& ramp,
-                                                                int floor_number);
+void object_to_geometry<RampObject>(const RampObject& ramp, int floor_number,
+                                    MeshBuilder<VertexLevelObjects>& builder);
 
 // =======================================
 //      Helper Functions
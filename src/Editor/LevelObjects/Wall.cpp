@@ -73,6 +73,17 @@ template <>
     return wall.parameters.line.start;
 }
 
+template <>
+[[nodiscard]] Rectangle object_get_bounds_2d(const WallObject& wall)
+{
+    // Walls can be selected from slightly outside of the line
+    auto bounds = wall.parameters.line.to_bounds();
+    return {
+        .position = bounds.position - SELECTION_DISTANCE,
+        .size = bounds.size + SELECTION_DISTANCE * 2.0f,
+    };
+}
+
 template <>
 SerialiseResponse object_serialise(const WallObject& wall, LevelFileIO& level_file_io)
 {
@@ -132,16 +143,18 @@ bool object_deserialise(WallObject& wall, const nlohmann::json& json,
 }
 
 template <>
-std::pair<Mesh2DWorld, gl::PrimitiveType>
+gl::PrimitiveType
 object_to_geometry_2d(const WallObject& wall,
-                      [[maybe_unused]] const LevelTextures& drawing_pad_texture_map)
+                      [[maybe_unused]] const LevelTextures& drawing_pad_texture_map,
+                      MeshBuilder<Vertex2DWorld>& builder)
 {
-    return {generate_line_mesh(wall.parameters.line, {255, 255, 255, 255}),
-            gl::PrimitiveType::Lines};
+    add_line_to_mesh(builder, wall.parameters.line, {255, 255, 255, 255});
+    return gl::PrimitiveType::Lines;
 }
 
 template <>
-LevelObjectsMesh3D object_to_geometry(const WallObject& wall, int floor_number)
+void object_to_geometry(const WallObject& wall, int floor_number,
+                        MeshBuilder<VertexLevelObjects>& builder)
 {
     const auto& props = wall.properties;
 
@@ -159,13 +172,13 @@ LevelObjectsMesh3D object_to_geometry(const WallObject& wall, int floor_number)
     auto colour_back = props.texture_back.colour;
     auto colour_front = props.texture_front.colour;
 
-    LevelObjectsMesh3D mesh;
-
     auto front_normal = glm::cross(glm::normalize(b.end - b.start), {0, 1, 0});
     auto back_normal = glm::cross(glm::normalize(b.start - b.end), {0, 1, 0});
 
+    builder.reserve(8, 12);
+
     // clang-format off
-    mesh.vertices = {
+    builder.add_vertices({
         // Back
         {{b.start.x + ox, b.start.y, b.start.z + oz}, {0.0f,   t.start.y,  texture_back},  back_normal, colour_back},
         {{b.start.x + ox, t.start.y,  b.start.z + oz}, {0.0f,   b.start.y, texture_back},  back_normal, colour_back},
@@ -177,38 +190,36 @@ LevelObjectsMesh3D object_to_geometry(const WallObject& wall, int floor_number)
         {{b.start.x - ox, t.start.y,  b.start.z - oz}, {0.0f,   b.start.y, texture_front}, front_normal, colour_front},
         {{b.end.x - ox, t.end.y,  b.end.z - oz}, {length, b.end.y, texture_front}, front_normal, colour_front},
         {{b.end.x - ox, b.end.y, b.end.z - oz}, {length, t.end.y,  texture_front}, front_normal, colour_front},
-    };
+    });
     // clang-format on
 
     switch (props.style)
     {
         case WallStyle::Normal:
-            mesh.indices = {// Front
-                            0, 1, 2, 2, 3, 0,
-                            // Back
-                            6, 5, 4, 4, 7, 6};
+            builder.add_indices({// Front
+                                 0, 1, 2, 2, 3, 0,
+                                 // Back
+                                 6, 5, 4, 4, 7, 6});
             break;
 
         case WallStyle::TriWall:
-            mesh.indices = {// Front
-                            2, 3, 0,
-                            // Back
-                            4, 7, 6};
+            builder.add_indices({// Front
+                                 2, 3, 0,
+                                 // Back
+                                 4, 7, 6});
             break;
 
         case WallStyle::FlippedTriWall:
-            mesh.indices = {// Front
-                            0, 1, 2,
-                            // Back
-                            6, 5, 4};
+            builder.add_indices({// Front
+                                 0, 1, 2,
+                                 // Back
+                                 6, 5, 4});
             break;
 
         default:
             std::println("Missing wall style indices for {}", magic_enum::enum_name(props.style));
             break;
     }
-
-    return mesh;
 }
 
 WallLines wall_to_lines(const WallObject& wall, int floor)
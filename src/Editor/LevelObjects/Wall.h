@@ -31,6 +31,8 @@ struct WallProps
 struct WallParameters
 {
     Line line;
+
+    bool operator==(const WallParameters& other) const = default;
 };
 
 using WallObject = ObjectType<WallProps, WallParameters>;
@@ -69,12 +71,13 @@ template <>
                                                              LevelFileIO& level_file_io);
 
 template <>
-[[nodiscard]] std::pair<Mesh2DWorld, gl::PrimitiveType>
+gl::PrimitiveType
 object_to_geometry_2d<WallObject>(const WallObject& wall,
-                                  const LevelTextures& drawing_pad_texture_map);
+                                  const LevelTextures& drawing_pad_texture_map,
+                                  MeshBuilder<Vertex2DWorld>& builder);
 template <>
-[[nodiscard]] LevelObjectsMesh3D object_to_geometry<WallObject>(const WallObject& wall,
-                                                                int floor_number);
+void object_to_geometry<WallObject>(const WallObject& wall, int floor_number,
+                                    MeshBuilder<VertexLevelObjects>& builder);
 
 // =======================================
 //      Helper Functions
@@ -36,6 +36,12 @@ class LevelObjectPropertyEditor
     {
     }
 
+    /// Called once per frame to collect the results of "render_to_picker_mouse_over", which may
+    /// arrive up to "max_latency_frames" frames after the picker was rendered
+    virtual void poll_picker_mouse_over(int max_latency_frames)
+    {
+    }
+
     virtual bool hide_normal_previews() const
     {
         return false;
@@ -155,8 +155,7 @@ bool ObjectSizePropertyEditor::handle_event(const sf::Event& event, EditorState&
             {
                 size_ = new_size;
                 position_ = new_position;
-                update_object(*state.selection.p_active_object, state.current_floor, actions,
-                              false);
+                update_object(state.current_floor, actions, false);
                 update_previews();
             }
         }
@@ -168,7 +167,7 @@ bool ObjectSizePropertyEditor::handle_event(const sf::Event& event, EditorState&
         {
             if ((active_dragging_ || active_dragging_3d_) && save_update_)
             {
-                update_object(*state.selection.p_active_object, state.current_floor, actions, true);
+                update_object(state.current_floor, actions, true);
                 active_dragging_3d_ = false;
                 active_dragging_ = false;
                 return true;
@@ -194,7 +193,7 @@ void ObjectSizePropertyEditor::render_preview_2d(gl::Shader& scene_shader_2d)
 
     glLineWidth(3);
 
-    scene_shader_2d.set_uniform("model_matrix", create_model_matrix({}));
+    scene_shader_2d.set_model_matrix(create_model_matrix({}));
     scene_shader_2d.set_uniform("use_texture", false);
     scene_shader_2d.set_uniform("is_selected", false);
     scene_shader_2d.set_uniform("on_floor_below", false);
@@ -219,14 +218,14 @@ void ObjectSizePropertyEditor::render_preview_3d(gl::Shader& scene_shader_3d,
         cube_corner_preview_3d_.bind();
         for (auto& offset : corner_offsets_)
         {
-            scene_shader_3d.set_uniform("model_matrix", create_model_matrix({{
-                                                            position_.x / TILE_SIZE_F + offset.x,
-                                                            offset.height,
-                                                            position_.y / TILE_SIZE_F + offset.z,
-                                                        }}));
+            scene_shader_3d.set_model_matrix(create_model_matrix({{
+                position_.x / TILE_SIZE_F + offset.x,
+                offset.height,
+                position_.y / TILE_SIZE_F + offset.z,
+            }}));
             cube_corner_preview_3d_.draw_elements();
         }
-        scene_shader_3d.set_uniform("model_matrix", create_model_matrix({}));
+        scene_shader_3d.set_model_matrix(create_model_matrix({}));
     }
 
     glLineWidth(5);
@@ -271,45 +270,55 @@ void ObjectSizePropertyEditor::render_to_picker_mouse_over(const MousePickingSta
         return;
     }
 
-    picker_shader.set_uniform("model_matrix", create_model_matrix({}));
+    picker_shader.set_model_matrix(create_model_matrix({}));
+    auto object_id = picker_shader.get_uniform<int>("object_id");
 
     // A thicker line is used to ensure easier selection
     glLineWidth(15);
 
-    picker_shader.set_uniform("object_id", PullDirection::Up);
+    object_id.set(PullDirection::Up);
     top_line_preview_3d_.bind().draw_elements(gl::PrimitiveType::Lines);
 
-    picker_shader.set_uniform("object_id", PullDirection::Left);
+    object_id.set(PullDirection::Left);
     left_line_preview_3d_.bind().draw_elements(gl::PrimitiveType::Lines);
 
-    picker_shader.set_uniform("object_id", PullDirection::Right);
+    object_id.set(PullDirection::Right);
     right_line_preview_3d_.bind().draw_elements(gl::PrimitiveType::Lines);
 
-    picker_shader.set_uniform("object_id", PullDirection::Down);
+    object_id.set(PullDirection::Down);
     bottom_line_preview_3d_.bind().draw_elements(gl::PrimitiveType::Lines);
 
     cube_corner_preview_3d_.bind();
     for (auto& offset : corner_offsets_)
     {
-        picker_shader.set_uniform("object_id", offset.pull_direction);
-        picker_shader.set_uniform("model_matrix", create_model_matrix({{
-                                                      position_.x / TILE_SIZE_F + offset.x,
-                                                      offset.height,
-                                                      position_.y / TILE_SIZE_F + offset.z,
-                                                  }}));
+        object_id.set(offset.pull_direction);
+        picker_shader.set_model_matrix(create_model_matrix({{
+            position_.x / TILE_SIZE_F + offset.x,
+            offset.height,
+            position_.y / TILE_SIZE_F + offset.z,
+        }}));
         cube_corner_preview_3d_.draw_elements();
     }
 
-    // Check which one was picked
-    GLint picked_id = 0;
-    glReadPixels(picker_state.point.x, picker_state.point.y, 1, 1, GL_RED_INTEGER, GL_INT,
-                 &picked_id);
+    // Check which one was picked, the result is collected in "poll_picker_mouse_over"
+    mouse_over_readback_.request(picker_state.point.x, picker_state.point.y);
+}
+
+void ObjectSizePropertyEditor::poll_picker_mouse_over(int max_latency_frames)
+{
+    auto picked_id = mouse_over_readback_.poll(max_latency_frames);
+
+    // Results that arrive after a drag has started are stale
+    if (!picked_id || state_floor_ != object_floor_ || active_dragging_3d_)
+    {
+        return;
+    }
 
     mouseover_edge_3d_ = false;
-    if (picked_id > -1)
+    if (*picked_id > -1)
     {
         mouseover_edge_3d_ = true;
-        pull_direction_ = static_cast<PullDirection>(picked_id);
+        pull_direction_ = static_cast<PullDirection>(*picked_id);
         base_y_ = pull_direction_to_height_[pull_direction_];
 
         update_previews();
@@ -373,10 +382,10 @@ void ObjectSizePropertyEditor::drag_negative_direction(const Rectangle& object_r
     }
 }
 
-void ObjectSizePropertyEditor::update_object(const LevelObject& object, int current_floor,
-                                             ActionManager& actions, bool store_action)
+void ObjectSizePropertyEditor::update_object(int current_floor, ActionManager& actions,
+                                             bool store_action)
 {
-    auto new_object = object;
+    auto new_object = cached_object_;
     if (auto platform = std::get_if<PlatformObject>(&new_object.object_type))
     {
         platform->properties.size = size_;
@@ -4,6 +4,7 @@
 
 #include <glm/glm.hpp>
 
+#include "../../Graphics/OpenGL/PixelReadback.h"
 #include "../../Util/Maths.h"
 #include "../EditConstants.h"
 #include "../EditorGUI.h"
@@ -36,6 +37,7 @@ class ObjectSizePropertyEditor : public LevelObjectPropertyEditor
 
     void render_to_picker_mouse_over(const MousePickingState& picker_state,
                                      gl::Shader& picker_shader) override;
+    void poll_picker_mouse_over(int max_latency_frames) override;
 
     bool hide_normal_previews() const override;
 
@@ -57,9 +59,9 @@ class ObjectSizePropertyEditor : public LevelObjectPropertyEditor
 
     /// Update the object being referenced from this editor, which updates its mesh and enables
     /// saving the update history for when the mouse is released such that it can undo/redo can be
-    /// applied as needed.
-    void update_object(const LevelObject& object, int current_floor, ActionManager& actions,
-                       bool store_action);
+    /// applied as needed. Only the position and size are changed, so the update is based on the
+    /// cached object rather than the object in the level.
+    void update_object(int current_floor, ActionManager& actions, bool store_action);
 
     /// Updates the previews
     void update_previews();
@@ -92,6 +94,9 @@ class ObjectSizePropertyEditor : public LevelObjectPropertyEditor
     bool active_dragging_3d_ = false;
     bool mouseover_edge_3d_ = false;
 
+    /// Reads back which edge or corner the mouse is over without stalling the GPU
+    gl::PixelReadback mouse_over_readback_;
+
     glm::ivec2 start_drag_position_;
 
     // Preview for each side of the given shape to show which side is being re-sized
@@ -0,0 +1,390 @@
+#include "PickingBVH.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <format>
+#include <iostream>
+#include <numeric>
+#include <print>
+#include <random>
+
+#include <SFML/System/Clock.hpp>
+
+void PickingBVH::insert(ObjectId id, std::vector<glm::vec3> triangles)
+{
+    ObjectTriangles object{.id = id, .triangles = std::move(triangles)};
+    for (auto& vertex : object.triangles)
+    {
+        object.bounds.expand(vertex);
+    }
+
+    object_indices_[id] = static_cast<std::uint32_t>(objects_.size());
+    objects_.push_back(std::move(object));
+    needs_rebuild_ = true;
+}
+
+void PickingBVH::update(ObjectId id, std::vector<glm::vec3> triangles)
+{
+    auto itr = object_indices_.find(id);
+    if (itr == object_indices_.end())
+    {
+        return;
+    }
+
+    auto& object = objects_[itr->second];
+    object.triangles = std::move(triangles);
+    object.bounds = {};
+    for (auto& vertex : object.triangles)
+    {
+        object.bounds.expand(vertex);
+    }
+
+    // The tree will be rebuilt anyway, so there is no point refitting it
+    if (!needs_rebuild_)
+    {
+        refit(object.leaf);
+    }
+}
+
+void PickingBVH::remove(ObjectId id)
+{
+    auto itr = object_indices_.find(id);
+    if (itr == object_indices_.end())
+    {
+        return;
+    }
+    auto index = itr->second;
+    object_indices_.erase(itr);
+
+    // Move the last object into the gap to keep the objects packed
+    if (index + 1 != objects_.size())
+    {
+        objects_[index] = std::move(objects_.back());
+        object_indices_[objects_[index].id] = index;
+    }
+    objects_.pop_back();
+    needs_rebuild_ = true;
+}
+
+void PickingBVH::set_object_id(ObjectId current_id, ObjectId new_id)
+{
+    auto node = object_indices_.extract(current_id);
+    if (node.empty())
+    {
+        return;
+    }
+    objects_[node.mapped()].id = new_id;
+
+    node.key() = new_id;
+    object_indices_.insert(std::move(node));
+}
+
+void PickingBVH::clear()
+{
+    objects_.clear();
+    object_indices_.clear();
+    nodes_.clear();
+    object_order_.clear();
+    needs_rebuild_ = false;
+}
+
+std::optional<PickingBVH::RayHit> PickingBVH::cast_ray(const Ray& ray,
+                                                       const std::function<bool(ObjectId)>& filter)
+{
+    if (needs_rebuild_)
+    {
+        rebuild();
+    }
+
+    if (nodes_.empty())
+    {
+        return {};
+    }
+
+    glm::vec3 inverse_direction = 1.0f / ray.direction;
+    std::optional<RayHit> closest_hit;
+
+    std::vector<std::uint32_t> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+    while (!stack.empty())
+    {
+        const auto& node = nodes_[stack.back()];
+        stack.pop_back();
+
+        // Skip nodes that are missed, or are entirely behind the closest hit so far
+        auto node_distance = ray_box_intersect(ray, inverse_direction, node.bounds);
+        if (!node_distance || (closest_hit && *node_distance > closest_hit->distance))
+        {
+            continue;
+        }
+
+        if (!node.is_leaf())
+        {
+            stack.push_back(node.first);
+            stack.push_back(node.first + 1);
+            continue;
+        }
+
+        for (auto i = node.first; i < node.first + node.count; i++)
+        {
+            const auto& object = objects_[object_order_[i]];
+            if ((filter && !filter(object.id)) ||
+                !ray_box_intersect(ray, inverse_direction, object.bounds))
+            {
+                continue;
+            }
+
+            for (size_t v = 0; v + 2 < object.triangles.size(); v += 3)
+            {
+                auto distance = ray_triangle_intersect(ray, object.triangles[v],
+                                                       object.triangles[v + 1],
+                                                       object.triangles[v + 2]);
+                if (distance && (!closest_hit || *distance < closest_hit->distance))
+                {
+                    closest_hit = RayHit{.id = object.id, .distance = *distance};
+                }
+            }
+        }
+    }
+    return closest_hit;
+}
+
+void PickingBVH::rebuild()
+{
+    needs_rebuild_ = false;
+    nodes_.clear();
+    object_order_.resize(objects_.size());
+    std::iota(object_order_.begin(), object_order_.end(), 0);
+
+    if (objects_.empty())
+    {
+        return;
+    }
+
+    // A binary tree with leaves of at least 1 object has at most 2n - 1 nodes
+    nodes_.reserve(objects_.size() * 2);
+    nodes_.push_back({.first = 0, .count = static_cast<std::uint32_t>(objects_.size())});
+    subdivide(0);
+}
+
+void PickingBVH::subdivide(std::uint32_t node_index)
+{
+    auto first = nodes_[node_index].first;
+    auto count = nodes_[node_index].count;
+    auto begin = object_order_.begin() + first;
+    auto end = begin + count;
+
+    BoundingBox bounds;
+    BoundingBox centres;
+    for (auto itr = begin; itr != end; itr++)
+    {
+        bounds.expand(objects_[*itr].bounds);
+        centres.expand(objects_[*itr].bounds.centre());
+    }
+    nodes_[node_index].bounds = bounds;
+
+    // Split along the longest axis, unless all objects are in the same place where splitting would
+    // not help
+    auto extent = centres.max - centres.min;
+    int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+    if (count <= MAX_LEAF_OBJECTS || extent[axis] <= 0.0f)
+    {
+        for (auto itr = begin; itr != end; itr++)
+        {
+            objects_[*itr].leaf = node_index;
+        }
+        return;
+    }
+
+    // Split at the median such that the tree is balanced
+    auto middle = count / 2;
+    auto centre_on_axis = [&](std::uint32_t object)
+    { return objects_[object].bounds.centre()[axis]; };
+    std::nth_element(begin, begin + middle, end, [&](std::uint32_t a, std::uint32_t b)
+                     { return centre_on_axis(a) < centre_on_axis(b); });
+
+    auto left = static_cast<std::uint32_t>(nodes_.size());
+    nodes_.push_back({.first = first, .count = middle, .parent = node_index});
+    nodes_.push_back({.first = first + middle, .count = count - middle, .parent = node_index});
+
+    nodes_[node_index].first = left;
+    nodes_[node_index].count = 0;
+
+    subdivide(left);
+    subdivide(left + 1);
+}
+
+void PickingBVH::refit(std::uint32_t node_index)
+{
+    auto& leaf = nodes_[node_index];
+    leaf.bounds = {};
+    for (auto i = leaf.first; i < leaf.first + leaf.count; i++)
+    {
+        leaf.bounds.expand(objects_[object_order_[i]].bounds);
+    }
+
+    // Walk up to the root, resizing the parent nodes to fit their children
+    while (node_index != 0)
+    {
+        node_index = nodes_[node_index].parent;
+        auto& node = nodes_[node_index];
+        node.bounds = nodes_[node.first].bounds;
+        node.bounds.expand(nodes_[node.first + 1].bounds);
+    }
+}
+
+namespace
+{
+    /// The 12 triangles of an axis-aligned box
+    std::vector<glm::vec3> make_box_triangles(const glm::vec3& min, const glm::vec3& max)
+    {
+        auto corner = [&](int i)
+        { return glm::vec3{i & 1 ? max.x : min.x, i & 2 ? max.y : min.y, i & 4 ? max.z : min.z}; };
+
+        // Each face as the corners going around it
+        constexpr std::array<std::array<int, 4>, 6> FACES = {{
+            {0, 1, 3, 2},
+            {4, 5, 7, 6},
+            {0, 1, 5, 4},
+            {2, 3, 7, 6},
+            {0, 2, 6, 4},
+            {1, 3, 7, 5},
+        }};
+
+        std::vector<glm::vec3> triangles;
+        triangles.reserve(36);
+        for (auto& face : FACES)
+        {
+            for (auto i : {0, 1, 2, 2, 3, 0})
+            {
+                triangles.push_back(corner(face[i]));
+            }
+        }
+        return triangles;
+    }
+} // namespace
+
+void benchmark_picking_bvh()
+{
+    constexpr int RAYS = 1000;
+    constexpr float WORLD_SIZE_F = static_cast<float>(WORLD_SIZE);
+    constexpr float HEIGHT = FLOOR_HEIGHT * 10;
+
+    std::mt19937 rng{1234};
+    std::uniform_real_distribution<float> position_dist{0.0f, WORLD_SIZE_F - 4.0f};
+    std::uniform_real_distribution<float> height_dist{0.0f, HEIGHT - FLOOR_HEIGHT};
+    std::uniform_real_distribution<float> size_dist{0.25f, 4.0f};
+
+    auto make_random_box = [&]()
+    {
+        glm::vec3 min{position_dist(rng), height_dist(rng), position_dist(rng)};
+        return make_box_triangles(min, min + glm::vec3{size_dist(rng), 1.0f, size_dist(rng)});
+    };
+
+    auto per_ray = [](sf::Time time)
+    { return std::format("{:.3f}us", time.asMicroseconds() / static_cast<float>(RAYS)); };
+
+    std::println("{:>8} | {:>8} | {:>14} | {:>14} | {:>10}", "Objects", "Stage", "BVH",
+                 "Linear", "Mismatches");
+
+    for (int object_count : {100, 1'000, 2'000, 10'000})
+    {
+        PickingBVH bvh;
+        std::unordered_map<ObjectId, std::vector<glm::vec3>> objects;
+        for (ObjectId id = 0; id < object_count; id++)
+        {
+            auto triangles = make_random_box();
+            bvh.insert(id, triangles);
+            objects.emplace(id, std::move(triangles));
+        }
+
+        // Rays from above the level towards random points below it, as the camera would look
+        std::vector<Ray> rays;
+        for (int i = 0; i < RAYS; i++)
+        {
+            glm::vec3 origin{position_dist(rng), HEIGHT * 2, position_dist(rng)};
+            glm::vec3 target{position_dist(rng), 0.0f, position_dist(rng)};
+            rays.push_back({.origin = origin, .direction = glm::normalize(target - origin)});
+        }
+
+        auto cast_linear = [&](const Ray& ray)
+        {
+            std::optional<PickingBVH::RayHit> closest_hit;
+            for (auto& [id, triangles] : objects)
+            {
+                for (size_t v = 0; v + 2 < triangles.size(); v += 3)
+                {
+                    auto distance = ray_triangle_intersect(ray, triangles[v], triangles[v + 1],
+                                                           triangles[v + 2]);
+                    if (distance && (!closest_hit || *distance < closest_hit->distance))
+                    {
+                        closest_hit = PickingBVH::RayHit{.id = id, .distance = *distance};
+                    }
+                }
+            }
+            return closest_hit;
+        };
+
+        auto run = [&](const char* stage)
+        {
+            std::vector<std::optional<PickingBVH::RayHit>> bvh_hits;
+            std::vector<std::optional<PickingBVH::RayHit>> linear_hits;
+            bvh_hits.reserve(RAYS);
+            linear_hits.reserve(RAYS);
+
+            sf::Clock clock;
+            for (auto& ray : rays)
+            {
+                bvh_hits.push_back(bvh.cast_ray(ray));
+            }
+            auto bvh_time = clock.restart();
+
+            for (auto& ray : rays)
+            {
+                linear_hits.push_back(cast_linear(ray));
+            }
+            auto linear_time = clock.restart();
+
+            // Objects can overlap, so hits at the same distance on different objects both count as
+            // the closest hit
+            int mismatches = 0;
+            for (int i = 0; i < RAYS; i++)
+            {
+                auto& a = bvh_hits[i];
+                auto& b = linear_hits[i];
+                if (a.has_value() != b.has_value() ||
+                    (a && std::abs(a->distance - b->distance) > 1e-4f))
+                {
+                    mismatches++;
+                }
+            }
+
+            std::println("{:>8} | {:>8} | {:>14} | {:>14} | {:>10}", objects.size(), stage,
+                         per_ray(bvh_time), per_ray(linear_time), mismatches);
+            if (mismatches > 0)
+            {
+                std::println(std::cerr, "PickingBVH hits do not match a linear scan for {} rays",
+                             mismatches);
+            }
+        };
+        run("Built");
+
+        // Updates refit the tree built by the casts above, rather than rebuilding it
+        for (ObjectId id = 0; id < object_count; id += 10)
+        {
+            auto triangles = make_random_box();
+            bvh.update(id, triangles);
+            objects[id] = std::move(triangles);
+        }
+        run("Updated");
+
+        for (ObjectId id = 5; id < object_count; id += 7)
+        {
+            bvh.remove(id);
+            objects.erase(id);
+        }
+        run("Removed");
+    }
+}
\ No newline at end of file
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "../Util/Maths.h"
+#include "EditConstants.h"
+
+/**
+ * @brief Bounding volume hierarchy over the 3D geometry of the level's objects, used to find which
+ * object is under the mouse by casting a ray rather than rendering the level to the picker texture
+ * and reading it back.
+ *
+ * The tree is built over the bounding boxes of each object, and each leaf tests the triangles of
+ * its objects. Updating an object only refits the boxes above it, while adding or removing objects
+ * causes the tree to be rebuilt the next time a ray is cast.
+ *
+ * This does not use OpenGL, so can be used without a window.
+ */
+class PickingBVH
+{
+    /// The max number of objects in a leaf node
+    static constexpr std::uint32_t MAX_LEAF_OBJECTS = 4;
+
+    struct ObjectTriangles
+    {
+        ObjectId id = 0;
+        BoundingBox bounds;
+
+        /// Every 3 vertices makes a triangle
+        std::vector<glm::vec3> triangles;
+
+        /// The leaf node this object is in, used for refitting
+        std::uint32_t leaf = 0;
+    };
+
+    struct Node
+    {
+        BoundingBox bounds;
+
+        /// For leaves this is the index into object_order_ of the first object, otherwise it is the
+        /// index of the left child (with the right child being directly after it)
+        std::uint32_t first = 0;
+
+        /// The number of objects in the node, 0 for non-leaf nodes
+        std::uint32_t count = 0;
+
+        std::uint32_t parent = 0;
+
+        bool is_leaf() const
+        {
+            return count > 0;
+        }
+    };
+
+  public:
+    struct RayHit
+    {
+        ObjectId id = 0;
+
+        /// The distance along the ray
+        float distance = 0;
+    };
+
+    /// Adds the triangles of the given vertices and indices. Vertex must have a glm::vec3
+    /// "position", such as the vertices of a LevelObjectsMesh3D. The vertices are moved by
+    /// "offset", such as for geometry shared between objects.
+    template <typename Vertex>
+    void insert(ObjectId id, const std::vector<Vertex>& vertices,
+                const std::vector<unsigned int>& indices, const glm::vec3& offset = glm::vec3{0})
+    {
+        insert(id, to_triangles(vertices, indices, offset));
+    }
+
+    /// Replaces the triangles of the given object, refitting the tree around them.
+    template <typename Vertex>
+    void update(ObjectId id, const std::vector<Vertex>& vertices,
+                const std::vector<unsigned int>& indices, const glm::vec3& offset = glm::vec3{0})
+    {
+        update(id, to_triangles(vertices, indices, offset));
+    }
+
+    void insert(ObjectId id, std::vector<glm::vec3> triangles);
+    void update(ObjectId id, std::vector<glm::vec3> triangles);
+    void remove(ObjectId id);
+    void set_object_id(ObjectId current_id, ObjectId new_id);
+    void clear();
+
+    /// Finds the closest object hit by the ray. When given, only objects passing the filter can be
+    /// hit.
+    std::optional<RayHit> cast_ray(const Ray& ray,
+                                   const std::function<bool(ObjectId)>& filter = nullptr);
+
+  private:
+    template <typename Vertex>
+    static std::vector<glm::vec3> to_triangles(const std::vector<Vertex>& vertices,
+                                               const std::vector<unsigned int>& indices,
+                                               const glm::vec3& offset)
+    {
+        std::vector<glm::vec3> triangles;
+        triangles.reserve(indices.size());
+        for (auto index : indices)
+        {
+            triangles.push_back(vertices[index].position + offset);
+        }
+        return triangles;
+    }
+
+    void rebuild();
+    void subdivide(std::uint32_t node_index);
+    void refit(std::uint32_t node_index);
+
+    std::vector<ObjectTriangles> objects_;
+    std::unordered_map<ObjectId, std::uint32_t> object_indices_;
+
+    std::vector<Node> nodes_;
+
+    /// Indices into objects_, ordered such that each leaf's objects are contiguous
+    std::vector<std::uint32_t> object_order_;
+
+    /// Set when objects are added or removed, as the tree can then no longer be refit
+    bool needs_rebuild_ = false;
+};
+
+/// Casts rays against PickingBVH and against every triangle of every object for levels of 100 to
+/// 10k box-shaped objects, including after moving and removing some of the objects, and prints
+/// the times and any rays where the closest hits differ
+void benchmark_picking_bvh();
\ No newline at end of file
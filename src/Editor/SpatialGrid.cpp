@@ -0,0 +1,250 @@
+#include "SpatialGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <print>
+#include <random>
+
+#include <SFML/System/Clock.hpp>
+
+SpatialGrid::SpatialGrid()
+    : cells_(CELLS * CELLS)
+{
+}
+
+void SpatialGrid::insert(ObjectId id, const Rectangle& bounds)
+{
+    auto range = to_cell_range(bounds);
+    for (int y = range.min.y; y <= range.max.y; y++)
+    {
+        for (int x = range.min.x; x <= range.max.x; x++)
+        {
+            // Cells are kept sorted by ID so overlapping objects are always found in the order
+            // they were created, regardless of how often they have been moved
+            auto& objects = cell(x, y);
+            objects.insert(std::ranges::lower_bound(objects, id), id);
+        }
+    }
+    object_cells_[id] = range;
+}
+
+void SpatialGrid::update(ObjectId id, const Rectangle& bounds)
+{
+    // Nothing to do if the object covers the same cells as before
+    auto itr = object_cells_.find(id);
+    if (itr != object_cells_.end())
+    {
+        auto range = to_cell_range(bounds);
+        if (range.min == itr->second.min && range.max == itr->second.max)
+        {
+            return;
+        }
+    }
+    remove(id);
+    insert(id, bounds);
+}
+
+void SpatialGrid::remove(ObjectId id)
+{
+    auto itr = object_cells_.find(id);
+    if (itr == object_cells_.end())
+    {
+        return;
+    }
+
+    auto& range = itr->second;
+    for (int y = range.min.y; y <= range.max.y; y++)
+    {
+        for (int x = range.min.x; x <= range.max.x; x++)
+        {
+            std::erase(cell(x, y), id);
+        }
+    }
+    object_cells_.erase(itr);
+}
+
+void SpatialGrid::set_object_id(ObjectId current_id, ObjectId new_id)
+{
+    auto node = object_cells_.extract(current_id);
+    if (node.empty())
+    {
+        return;
+    }
+
+    auto& range = node.mapped();
+    for (int y = range.min.y; y <= range.max.y; y++)
+    {
+        for (int x = range.min.x; x <= range.max.x; x++)
+        {
+            auto& objects = cell(x, y);
+            std::erase(objects, current_id);
+            objects.insert(std::ranges::lower_bound(objects, new_id), new_id);
+        }
+    }
+
+    node.key() = new_id;
+    object_cells_.insert(std::move(node));
+}
+
+void SpatialGrid::clear()
+{
+    for (auto& cell : cells_)
+    {
+        cell.clear();
+    }
+    object_cells_.clear();
+}
+
+void SpatialGrid::query(glm::vec2 point, std::vector<ObjectId>& candidates) const
+{
+    auto range = to_cell_range({.position = point, .size = {0, 0}});
+    const auto& objects = cell(range.min.x, range.min.y);
+    candidates.insert(candidates.end(), objects.begin(), objects.end());
+}
+
+void SpatialGrid::query(const Rectangle& area, std::vector<ObjectId>& candidates) const
+{
+    auto first = candidates.size();
+
+    auto range = to_cell_range(area);
+    for (int y = range.min.y; y <= range.max.y; y++)
+    {
+        for (int x = range.min.x; x <= range.max.x; x++)
+        {
+            const auto& objects = cell(x, y);
+            candidates.insert(candidates.end(), objects.begin(), objects.end());
+        }
+    }
+
+    // Objects covering multiple cells will have been added multiple times
+    auto new_candidates = std::ranges::subrange(candidates.begin() + first, candidates.end());
+    std::ranges::sort(new_candidates);
+    auto duplicates = std::ranges::unique(new_candidates);
+    candidates.erase(duplicates.begin(), duplicates.end());
+}
+
+SpatialGrid::CellRange SpatialGrid::to_cell_range(const Rectangle& bounds) const
+{
+    auto to_cell = [](float position)
+    { return std::clamp(static_cast<int>(std::floor(position / CELL_SIZE_F)), 0, CELLS - 1); };
+
+    auto start = bounds.position;
+    auto end = bounds.position + bounds.size;
+
+    // Objects outside of the world are clamped to the edge cells so they can still be found
+    return {
+        .min = {to_cell(std::min(start.x, end.x)), to_cell(std::min(start.y, end.y))},
+        .max = {to_cell(std::max(start.x, end.x)), to_cell(std::max(start.y, end.y))},
+    };
+}
+
+std::vector<ObjectId>& SpatialGrid::cell(int x, int y)
+{
+    return cells_[y * CELLS + x];
+}
+
+const std::vector<ObjectId>& SpatialGrid::cell(int x, int y) const
+{
+    return cells_[y * CELLS + x];
+}
+
+void benchmark_spatial_grid()
+{
+    constexpr int QUERIES = 1000;
+    constexpr float WORLD_SIZE_F = WORLD_SIZE * TILE_SIZE_F;
+
+    std::mt19937 rng{1234};
+    std::uniform_real_distribution<float> position_dist{0.0f, WORLD_SIZE_F - TILE_SIZE_F * 4};
+    std::uniform_real_distribution<float> size_dist{HALF_TILE_SIZE_F, TILE_SIZE_F * 4};
+
+    std::println("{:>8} | {:>14} | {:>14} | {:>14} | {:>14}", "Objects", "Grid point",
+                 "Linear point", "Grid area", "Linear area");
+
+    for (int object_count : {100, 1'000, 10'000, 100'000})
+    {
+        std::vector<Rectangle> bounds;
+        bounds.reserve(object_count);
+
+        SpatialGrid grid;
+        for (int i = 0; i < object_count; i++)
+        {
+            auto& rect = bounds.emplace_back(Rectangle{
+                .position = {position_dist(rng), position_dist(rng)},
+                .size = {size_dist(rng), size_dist(rng)},
+            });
+            grid.insert(i, rect);
+        }
+
+        std::vector<glm::vec2> points;
+        std::vector<Rectangle> areas;
+        for (int i = 0; i < QUERIES; i++)
+        {
+            points.push_back({position_dist(rng), position_dist(rng)});
+            areas.push_back(
+                {.position = points.back(), .size = {TILE_SIZE_F * 4, TILE_SIZE_F * 4}});
+        }
+
+        // The number of hits is accumulated and printed to ensure the queries are not optimised
+        // away, and that both methods agree
+        size_t grid_point_hits = 0;
+        size_t linear_point_hits = 0;
+        size_t grid_area_hits = 0;
+        size_t linear_area_hits = 0;
+        std::vector<ObjectId> candidates;
+
+        sf::Clock clock;
+        for (auto& point : points)
+        {
+            candidates.clear();
+            grid.query(point, candidates);
+            for (auto id : candidates)
+            {
+                grid_point_hits += bounds[id].contains(point);
+            }
+        }
+        auto grid_point_time = clock.restart();
+
+        for (auto& point : points)
+        {
+            for (auto& rect : bounds)
+            {
+                linear_point_hits += rect.contains(point);
+            }
+        }
+        auto linear_point_time = clock.restart();
+
+        for (auto& area : areas)
+        {
+            candidates.clear();
+            grid.query(area, candidates);
+            for (auto id : candidates)
+            {
+                grid_area_hits += bounds[id].is_entirely_within(area);
+            }
+        }
+        auto grid_area_time = clock.restart();
+
+        for (auto& area : areas)
+        {
+            for (auto& rect : bounds)
+            {
+                linear_area_hits += rect.is_entirely_within(area);
+            }
+        }
+        auto linear_area_time = clock.restart();
+
+        auto per_query = [](sf::Time time)
+        { return std::format("{:.3f}us", time.asMicroseconds() / static_cast<float>(QUERIES)); };
+
+        std::println("{:>8} | {:>14} | {:>14} | {:>14} | {:>14}", object_count,
+                     per_query(grid_point_time), per_query(linear_point_time),
+                     per_query(grid_area_time), per_query(linear_area_time));
+
+        if (grid_point_hits != linear_point_hits || grid_area_hits != linear_area_hits)
+        {
+            std::println(std::cerr, "Spatial grid results do not match: {}/{} {}/{}",
+                         grid_point_hits, linear_point_hits, grid_area_hits, linear_area_hits);
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../Util/Maths.h"
+#include "EditConstants.h"
+
+/**
+ * @brief Uniform grid over the WORLD_SIZE x WORLD_SIZE world used to find objects near a point or
+ * area in the 2D view without having to test every object on a floor.
+ *
+ * Objects are added to every cell their 2D bounds overlaps. Queries only give candidates, so the
+ * precise tests (eg LevelObject::try_select_2d) must still be done on the objects returned.
+ */
+class SpatialGrid
+{
+    /// The size of each cell in tiles
+    static constexpr int CELL_TILES = 2;
+    static constexpr int CELLS = WORLD_SIZE / CELL_TILES;
+    static constexpr float CELL_SIZE_F = CELL_TILES * TILE_SIZE_F;
+
+    struct CellRange
+    {
+        glm::ivec2 min{0};
+        glm::ivec2 max{0};
+    };
+
+  public:
+    SpatialGrid();
+
+    /// Adds the object to the grid. The bounds are in world pixels.
+    void insert(ObjectId id, const Rectangle& bounds);
+
+    /// Moves the object to the cells covered by the new bounds
+    void update(ObjectId id, const Rectangle& bounds);
+
+    void remove(ObjectId id);
+
+    void set_object_id(ObjectId current_id, ObjectId new_id);
+
+    void clear();
+
+    /// Gets the objects that could contain the given point, in order of their IDs
+    void query(glm::vec2 point, std::vector<ObjectId>& candidates) const;
+
+    /// Gets the objects that could overlap the given area. Each object is returned once.
+    void query(const Rectangle& area, std::vector<ObjectId>& candidates) const;
+
+  private:
+    CellRange to_cell_range(const Rectangle& bounds) const;
+
+    std::vector<ObjectId>& cell(int x, int y);
+    const std::vector<ObjectId>& cell(int x, int y) const;
+
+    std::vector<std::vector<ObjectId>> cells_;
+
+    /// The cells each object was added to, used for removing the object again
+    std::unordered_map<ObjectId, CellRange> object_cells_;
+};
+
+/// Times SpatialGrid queries against testing every object for levels of 100 to 100k objects and
+/// prints the results
+void benchmark_spatial_grid();
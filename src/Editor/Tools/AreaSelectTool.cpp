@@ -71,7 +71,7 @@ bool AreaSelectTool::on_event(const sf::Event& event, EditorState& state, Action
             select(state);
 
             // Ensure the selection area is reset when nothing is selected
-            if (state.selection.objects.size() == 0)
+            if (state.selection.get_objects().size() == 0)
             {
                 selection_area_ = Line{};
             }
@@ -116,11 +116,11 @@ ToolType AreaSelectTool::get_tool_type() const
 
 void AreaSelectTool::show_gui(EditorState& state)
 {
-    if (state.selection.objects.size() > 0)
+    if (state.selection.get_objects().size() > 0)
     {
         if (ImGui::Begin("Selection Options"))
         {
-            ImGui::Text("Selected %zu objects.", state.selection.objects.size());
+            ImGui::Text("Selected %zu objects.", state.selection.get_objects().size());
 
             bool update = false;
             update |= ImGui::SliderInt("Max floors selection", &max_floor_, start_floor_,
@@ -139,6 +139,7 @@ void AreaSelectTool::show_gui(EditorState& state)
 
 void AreaSelectTool::select(EditorState& state)
 {
+    Selection::BatchUpdate batch_update(state.selection);
     state.selection.clear_selection();
     for (int floor = min_floor_; floor <= max_floor_; floor++)
     {
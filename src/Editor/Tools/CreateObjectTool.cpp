@@ -113,12 +113,10 @@ void CreateObjectTool::update_previews(const EditorState& state,
             break;
     }
 
-    object_preview_ = object_.to_geometry(state.current_floor);
+    object_.to_geometry(state.current_floor, object_preview_);
     object_preview_.update();
 
-    auto [preview, primitive] = object_.to_2d_geometry(drawing_pad_texture_map);
-    object_preview_2d_ = std::move(preview);
-    preview_2d_primitive_ = primitive;
+    preview_2d_primitive_ = object_.to_2d_geometry(drawing_pad_texture_map, object_preview_2d_);
     object_preview_2d_.update();
 }
 
@@ -5,6 +5,7 @@
 #include <SFML/Window/Event.hpp>
 
 #include "../../Graphics/Mesh.h"
+#include "../../Graphics/OpenGL/PixelReadback.h"
 #include "../../Util/Maths.h"
 #include "../LevelObjects/LevelObject.h"
 
@@ -47,6 +48,10 @@ class ITool
     virtual void render_to_picker_mouse_over(const MousePickingState& picker_state,
                                              gl::Shader& picker_shader) {};
 
+    /// Called once per frame to collect the results of "render_to_picker_mouse_over", which may
+    /// arrive up to "max_latency_frames" frames after the picker was rendered
+    virtual void poll_picker_mouse_over(int max_latency_frames) {};
+
     [[nodiscard]] virtual ToolType get_tool_type() const = 0;
 
     virtual void show_gui(EditorState& state) {};
@@ -113,6 +118,7 @@ class UpdateWallTool : public ITool
 
     void render_to_picker_mouse_over(const MousePickingState& picker_state,
                                      gl::Shader& picker_shader) override;
+    void poll_picker_mouse_over(int max_latency_frames) override;
 
   private:
     void update_previews(const EditorState& state, const LevelTextures& drawing_pad_texture_map);
@@ -157,6 +163,9 @@ class UpdateWallTool : public ITool
     DragTarget drag_target_ = DragTarget::None;
 
     bool mouse_over_edge_3d_ = false;
+
+    /// Reads back which end of the wall the mouse is over without stalling the GPU
+    gl::PixelReadback mouse_over_readback_;
 };
 
 /**
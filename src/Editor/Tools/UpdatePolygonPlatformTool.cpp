@@ -173,11 +173,9 @@ void UpdatePolygonTool::render_preview_2d(gl::Shader& scene_shader_2d)
 {
     auto draw_selection_point = [&](const glm::vec2& position, float scale = 1.0f)
     {
-        scene_shader_2d.set_uniform(
-            "model_matrix",
-            create_model_matrix(
-                {.position = glm::vec3{position - glm::vec2{MIN_SELECT_DISTANCE * scale}, 0.0},
-                 .scale = glm::vec3{scale}}));
+        scene_shader_2d.set_model_matrix(create_model_matrix(
+            {.position = glm::vec3{position - glm::vec2{MIN_SELECT_DISTANCE * scale}, 0.0},
+             .scale = glm::vec3{scale}}));
 
         vertex_selector_mesh_.bind().draw_elements();
     };
@@ -233,7 +231,7 @@ void UpdatePolygonTool::update_previews(PolygonUpdateAction action, const Editor
         polygon_preview_2d_ = object_to_outline_2d(polygon_);
         polygon_preview_2d_.update();
 
-        polygon_preview_ = object_to_geometry(polygon_, state_floor_);
+        object_to_geometry(polygon_, state_floor_, polygon_preview_);
         polygon_preview_.update();
     }
 
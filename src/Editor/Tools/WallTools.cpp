@@ -127,10 +127,8 @@ void CreateWallTool::render_preview_2d(gl::Shader& scene_shader_2d)
     scene_shader_2d.set_uniform("use_texture_alpha_channel", true);
     scene_shader_2d.set_uniform("use_world_texture", false);
 
-    scene_shader_2d.set_uniform(
-        "model_matrix",
-        create_model_matrix(
-            {.position = glm::vec3{tile_hovered_, 0} - glm::vec3(WALL_NODE_ICON_SIZE / 2.0f, 0)}));
+    scene_shader_2d.set_model_matrix(create_model_matrix(
+        {.position = glm::vec3{tile_hovered_, 0} - glm::vec3(WALL_NODE_ICON_SIZE / 2.0f, 0)}));
     vertex_selector_mesh_.bind().draw_elements();
 }
 
@@ -153,10 +151,10 @@ void CreateWallTool::update_previews(const EditorState& state,
         .parameters = {Line{.start = wall_line_.start, .end = wall_line_.end}},
     };
 
-    wall_preview_ = object_to_geometry(wall, state.current_floor);
+    object_to_geometry(wall, state.current_floor, wall_preview_);
     wall_preview_.update();
 
-    wall_preview_2d_ = object_to_geometry_2d(wall, drawing_pad_texture_map).first;
+    object_to_geometry_2d(wall, drawing_pad_texture_map, wall_preview_2d_);
     wall_preview_2d_.update();
 
     auto selection_cube_start =
@@ -313,11 +311,9 @@ void UpdateWallTool::render_preview_2d(gl::Shader& scene_shader_2d)
 {
     auto draw_selection_point = [&](const glm::vec2& position, float scale = 1.0f)
     {
-        scene_shader_2d.set_uniform(
-            "model_matrix",
-            create_model_matrix(
-                {.position = glm::vec3{position - glm::vec2{MIN_SELECT_DISTANCE * scale}, 0.0},
-                 .scale = glm::vec3{scale}}));
+        scene_shader_2d.set_model_matrix(create_model_matrix(
+            {.position = glm::vec3{position - glm::vec2{MIN_SELECT_DISTANCE * scale}, 0.0},
+             .scale = glm::vec3{scale}}));
 
         vertex_selector_mesh_.bind().draw_elements();
     };
@@ -352,7 +348,7 @@ void UpdateWallTool::render_to_picker_mouse_over(const MousePickingState& picker
         return;
     }
 
-    picker_shader.set_uniform("model_matrix", create_model_matrix({}));
+    picker_shader.set_model_matrix(create_model_matrix({}));
 
     // A thicker line is used to ensure easier selection
     glLineWidth(15);
@@ -363,18 +359,27 @@ void UpdateWallTool::render_to_picker_mouse_over(const MousePickingState& picker
     picker_shader.set_uniform("object_id", (int)DragTarget::End);
     wall_end_preview_3d_.bind().draw_elements(gl::PrimitiveType::Lines);
 
-    // Check which one was picked
-    GLint picked_id = 0;
-    glReadPixels(picker_state.point.x, picker_state.point.y, 1, 1, GL_RED_INTEGER, GL_INT,
-                 &picked_id);
+    // Check which one was picked, the result is collected in "poll_picker_mouse_over"
+    mouse_over_readback_.request(picker_state.point.x, picker_state.point.y);
+    glLineWidth(2);
+}
+
+void UpdateWallTool::poll_picker_mouse_over(int max_latency_frames)
+{
+    auto picked_id = mouse_over_readback_.poll(max_latency_frames);
+
+    // Results that arrive after a drag has started are stale
+    if (!picked_id || (state_floor_ != wall_floor_) || active_dragging_)
+    {
+        return;
+    }
 
     mouse_over_edge_3d_ = false;
-    if (picked_id > -1)
+    if (*picked_id > -1)
     {
         mouse_over_edge_3d_ = true;
-        drag_target_ = static_cast<DragTarget>(picked_id);
+        drag_target_ = static_cast<DragTarget>(*picked_id);
     }
-    glLineWidth(2);
 }
 
 void UpdateWallTool::update_previews(const EditorState& state,
@@ -386,10 +391,10 @@ void UpdateWallTool::update_previews(const EditorState& state,
     };
     update_3d_previews(wall);
 
-    wall_preview_ = object_to_geometry(wall, state.current_floor);
+    object_to_geometry(wall, state.current_floor, wall_preview_);
     wall_preview_.update();
 
-    wall_preview_2d_ = object_to_geometry_2d(wall, drawing_pad_texture_map).first;
+    object_to_geometry_2d(wall, drawing_pad_texture_map, wall_preview_2d_);
     wall_preview_2d_.update();
 }
 
@@ -43,6 +43,11 @@ const glm::vec3& Camera::get_forwards() const
     return forwards_;
 }
 
+Frustum Camera::get_frustum() const
+{
+    return Frustum::from_matrix(projection_matrix_ * view_matrix_);
+}
+
 CameraType Camera::get_type() const
 {
     return config_.type;
@@ -148,6 +153,30 @@ glm::vec3 Camera::find_mouse_floor_intersect(glm::vec2 mouse_click, float floor_
     return ray_origin + ray_dir * t;
 }
 
+Ray Camera::get_mouse_ray(glm::vec2 mouse_click) const
+{
+    mouse_click.x = mouse_click.x - config_.viewport_position.x;
+    mouse_click.y = mouse_click.y - config_.viewport_position.y;
+
+    glm::vec2 ndc = {(2.0f * mouse_click.x) / config_.viewport_size.x - 1.0f,
+                     1.0f - (2.0f * mouse_click.y) / config_.viewport_size.y};
+
+    // Unproject the point on the near and far plane, which must be divided by W to get the 3D
+    // world coords
+    glm::mat4 inverse_view_projection = glm::inverse(projection_matrix_ * view_matrix_);
+    glm::vec4 near_point = inverse_view_projection * glm::vec4{ndc.x, ndc.y, -1.0f, 1.0f};
+    glm::vec4 far_point = inverse_view_projection * glm::vec4{ndc.x, ndc.y, 1.0f, 1.0f};
+
+    glm::vec3 ray_start = glm::vec3(near_point) / near_point.w;
+    glm::vec3 ray_end = glm::vec3(far_point) / far_point.w;
+
+    return {
+        .origin = ray_start,
+        .direction = glm::normalize(ray_end - ray_start),
+        .length = glm::length(ray_end - ray_start),
+    };
+}
+
 void Camera::set_projection()
 {
     if (config_.type == CameraType::Perspective)
@@ -40,6 +40,9 @@ class Camera
     const glm::mat4& get_projection_matrix() const;
     const glm::vec3& get_forwards() const;
 
+    /// The frustum of the camera as of the last call to "update"
+    Frustum get_frustum() const;
+
     CameraType get_type() const;
 
     float get_orthographic_scale() const;
@@ -59,6 +62,10 @@ class Camera
 
     glm::vec3 find_mouse_floor_intersect(glm::vec2 mouse_click, float floor_y) const;
 
+    /// Creates a ray going through the given window position, starting at the near plane and ending
+    /// at the far plane such that it only hits what the camera can see
+    Ray get_mouse_ray(glm::vec2 mouse_click) const;
+
   private:
     void set_projection();
 
@@ -0,0 +1,355 @@
+#include "GeometryOptimiser.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
+
+namespace
+{
+    /// Tolerance used when comparing positions, as objects are generated using different
+    /// calculations that may not give exactly the same result for the same point
+    constexpr float POSITION_EPSILON = 1.0f / 1024.0f;
+    constexpr float UV_EPSILON = 1.0f / 256.0f;
+
+    bool nearly_equal(float a, float b, float epsilon = POSITION_EPSILON)
+    {
+        return std::abs(a - b) <= epsilon;
+    }
+
+    bool nearly_equal(const glm::vec2& a, const glm::vec2& b, float epsilon)
+    {
+        return nearly_equal(a.x, b.x, epsilon) && nearly_equal(a.y, b.y, epsilon);
+    }
+
+    /// Texture coordinates repeat, so coordinates a whole number apart sample the same texels
+    bool nearly_whole(const glm::vec2& uv)
+    {
+        return nearly_equal(uv, glm::round(uv), UV_EPSILON);
+    }
+
+    /// The two axes of the plane facing along the given axis, in the order used by Quad::min/max
+    glm::vec2 to_plane(const glm::vec3& position, int axis)
+    {
+        return {position[(axis + 1) % 3], position[(axis + 2) % 3]};
+    }
+
+    glm::vec3 from_plane(const glm::vec2& point, float plane, int axis)
+    {
+        glm::vec3 position;
+        position[axis] = plane;
+        position[(axis + 1) % 3] = point.x;
+        position[(axis + 2) % 3] = point.y;
+        return position;
+    }
+} // namespace
+
+void GeometryOptimiser::add(const std::vector<VertexLevelObjects>& vertices,
+                            const std::vector<GLuint>& indices, const glm::vec3& offset,
+                            int source, bool closed)
+{
+    input_triangles_ += static_cast<int>(indices.size() / 3);
+
+    size_t i = 0;
+    while (i + 2 < indices.size())
+    {
+        // Quads are added as the triangles (a, b, c) and (c, d, a)
+        if (i + 5 < indices.size() && indices[i + 3] == indices[i + 2] &&
+            indices[i + 5] == indices[i])
+        {
+            std::array quad_vertices{vertices[indices[i]], vertices[indices[i + 1]],
+                                     vertices[indices[i + 2]], vertices[indices[i + 4]]};
+            if (try_add_quad(quad_vertices, offset, source, closed))
+            {
+                i += 6;
+                continue;
+            }
+        }
+
+        for (size_t j = i; j < i + 3; j++)
+        {
+            auto vertex = vertices[indices[j]];
+            vertex.position += offset;
+            triangles_.push_back(vertex);
+        }
+        i += 3;
+    }
+}
+
+bool GeometryOptimiser::try_add_quad(const std::array<VertexLevelObjects, 4>& vertices,
+                                     const glm::vec3& offset, int source, bool closed)
+{
+    Quad quad;
+    quad.normal = vertices[0].normal;
+    quad.texture = vertices[0].texture_coord.z;
+    quad.colour = vertices[0].colour;
+    quad.source = source;
+    quad.closed = closed;
+
+    // Only quads facing exactly along an axis can be culled or merged
+    int axis = 0;
+    for (int i = 1; i < 3; i++)
+    {
+        if (std::abs(quad.normal[i]) > std::abs(quad.normal[axis]))
+        {
+            axis = i;
+        }
+    }
+    if (!nearly_equal(std::abs(quad.normal[axis]), 1.0f) ||
+        !nearly_equal(glm::length(quad.normal), 1.0f))
+    {
+        return false;
+    }
+    quad.axis = axis;
+    quad.faces_positive = quad.normal[axis] > 0;
+    quad.plane = vertices[0].position[axis] + offset[axis];
+
+    std::array<glm::vec2, 4> points;
+    for (size_t i = 0; i < 4; i++)
+    {
+        auto& vertex = vertices[i];
+        if (vertex.normal != quad.normal || vertex.texture_coord.z != quad.texture ||
+            vertex.colour != quad.colour ||
+            !nearly_equal(vertex.position[axis] + offset[axis], quad.plane))
+        {
+            return false;
+        }
+        points[i] = to_plane(vertex.position + offset, axis);
+    }
+
+    quad.min = glm::min(glm::min(points[0], points[1]), glm::min(points[2], points[3]));
+    quad.max = glm::max(glm::max(points[0], points[1]), glm::max(points[2], points[3]));
+    if (nearly_equal(quad.min.x, quad.max.x) || nearly_equal(quad.min.y, quad.max.y))
+    {
+        return false;
+    }
+
+    // Every point must be at a different corner for the quad to be a rectangle
+    int corners_used = 0;
+    for (size_t i = 0; i < 4; i++)
+    {
+        bool at_min_x = nearly_equal(points[i].x, quad.min.x);
+        bool at_min_y = nearly_equal(points[i].y, quad.min.y);
+        if ((!at_min_x && !nearly_equal(points[i].x, quad.max.x)) ||
+            (!at_min_y && !nearly_equal(points[i].y, quad.max.y)))
+        {
+            return false;
+        }
+
+        constexpr std::array CORNERS = {2, 3, 1, 0};
+        auto corner = CORNERS[(at_min_x ? 1 : 0) + (at_min_y ? 2 : 0)];
+        corners_used |= 1 << corner;
+        quad.corner_uvs[corner] = glm::vec2{vertices[i].texture_coord};
+    }
+    if (corners_used != 0b1111)
+    {
+        return false;
+    }
+
+    auto a = points[1] - points[0];
+    auto b = points[2] - points[0];
+    quad.clockwise = a.x * b.y - a.y * b.x < 0;
+
+    auto size = quad.max - quad.min;
+    auto& uvs = quad.corner_uvs;
+    quad.uv_per_x = (uvs[1] - uvs[0]) / size.x;
+    quad.uv_per_y = (uvs[3] - uvs[0]) / size.y;
+    quad.linear_uvs = nearly_equal(uvs[2], uvs[0] + quad.uv_per_x * size.x + quad.uv_per_y * size.y,
+                                   UV_EPSILON);
+
+    quads_.push_back(quad);
+    return true;
+}
+
+void GeometryOptimiser::remove_hidden_quads(const std::vector<size_t>& plane_quads,
+                                            GeometryOptimiserStats& stats)
+{
+    auto covers = [](const Quad& cover, const Quad& quad)
+    {
+        return cover.min.x <= quad.min.x + POSITION_EPSILON &&
+               cover.min.y <= quad.min.y + POSITION_EPSILON &&
+               cover.max.x >= quad.max.x - POSITION_EPSILON &&
+               cover.max.y >= quad.max.y - POSITION_EPSILON;
+    };
+
+    // Only faces of closed geometry pressed against other closed geometry are hidden. A platform's
+    // top and bottom, or a wall's front and back, are the same surface seen from either side, so
+    // must not hide each other.
+    auto hides = [&](const Quad& cover, const Quad& quad)
+    {
+        return cover.closed && quad.closed && cover.source != quad.source &&
+               cover.faces_positive != quad.faces_positive && covers(cover, quad);
+    };
+
+    // Both quads are removed when two cover each other, so all are checked before any are removed
+    std::vector<size_t> hidden;
+    for (auto i : plane_quads)
+    {
+        if (!quads_[i].closed)
+        {
+            continue;
+        }
+        for (auto j : plane_quads)
+        {
+            if (hides(quads_[j], quads_[i]))
+            {
+                hidden.push_back(i);
+                break;
+            }
+        }
+    }
+
+    for (auto i : hidden)
+    {
+        quads_[i].removed = true;
+    }
+    stats.hidden_quads += static_cast<int>(hidden.size());
+}
+
+void GeometryOptimiser::merge_quads(std::vector<size_t> plane_quads, int axis,
+                                    GeometryOptimiserStats& stats)
+{
+    // Quads that can be merged along the axis are next to each other once sorted
+    int other = 1 - axis;
+    std::ranges::sort(plane_quads,
+                      [&](size_t lhs, size_t rhs)
+                      {
+                          auto& a = quads_[lhs];
+                          auto& b = quads_[rhs];
+                          return std::tie(a.faces_positive, a.texture, a.colour.r, a.colour.g,
+                                          a.colour.b, a.colour.a, a.min[other], a.max[other],
+                                          a.min[axis]) <
+                                 std::tie(b.faces_positive, b.texture, b.colour.r, b.colour.g,
+                                          b.colour.b, b.colour.a, b.min[other], b.max[other],
+                                          b.min[axis]);
+                      });
+
+    Quad* p_current = nullptr;
+    for (auto i : plane_quads)
+    {
+        auto& quad = quads_[i];
+        if (quad.removed)
+        {
+            continue;
+        }
+
+        auto can_merge = [&](const Quad& current)
+        {
+            if (!current.linear_uvs || !quad.linear_uvs ||
+                current.faces_positive != quad.faces_positive ||
+                current.clockwise != quad.clockwise || current.texture != quad.texture ||
+                current.colour != quad.colour ||
+                !nearly_equal(current.min[other], quad.min[other]) ||
+                !nearly_equal(current.max[other], quad.max[other]) ||
+                !nearly_equal(current.max[axis], quad.min[axis]) ||
+                !nearly_equal(current.uv_per_x, quad.uv_per_x, UV_EPSILON) ||
+                !nearly_equal(current.uv_per_y, quad.uv_per_y, UV_EPSILON))
+            {
+                return false;
+            }
+
+            // The texture must carry on from where the current quad ends
+            auto offset = quad.min - current.min;
+            auto expected = current.corner_uvs[0] + current.uv_per_x * offset.x +
+                            current.uv_per_y * offset.y;
+            return nearly_whole(quad.corner_uvs[0] - expected);
+        };
+
+        if (p_current && can_merge(*p_current))
+        {
+            p_current->max[axis] = quad.max[axis];
+            quad.removed = true;
+            stats.merged_quads++;
+        }
+        else
+        {
+            p_current = &quad;
+        }
+    }
+}
+
+GeometryOptimiserStats GeometryOptimiser::build(MeshBuilder<VertexLevelObjects>& builder)
+{
+    GeometryOptimiserStats stats{.input_triangles = input_triangles_};
+
+    // Only quads on the same plane can hide or be merged with each other
+    std::map<std::pair<int, long long>, std::vector<size_t>> planes;
+    for (size_t i = 0; i < quads_.size(); i++)
+    {
+        auto& quad = quads_[i];
+        planes[{quad.axis, std::llround(quad.plane / POSITION_EPSILON)}].push_back(i);
+    }
+
+    for (auto& [plane, plane_quads] : planes)
+    {
+        remove_hidden_quads(plane_quads, stats);
+        merge_quads(plane_quads, 0, stats);
+        merge_quads(plane_quads, 1, stats);
+    }
+
+    auto quad_count = static_cast<size_t>(
+        std::ranges::count_if(quads_, [](const Quad& quad) { return !quad.removed; }));
+    builder.reserve(quad_count * 4 + triangles_.size(), quad_count * 6 + triangles_.size());
+
+    for (auto& quad : quads_)
+    {
+        if (quad.removed)
+        {
+            continue;
+        }
+
+        std::array corners = {
+            quad.min,
+            glm::vec2{quad.max.x, quad.min.y},
+            quad.max,
+            glm::vec2{quad.min.x, quad.max.y},
+        };
+
+        // Merged quads have texture coordinates far from 0 on one side, so they are moved back
+        // towards 0 (by whole numbers, as the textures repeat) to keep their precision
+        std::array<glm::vec2, 4> uvs = quad.corner_uvs;
+        if (quad.linear_uvs)
+        {
+            for (size_t i = 0; i < 4; i++)
+            {
+                auto offset = corners[i] - quad.min;
+                uvs[i] = quad.corner_uvs[0] + quad.uv_per_x * offset.x + quad.uv_per_y * offset.y;
+            }
+            auto shift = glm::floor(glm::min(glm::min(uvs[0], uvs[1]), glm::min(uvs[2], uvs[3])));
+            for (auto& uv : uvs)
+            {
+                uv -= shift;
+            }
+        }
+
+        auto first = builder.vertex_count();
+        for (size_t i = 0; i < 4; i++)
+        {
+            builder.add_vertex({from_plane(corners[i], quad.plane, quad.axis),
+                                {uvs[i], quad.texture},
+                                quad.normal,
+                                quad.colour});
+        }
+        if (quad.clockwise)
+        {
+            builder.add_indices({first, first + 3, first + 2, first + 2, first + 1, first});
+        }
+        else
+        {
+            builder.add_quad_indices(first);
+        }
+    }
+
+    for (auto& vertex : triangles_)
+    {
+        builder.add_index(builder.vertex_count());
+        builder.add_vertex(vertex);
+    }
+
+    stats.output_triangles = static_cast<int>(quad_count * 2 + triangles_.size() / 3);
+
+    quads_.clear();
+    triangles_.clear();
+    input_triangles_ = 0;
+    return stats;
+}
\ No newline at end of file
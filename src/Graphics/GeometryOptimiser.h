@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "Mesh.h"
+#include "MeshBuilder.h"
+
+/// Counts from the last call to GeometryOptimiser::build
+struct GeometryOptimiserStats
+{
+    int input_triangles = 0;
+    int output_triangles = 0;
+
+    /// Quads removed as they are covered by other geometry
+    int hidden_quads = 0;
+
+    /// Quads removed by being merged into an adjacent quad
+    int merged_quads = 0;
+};
+
+/**
+ * @brief Combines the geometry of many meshes into one with fewer triangles, for geometry that is
+ * only drawn rather than edited (eg all of the objects on a floor).
+ *
+ * Axis-aligned quads (as added by MeshBuilder::add_quad_indices) are found in the added geometry:
+ *  - Faces of closed geometry covered by a face of other closed geometry on the same plane facing
+ *    the other way are removed, as they are inside of the geometry and can never be seen (eg the
+ *    sides of two pillars placed against each other). Open geometry such as platforms and walls
+ *    are surfaces seen from both sides, so are never removed or hide anything.
+ *  - Adjacent quads on the same plane with the same normal, texture and colour are merged when
+ *    their texture coordinates line up, such that the merged quad looks the same.
+ *
+ * Any other triangles are kept as they are.
+ */
+class GeometryOptimiser
+{
+  public:
+    /// Adds the geometry to be optimised, moved by the given offset. "source" identifies the
+    /// geometry (eg the object it is for), and "closed" is set when the geometry encloses a volume
+    /// such that its faces can only be seen from outside of it.
+    void add(const std::vector<VertexLevelObjects>& vertices, const std::vector<GLuint>& indices,
+             const glm::vec3& offset, int source, bool closed);
+
+    /// Writes the optimised geometry of everything added since the last call to "build"
+    GeometryOptimiserStats build(MeshBuilder<VertexLevelObjects>& builder);
+
+  private:
+    struct Quad
+    {
+        /// The axis the quad faces along (0 = x, 1 = y, 2 = z), and its position along it
+        int axis = 0;
+        float plane = 0;
+        bool faces_positive = true;
+
+        /// The corners of the quad on the plane, where "x" and "y" are the two other axes in order
+        glm::vec2 min{0};
+        glm::vec2 max{0};
+
+        glm::vec3 normal{0};
+        float texture = 0;
+        glm::u8vec4 colour{255};
+
+        /// Texture coordinates at each corner, in the order: min, (max.x, min.y), max, and then
+        /// (min.x, max.y)
+        std::array<glm::vec2, 4> corner_uvs{};
+
+        /// Set when the texture coordinates change linearly across the quad, such that they can be
+        /// found for any point on the plane from the coordinates at "min" and how they change along
+        /// each axis. Only such quads can be merged.
+        bool linear_uvs = false;
+        glm::vec2 uv_per_x{0};
+        glm::vec2 uv_per_y{0};
+
+        /// Set when the quad's triangles go clockwise in the corner order above
+        bool clockwise = false;
+
+        /// The geometry the quad was added with
+        int source = 0;
+        bool closed = false;
+
+        bool removed = false;
+    };
+
+    [[nodiscard]] bool try_add_quad(const std::array<VertexLevelObjects, 4>& vertices,
+                                    const glm::vec3& offset, int source, bool closed);
+    void remove_hidden_quads(const std::vector<size_t>& plane_quads, GeometryOptimiserStats& stats);
+    void merge_quads(std::vector<size_t> plane_quads, int axis, GeometryOptimiserStats& stats);
+
+    std::vector<Quad> quads_;
+
+    /// Geometry that is not an axis-aligned quad, 3 vertices per triangle
+    std::vector<VertexLevelObjects> triangles_;
+
+    int input_triangles_ = 0;
+};
\ No newline at end of file
@@ -1,13 +1,17 @@
 #pragma once
 
+#include <algorithm>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
 #include <print>
+#include <utility>
 #include <vector>
 
 #include "../Editor/EditConstants.h"
 #include "../Editor/LevelObjects/LevelObjectTypes.h"
 #include "../Util/Maths.h"
+#include "MeshArena.h"
 #include "OpenGL/GLUtils.h"
 #include "OpenGL/VertexArrayObject.h"
 
@@ -33,7 +37,7 @@ struct Vertex3D
      * @param vao The VertexArrayObject to which the attributes will be added.
      * @param vbo The BufferObject containing the vertex data.
      */
-    static constexpr void build_attribs(gl::VertexArrayObject& vao, gl::BufferObject& vbo)
+    static constexpr void build_attribs(gl::VertexArrayObject& vao, const gl::BufferObject& vbo)
     {
         vao.add_vertex_buffer(vbo, sizeof(Vertex3D))
             .add_attribute(3, gl::Type::Float, offsetof(Vertex3D, position))
@@ -53,7 +57,7 @@ struct Vertex2DWorld
     glm::vec3 world_texture_coord{0.0f};
     glm::u8vec4 colour{255};
 
-    static void build_attribs(gl::VertexArrayObject& vao, gl::BufferObject& vbo)
+    static void build_attribs(gl::VertexArrayObject& vao, const gl::BufferObject& vbo)
     {
         vao.add_vertex_buffer(vbo, sizeof(Vertex2DWorld))
             .add_attribute(2, gl::Type::Float, offsetof(Vertex2DWorld, position))
@@ -69,7 +73,7 @@ struct Vertex2D
     glm::vec2 texture_coord{0.0f};
     glm::u8vec4 colour{255};
 
-    static void build_attribs(gl::VertexArrayObject& vao, gl::BufferObject& vbo)
+    static void build_attribs(gl::VertexArrayObject& vao, const gl::BufferObject& vbo)
     {
         vao.add_vertex_buffer(vbo, sizeof(Vertex2D))
             .add_attribute(2, gl::Type::Float, offsetof(Vertex2D, position))
@@ -82,12 +86,37 @@ template <typename Vertex>
 class Mesh
 {
   public:
-    /// Buffer the mesh
+    Mesh() = default;
+    ~Mesh();
+
+    Mesh(Mesh&& other) noexcept;
+    Mesh& operator=(Mesh&& other) noexcept;
+
+    Mesh(const Mesh& other) = delete;
+    Mesh& operator=(const Mesh& other) = delete;
+
+    /// Buffer the mesh. Meshes without indices release their buffered space instead, such that
+    /// the old geometry is no longer drawn.
     bool buffer();
 
-    /// Update the mesh if it is already buffered, otherwise creates a new buffer
+    /// Update the mesh if it is already buffered, otherwise creates a new buffer. As with
+    /// "buffer", meshes without indices are no longer buffered afterwards.
     bool update();
 
+    /// Same as "update", but only uploads the vertices when the indices have not changed since the
+    /// mesh was last buffered (eg after "translate")
+    bool update_vertices();
+
+    /// Moves every vertex by the given offset
+    template <typename Offset>
+    void translate(const Offset& offset)
+    {
+        for (auto& vertex : vertices)
+        {
+            vertex.position += offset;
+        }
+    }
+
     // Clears the vertices and indices array
     void clear();
 
@@ -97,19 +126,32 @@ class Mesh
     /// Does glDrawElements. Fails if the indices are empty
     void draw_elements(gl::PrimitiveType primitive = gl::PrimitiveType::Triangles) const;
 
-    gl::VertexArrayObject& vao()
+    GLuint indices_count() const
     {
-        return vao_;
+        return indices_;
     }
 
-    GLuint indices_count() const
+    /// Bounds of the vertices positions. Only usable for meshes with 3D positions.
+    BoundingBox calculate_bounds() const
     {
-        return indices_;
+        BoundingBox bounds;
+        for (auto& vertex : vertices)
+        {
+            bounds.expand(vertex.position);
+        }
+        return bounds;
     }
 
     bool has_buffered() const
     {
-        return has_buffered_;
+        return allocation_.indices.is_valid();
+    }
+
+    /// Where the mesh is stored in the MeshArena, used to draw many meshes at once. The mesh must
+    /// have been buffered.
+    MeshLocation get_location() const
+    {
+        return MeshArena<Vertex>::get().get_location(allocation_);
     }
 
   public:
@@ -117,35 +159,62 @@ class Mesh
     std::vector<GLuint> indices;
 
   private:
-    gl::VertexArrayObject vao_;
-    gl::BufferObject vbo_;
-    gl::BufferObject ebo_;
-    GLuint indices_ = 0;
+    /// Frees the mesh's space in the MeshArena
+    void release();
 
-    bool has_buffered_ = false;
+    /// Rather than owning a VAO and buffers, the mesh is stored in the shared MeshArena
+    typename MeshArena<Vertex>::Allocation allocation_;
+    GLuint indices_ = 0;
 };
 
+template <typename Vertex>
+Mesh<Vertex>::~Mesh()
+{
+    if (has_buffered())
+    {
+        MeshArena<Vertex>::get().free(allocation_);
+    }
+}
+
+template <typename Vertex>
+Mesh<Vertex>::Mesh(Mesh&& other) noexcept
+    : vertices(std::move(other.vertices))
+    , indices(std::move(other.indices))
+    , allocation_(std::exchange(other.allocation_, {}))
+    , indices_(std::exchange(other.indices_, 0))
+{
+}
+
+template <typename Vertex>
+Mesh<Vertex>& Mesh<Vertex>::operator=(Mesh&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (has_buffered())
+        {
+            MeshArena<Vertex>::get().free(allocation_);
+        }
+        vertices = std::move(other.vertices);
+        indices = std::move(other.indices);
+        allocation_ = std::exchange(other.allocation_, {});
+        indices_ = std::exchange(other.indices_, 0);
+    }
+    return *this;
+}
+
 template <typename Vertex>
 bool Mesh<Vertex>::buffer()
 {
+    release();
     if (indices.empty())
     {
         return false;
     }
 
-    vao_.reset();
-    vbo_.reset();
-    ebo_.reset();
+    auto& arena = MeshArena<Vertex>::get();
     indices_ = static_cast<GLuint>(indices.size());
-
-    // Upload the EBO indices data to the GPU and link it to the VAO
-    ebo_.buffer_data(indices);
-    glVertexArrayElementBuffer(vao_.id, ebo_.id);
-
-    // Upload the data to the GPU and set up the attributes
-    vbo_.buffer_data(vertices);
-    Vertex::build_attribs(vao_, vbo_);
-    has_buffered_ = true;
+    allocation_ = arena.allocate(static_cast<GLuint>(vertices.size()), indices_);
+    arena.write(allocation_, vertices, indices);
     return true;
 }
 
@@ -154,24 +223,51 @@ bool Mesh<Vertex>::update()
 {
     if (indices.empty())
     {
+        release();
         return false;
     }
 
-    // Ensure the indices count being updated matches what is currently in the buffer
-    if (indices_ != static_cast<GLuint>(indices.size()))
+    if (!has_buffered())
     {
-        has_buffered_ = false;
+        return buffer();
     }
 
-    if (!has_buffered_)
+    // The existing space can be reused as long as the mesh has not grown
+    auto& arena = MeshArena<Vertex>::get();
+    auto [vertex_capacity, index_capacity] = arena.get_capacity(allocation_);
+    if (vertices.size() > vertex_capacity || indices.size() > index_capacity)
     {
         return buffer();
     }
-    ebo_.buffer_sub_data(0, indices);
-    vbo_.buffer_sub_data(0, vertices);
+
+    indices_ = static_cast<GLuint>(indices.size());
+    arena.write(allocation_, vertices, indices);
+    return true;
+}
+
+template <typename Vertex>
+bool Mesh<Vertex>::update_vertices()
+{
+    auto& arena = MeshArena<Vertex>::get();
+    if (!has_buffered() || vertices.size() > arena.get_capacity(allocation_).first)
+    {
+        return update();
+    }
+
+    arena.write_vertices(allocation_, vertices);
     return true;
 }
 
+template <typename Vertex>
+void Mesh<Vertex>::release()
+{
+    if (has_buffered())
+    {
+        MeshArena<Vertex>::get().free(allocation_);
+    }
+    indices_ = 0;
+}
+
 template <typename Vertex>
 void Mesh<Vertex>::clear()
 {
@@ -183,7 +279,10 @@ void Mesh<Vertex>::clear()
 template <typename Vertex>
 const Mesh<Vertex>& Mesh<Vertex>::bind() const
 {
-    vao_.bind();
+    if (has_buffered())
+    {
+        MeshArena<Vertex>::get().bind(get_location().block);
+    }
     return *this;
 }
 
@@ -191,8 +290,17 @@ template <typename Vertex>
 void Mesh<Vertex>::draw_elements(gl::PrimitiveType primitive) const
 {
     assert(indices_ > 0);
+    if (!has_buffered())
+    {
+        return;
+    }
 
-    glDrawElements(static_cast<GLenum>(primitive), indices_, GL_UNSIGNED_INT, nullptr);
+    auto location = get_location();
+    auto index_type = location.block.index_type;
+    glDrawElementsBaseVertex(
+        static_cast<GLenum>(primitive), indices_, index_type,
+        reinterpret_cast<const void*>(location.first_index * index_type_size(index_type)),
+        location.base_vertex);
 }
 
 /// 3D vertex with 2D texture coordinates.
@@ -213,3 +321,101 @@ using Mesh2DWorld = Mesh<Vertex2DWorld>;
 /// Mesh for 2D meshes
 using Mesh2D = Mesh<Vertex2D>;
 
+/**
+ * @brief Packs a position into 16 bit fixed point, with the scale stored in "w". The scale is
+ * chosen per vertex as the largest power of two that keeps each component in range, so vertices
+ * near the origin keep more precision.
+ *
+ * The components are read as normalised shorts, so shaders decode the position with
+ * "in_position.xyz / in_position.w", which works for float positions too as "w" defaults to 1.
+ */
+inline glm::i16vec4 pack_position(const glm::vec3& position)
+{
+    constexpr float MAX_VALUE = 32767.0f;
+    constexpr int MAX_SCALE = 1024;
+
+    auto largest = std::max({std::abs(position.x), std::abs(position.y), std::abs(position.z)});
+    int scale = MAX_SCALE;
+    while (scale > 1 && largest * scale > MAX_VALUE)
+    {
+        scale /= 2;
+    }
+    auto fixed = glm::round(position * static_cast<float>(scale));
+    fixed = glm::clamp(fixed, -MAX_VALUE, MAX_VALUE);
+    return {glm::i16vec3{fixed}, scale};
+}
+
+/// Packs three floats into half floats, with the fourth component unused to keep 4 byte alignment.
+/// Integers up to 2048 (eg a texture layer) are exactly representable.
+inline glm::u16vec4 pack_half(const glm::vec3& value)
+{
+    return {glm::packHalf1x16(value.x), glm::packHalf1x16(value.y), glm::packHalf1x16(value.z), 0};
+}
+
+/// GPU layout of VertexLevelObjects, 24 bytes rather than 40
+struct PackedVertexLevelObjects
+{
+    glm::i16vec4 position;
+
+    /// Half float UV with the texture layer as the third component
+    glm::u16vec4 texture_coord;
+    GLuint normal;
+    glm::u8vec4 colour;
+
+    explicit PackedVertexLevelObjects(const VertexLevelObjects& vertex)
+        : position(pack_position(vertex.position))
+        , texture_coord(pack_half(vertex.texture_coord))
+        , normal(glm::packSnorm3x10_1x2({vertex.normal, 0.0f}))
+        , colour(vertex.colour)
+    {
+    }
+
+    static void build_attribs(gl::VertexArrayObject& vao, const gl::BufferObject& vbo)
+    {
+        using V = PackedVertexLevelObjects;
+        vao.add_vertex_buffer(vbo, sizeof(V))
+            .add_attribute(4, gl::Type::Short, offsetof(V, position), true)
+            .add_attribute(3, gl::Type::HalfFloat, offsetof(V, texture_coord))
+            .add_attribute(4, gl::Type::Int2_10_10_10_Rev, offsetof(V, normal), true)
+            .add_attribute(4, gl::Type::UnsignedByte, offsetof(V, colour), true);
+    }
+};
+
+/// GPU layout of Vertex2DWorld, 28 bytes rather than 36
+struct PackedVertex2DWorld
+{
+    glm::i16vec4 position;
+    glm::u16vec4 texture_coord;
+    glm::u16vec4 world_texture_coord;
+    glm::u8vec4 colour;
+
+    explicit PackedVertex2DWorld(const Vertex2DWorld& vertex)
+        : position(pack_position({vertex.position, 0.0f}))
+        , texture_coord(pack_half(vertex.texture_coord))
+        , world_texture_coord(pack_half(vertex.world_texture_coord))
+        , colour(vertex.colour)
+    {
+    }
+
+    static void build_attribs(gl::VertexArrayObject& vao, const gl::BufferObject& vbo)
+    {
+        using V = PackedVertex2DWorld;
+        vao.add_vertex_buffer(vbo, sizeof(V))
+            .add_attribute(4, gl::Type::Short, offsetof(V, position), true)
+            .add_attribute(3, gl::Type::HalfFloat, offsetof(V, texture_coord))
+            .add_attribute(3, gl::Type::HalfFloat, offsetof(V, world_texture_coord))
+            .add_attribute(4, gl::Type::UnsignedByte, offsetof(V, colour), true);
+    }
+};
+
+template <>
+struct GPUVertexLayout<VertexLevelObjects>
+{
+    using Type = PackedVertexLevelObjects;
+};
+
+template <>
+struct GPUVertexLayout<Vertex2DWorld>
+{
+    using Type = PackedVertex2DWorld;
+};
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <map>
+#include <type_traits>
+#include <vector>
+
+#include "OpenGL/BufferArena.h"
+#include "OpenGL/VertexArrayObject.h"
+
+/// Identifies which of a MeshArena's vertex and index blocks a mesh is stored in. Meshes in the same
+/// blocks share a VAO, so can be drawn together.
+struct MeshBlockKey
+{
+    std::uint32_t vertex_block = 0;
+    std::uint32_t index_block = 0;
+
+    /// GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, as each index width is stored in separate blocks
+    GLenum index_type = GL_UNSIGNED_INT;
+
+    auto operator<=>(const MeshBlockKey& other) const = default;
+};
+
+/// Where a mesh is stored within its MeshArena
+struct MeshLocation
+{
+    MeshBlockKey block;
+    GLint base_vertex = 0;
+    GLuint first_index = 0;
+};
+
+/// The size in bytes of a single index of the given index type
+constexpr GLsizeiptr index_type_size(GLenum index_type)
+{
+    return index_type == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+}
+
+/// The layout a vertex type is stored as on the GPU. By default this is the vertex itself, but
+/// vertex types can specialise this to store a more compact layout instead, which must be
+/// constructible from the vertex and provide "build_attribs".
+template <typename Vertex>
+struct GPUVertexLayout
+{
+    using Type = Vertex;
+};
+
+/**
+ * @brief Storage shared by every Mesh with the same vertex type, such that meshes are ranges within
+ * a few large buffers rather than each owning a VAO and buffers of their own.
+ *
+ * The VAO for each pair of vertex and index blocks is created on first use, and is shared by every
+ * mesh stored in them.
+ *
+ * Meshes with few enough vertices have their indices stored as 16 bit rather than 32 bit. Indices
+ * are relative to the mesh's base vertex, so this depends only on the size of the mesh.
+ */
+template <typename Vertex>
+class MeshArena
+{
+    /// Size of each block, large enough that most levels fit in a single block
+    static constexpr GLsizeiptr BLOCK_SIZE_BYTES = 16 * 1024 * 1024;
+
+    using StoredVertex = typename GPUVertexLayout<Vertex>::Type;
+
+    /// The most vertices a mesh can have while still using 16 bit indices
+    static constexpr GLuint MAX_SHORT_INDEX_VERTICES = 65536;
+
+  public:
+    struct Allocation
+    {
+        gl::BufferArena::Handle vertices;
+        gl::BufferArena::Handle indices;
+        bool short_indices = false;
+    };
+
+    /// The arena used by all meshes of this vertex type. This is created on first use, as it
+    /// requires an OpenGL context.
+    static MeshArena& get()
+    {
+        // Deliberately never destroyed as the OpenGL context no longer exists at program exit
+        static auto* arena = new MeshArena();
+        return *arena;
+    }
+
+    [[nodiscard]] Allocation allocate(GLuint vertex_count, GLuint index_count)
+    {
+        bool short_indices = vertex_count <= MAX_SHORT_INDEX_VERTICES;
+        return {
+            .vertices = vertices_.allocate(vertex_count),
+            .indices = get_index_arena(short_indices).allocate(index_count),
+            .short_indices = short_indices,
+        };
+    }
+
+    void free(Allocation& allocation)
+    {
+        vertices_.free(allocation.vertices);
+        get_index_arena(allocation.short_indices).free(allocation.indices);
+    }
+
+    void write(const Allocation& allocation, const std::vector<Vertex>& vertices,
+               const std::vector<GLuint>& indices)
+    {
+        write_vertices(allocation, vertices);
+        if (allocation.short_indices)
+        {
+            short_indices_scratch_.assign(indices.begin(), indices.end());
+            short_indices_.write(allocation.indices, short_indices_scratch_);
+        }
+        else
+        {
+            indices_.write(allocation.indices, indices);
+        }
+    }
+
+    /// Writes only the vertices of the allocation, for when the indices have not changed
+    void write_vertices(const Allocation& allocation, const std::vector<Vertex>& vertices)
+    {
+        if constexpr (std::is_same_v<StoredVertex, Vertex>)
+        {
+            vertices_.write(allocation.vertices, vertices);
+        }
+        else
+        {
+            // Reused between writes to avoid allocating every time a mesh is buffered
+            packed_vertices_.assign(vertices.begin(), vertices.end());
+            vertices_.write(allocation.vertices, packed_vertices_);
+        }
+    }
+
+    /// The number of vertices and indices that can be written to the allocation
+    std::pair<GLuint, GLuint> get_capacity(const Allocation& allocation) const
+    {
+        return {
+            vertices_.get(allocation.vertices).count,
+            get_index_arena(allocation.short_indices).get(allocation.indices).count,
+        };
+    }
+
+    MeshLocation get_location(const Allocation& allocation) const
+    {
+        auto& vertices = vertices_.get(allocation.vertices);
+        auto& indices = get_index_arena(allocation.short_indices).get(allocation.indices);
+        GLenum index_type = allocation.short_indices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+        return {
+            .block = {.vertex_block = vertices.block,
+                      .index_block = indices.block,
+                      .index_type = index_type},
+            .base_vertex = static_cast<GLint>(vertices.offset),
+            .first_index = indices.offset,
+        };
+    }
+
+    /// Binds the VAO for the given blocks, creating it if needed
+    void bind(const MeshBlockKey& key)
+    {
+        auto itr = vaos_.find(key);
+        if (itr == vaos_.end())
+        {
+            itr = vaos_.try_emplace(key).first;
+            auto& vao = itr->second;
+
+            auto& indices = get_index_arena(key.index_type == GL_UNSIGNED_SHORT);
+            glVertexArrayElementBuffer(vao.id, indices.get_buffer(key.index_block).id);
+            StoredVertex::build_attribs(vao, vertices_.get_buffer(key.vertex_block));
+        }
+        itr->second.bind();
+    }
+
+    /// Compacts the blocks to reduce wasted space. Meshes must not be drawn with locations found
+    /// before this call, such as MeshBatch draw commands.
+    bool defragment()
+    {
+        bool moved = vertices_.defragment();
+        moved |= indices_.defragment();
+        moved |= short_indices_.defragment();
+
+        // The blocks now use new buffers, so the VAOs must be recreated
+        if (moved)
+        {
+            vaos_.clear();
+        }
+        return moved;
+    }
+
+    const gl::BufferArena& get_vertex_arena() const
+    {
+        return vertices_;
+    }
+
+    const gl::BufferArena& get_index_arena(bool short_indices) const
+    {
+        return short_indices ? short_indices_ : indices_;
+    }
+
+  private:
+    MeshArena() = default;
+
+    gl::BufferArena& get_index_arena(bool short_indices)
+    {
+        return short_indices ? short_indices_ : indices_;
+    }
+
+    gl::BufferArena vertices_{sizeof(StoredVertex), BLOCK_SIZE_BYTES / sizeof(StoredVertex)};
+    gl::BufferArena indices_{sizeof(GLuint), BLOCK_SIZE_BYTES / sizeof(GLuint)};
+    gl::BufferArena short_indices_{sizeof(GLushort), BLOCK_SIZE_BYTES / sizeof(GLushort)};
+
+    std::map<MeshBlockKey, gl::VertexArrayObject> vaos_;
+
+    /// Scratch space for converting vertices and indices to their GPU layout
+    std::vector<StoredVertex> packed_vertices_;
+    std::vector<GLushort> short_indices_scratch_;
+};
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Mesh.h"
+
+/// Layout of a single draw as expected by glMultiDrawElementsIndirect
+struct DrawElementsIndirectCommand
+{
+    GLuint count = 0;
+    GLuint instance_count = 1;
+    GLuint first_index = 0;
+    GLint base_vertex = 0;
+    GLuint base_instance = 0;
+};
+
+/// A range of commands in a MeshBatch's command buffer
+struct DrawCommandRange
+{
+    GLsizei first = 0;
+    GLsizei count = 0;
+};
+
+/**
+ * @brief Draws many meshes stored in the MeshArena using glMultiDrawElementsIndirect, rather than
+ * binding and drawing each mesh separately.
+ *
+ * The batch only holds a draw command per mesh, pointing at where the mesh is stored in the arena,
+ * so no geometry is copied. Commands are sorted by the arena blocks the meshes are stored in, and
+ * one multi-draw is issued per group of blocks (which for most levels is a single group, or two
+ * when some meshes need 32 bit indices).
+ *
+ * Each mesh is identified by an ID, which is passed as the command's base instance so shaders can
+ * read it using gl_BaseInstance (eg for the picker shader).
+ *
+ * Adding or removing meshes requires the batch to be rebuilt (clear, add, buffer), as does moving
+ * the meshes within the arena (eg by defragmenting it). Meshes that are updated without moving can
+ * be updated in place.
+ */
+template <typename Vertex>
+class MeshBatch
+{
+  public:
+    /// Removes all meshes, ready to be rebuilt
+    void clear();
+
+    /// Adds a draw command for the mesh. This is not uploaded until "buffer" is called. The mesh
+    /// must have been buffered.
+    void add(ObjectId id, const Mesh<Vertex>& mesh);
+
+    /// Uploads the draw commands of the meshes added since the last "clear"
+    void buffer();
+
+    /// Updates the draw command of the given mesh after its geometry has been updated. Returns
+    /// false if the mesh has moved to different arena blocks or is not in the batch, in which case
+    /// the batch must be rebuilt.
+    bool try_update(ObjectId id, const Mesh<Vertex>& mesh);
+
+    /// Writes the draw commands such that the meshes matching the predicate are in the first range,
+    /// and the rest are in the second range. This enables drawing the two groups with different
+    /// state, such as the selected objects.
+    template <typename Predicate>
+    std::pair<DrawCommandRange, DrawCommandRange> partition(Predicate predicate);
+
+    /// Same as "partition", but meshes not matching the filter are left out of both ranges (eg to
+    /// skip meshes outside of the camera's view)
+    template <typename Predicate, typename Filter>
+    std::pair<DrawCommandRange, DrawCommandRange> partition(Predicate predicate, Filter filter);
+
+    /// Draws every mesh in the batch
+    void draw() const;
+
+    /// Draws the given range of commands, as returned by "partition"
+    void draw(DrawCommandRange range) const;
+
+    bool empty() const
+    {
+        return commands_.empty();
+    }
+
+  private:
+    /// The arena blocks used by the command at the given index of the command buffer
+    const MeshBlockKey& get_block(GLsizei command_index) const;
+
+    void draw_commands(GLsizei command_offset, GLsizei count) const;
+
+    /// Holds the commands to draw every mesh, followed by space for the commands written by
+    /// "partition"
+    gl::BufferObject command_buffer_;
+
+    /// One command per mesh, in the same order as the start of the command buffer
+    std::vector<DrawElementsIndirectCommand> commands_;
+    std::vector<MeshBlockKey> blocks_;
+    std::unordered_map<ObjectId, size_t> command_indices_;
+
+    /// Reused when writing partitioned commands to avoid allocating every frame
+    std::vector<DrawElementsIndirectCommand> partitioned_commands_;
+    std::vector<MeshBlockKey> partitioned_blocks_;
+    std::vector<size_t> partition_order_;
+};
+
+template <typename Vertex>
+void MeshBatch<Vertex>::clear()
+{
+    commands_.clear();
+    blocks_.clear();
+    command_indices_.clear();
+}
+
+template <typename Vertex>
+void MeshBatch<Vertex>::add(ObjectId id, const Mesh<Vertex>& mesh)
+{
+    if (!mesh.has_buffered() || mesh.indices_count() == 0)
+    {
+        return;
+    }
+
+    auto location = mesh.get_location();
+    commands_.push_back({
+        .count = mesh.indices_count(),
+        .first_index = location.first_index,
+        .base_vertex = location.base_vertex,
+        .base_instance = static_cast<GLuint>(id),
+    });
+    blocks_.push_back(location.block);
+}
+
+template <typename Vertex>
+void MeshBatch<Vertex>::buffer()
+{
+    command_buffer_.reset();
+    command_indices_.clear();
+
+    if (commands_.empty())
+    {
+        return;
+    }
+
+    // Sort by block such that each block's commands can be drawn with a single multi-draw
+    std::vector<size_t> order(commands_.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        order[i] = i;
+    }
+    std::ranges::stable_sort(order, {}, [&](size_t i) { return blocks_[i]; });
+
+    std::vector<DrawElementsIndirectCommand> sorted_commands;
+    std::vector<MeshBlockKey> sorted_blocks;
+    sorted_commands.reserve(order.size());
+    sorted_blocks.reserve(order.size());
+    for (auto i : order)
+    {
+        command_indices_[static_cast<ObjectId>(commands_[i].base_instance)] =
+            sorted_commands.size();
+        sorted_commands.push_back(commands_[i]);
+        sorted_blocks.push_back(blocks_[i]);
+    }
+    commands_ = std::move(sorted_commands);
+    blocks_ = std::move(sorted_blocks);
+
+    command_buffer_.create_store(sizeof(DrawElementsIndirectCommand) * commands_.size() * 2);
+    command_buffer_.buffer_sub_data(0, commands_);
+}
+
+template <typename Vertex>
+bool MeshBatch<Vertex>::try_update(ObjectId id, const Mesh<Vertex>& mesh)
+{
+    auto itr = command_indices_.find(id);
+    if (itr == command_indices_.end() || !mesh.has_buffered() || mesh.indices_count() == 0)
+    {
+        return false;
+    }
+
+    auto location = mesh.get_location();
+    if (location.block != blocks_[itr->second])
+    {
+        return false;
+    }
+
+    auto& command = commands_[itr->second];
+    command.count = mesh.indices_count();
+    command.first_index = location.first_index;
+    command.base_vertex = location.base_vertex;
+    command_buffer_.buffer_sub_data(sizeof(DrawElementsIndirectCommand) * itr->second, command);
+    return true;
+}
+
+template <typename Vertex>
+template <typename Predicate>
+std::pair<DrawCommandRange, DrawCommandRange> MeshBatch<Vertex>::partition(Predicate predicate)
+{
+    return partition(predicate, [](ObjectId) { return true; });
+}
+
+template <typename Vertex>
+template <typename Predicate, typename Filter>
+std::pair<DrawCommandRange, DrawCommandRange> MeshBatch<Vertex>::partition(Predicate predicate,
+                                                                           Filter filter)
+{
+    partition_order_.clear();
+    for (size_t i = 0; i < commands_.size(); i++)
+    {
+        if (filter(static_cast<ObjectId>(commands_[i].base_instance)))
+        {
+            partition_order_.push_back(i);
+        }
+    }
+
+    // Stable such that each range stays sorted by block
+    auto middle = std::stable_partition(
+        partition_order_.begin(), partition_order_.end(), [&](size_t i)
+        { return predicate(static_cast<ObjectId>(commands_[i].base_instance)); });
+
+    partitioned_commands_.clear();
+    partitioned_blocks_.clear();
+    for (auto i : partition_order_)
+    {
+        partitioned_commands_.push_back(commands_[i]);
+        partitioned_blocks_.push_back(blocks_[i]);
+    }
+
+    if (!partitioned_commands_.empty())
+    {
+        command_buffer_.buffer_sub_data(sizeof(DrawElementsIndirectCommand) * commands_.size(),
+                                        partitioned_commands_);
+    }
+
+    auto first_count = static_cast<GLsizei>(middle - partition_order_.begin());
+    auto total = static_cast<GLsizei>(commands_.size());
+    auto written = static_cast<GLsizei>(partition_order_.size());
+    return {
+        DrawCommandRange{.first = total, .count = first_count},
+        DrawCommandRange{.first = total + first_count, .count = written - first_count},
+    };
+}
+
+template <typename Vertex>
+void MeshBatch<Vertex>::draw() const
+{
+    draw_commands(0, static_cast<GLsizei>(commands_.size()));
+}
+
+template <typename Vertex>
+void MeshBatch<Vertex>::draw(DrawCommandRange range) const
+{
+    draw_commands(range.first, range.count);
+}
+
+template <typename Vertex>
+const MeshBlockKey& MeshBatch<Vertex>::get_block(GLsizei command_index) const
+{
+    auto total = static_cast<GLsizei>(blocks_.size());
+    return command_index < total ? blocks_[command_index]
+                                 : partitioned_blocks_[command_index - total];
+}
+
+template <typename Vertex>
+void MeshBatch<Vertex>::draw_commands(GLsizei command_offset, GLsizei count) const
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, command_buffer_.id);
+
+    // Draw each run of commands that use the same blocks, and hence the same VAO
+    auto& arena = MeshArena<Vertex>::get();
+    auto end = command_offset + count;
+    for (auto first = command_offset; first < end;)
+    {
+        const auto& block = get_block(first);
+        auto last = first + 1;
+        while (last < end && get_block(last) == block)
+        {
+            last++;
+        }
+
+        arena.bind(block);
+        glMultiDrawElementsIndirect(
+            GL_TRIANGLES, block.index_type,
+            reinterpret_cast<const void*>(first * sizeof(DrawElementsIndirectCommand)),
+            last - first, 0);
+        first = last;
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
+
+#include "Mesh.h"
+
+/**
+ * @brief Appends geometry to vertex and index buffers owned by the caller, such that generating a
+ * mesh reuses the capacity of existing buffers rather than allocating new ones each time.
+ *
+ * Indices are given relative to the first vertex added through the builder, so several generators
+ * can append into the same buffers without knowing what is already in them.
+ */
+template <typename Vertex>
+class MeshBuilder
+{
+  public:
+    MeshBuilder(std::vector<Vertex>& vertices, std::vector<GLuint>& indices)
+        : p_vertices_(&vertices)
+        , p_indices_(&indices)
+        , base_vertex_(static_cast<GLuint>(vertices.size()))
+    {
+    }
+
+    /// Appends to the mesh's existing geometry. Use Mesh::clear first to replace it instead.
+    explicit MeshBuilder(Mesh<Vertex>& mesh)
+        : MeshBuilder(mesh.vertices, mesh.indices)
+    {
+    }
+
+    /// Ensures the given number of vertices and indices can be added without reallocating. Capacity
+    /// still grows geometrically so that many small reserves do not reallocate each time.
+    void reserve(size_t vertex_count, size_t index_count)
+    {
+        grow(*p_vertices_, vertex_count);
+        grow(*p_indices_, index_count);
+    }
+
+    void add_vertex(const Vertex& vertex)
+    {
+        p_vertices_->push_back(vertex);
+    }
+
+    void add_vertices(std::initializer_list<Vertex> vertices)
+    {
+        p_vertices_->insert(p_vertices_->end(), vertices);
+    }
+
+    /// Adds an index relative to the first vertex added through this builder
+    void add_index(GLuint index)
+    {
+        p_indices_->push_back(base_vertex_ + index);
+    }
+
+    void add_indices(std::initializer_list<GLuint> indices)
+    {
+        grow(*p_indices_, indices.size());
+        for (auto index : indices)
+        {
+            p_indices_->push_back(base_vertex_ + index);
+        }
+    }
+
+    /// Adds two triangles for the quad made from the four vertices starting at "first"
+    void add_quad_indices(GLuint first)
+    {
+        add_indices({first, first + 1, first + 2, first + 2, first + 3, first});
+    }
+
+    /// The number of vertices added through this builder, which is the index of the next vertex
+    GLuint vertex_count() const
+    {
+        return static_cast<GLuint>(p_vertices_->size()) - base_vertex_;
+    }
+
+  private:
+    template <typename T>
+    static void grow(std::vector<T>& vector, size_t count)
+    {
+        auto required = vector.size() + count;
+        if (required > vector.capacity())
+        {
+            vector.reserve(std::max(required, vector.capacity() * 2));
+        }
+    }
+
+    std::vector<Vertex>* p_vertices_ = nullptr;
+    std::vector<GLuint>* p_indices_ = nullptr;
+    GLuint base_vertex_ = 0;
+};
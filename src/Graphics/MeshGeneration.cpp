@@ -75,12 +75,9 @@ Mesh3D generate_quad_mesh(float w, float h)
     return mesh;
 }
 
-LevelObjectsMesh3D generate_cube_mesh_level(const glm::vec3& start, const glm::vec3& size,
-                                            int texture, glm::u8vec4 colour)
+void generate_cube_mesh_level(MeshBuilder<VertexLevelObjects>& builder, const glm::vec3& start,
+                              const glm::vec3& size, int texture, glm::u8vec4 colour)
 {
-
-    LevelObjectsMesh3D mesh;
-
     float w = size.x;
     float h = size.y;
     float d = size.z;
@@ -89,8 +86,10 @@ LevelObjectsMesh3D generate_cube_mesh_level(const glm::vec3& start, const glm::v
     float y = start.y;
     float z = start.z;
 
+    builder.reserve(24, 36);
+
     // clang-format off
-    mesh.vertices = {
+    builder.add_vertices({
         {{x + w, y + h, z + d}, {w, 0.0f, texture}, FORWARD,  colour},
         {{x    , y + h, z + d}, {0.0f, 0.0f, texture}, FORWARD,  colour},
         {{x    , y    , z + d}, {0.0f, h, texture}, FORWARD,  colour},
@@ -120,21 +119,21 @@ LevelObjectsMesh3D generate_cube_mesh_level(const glm::vec3& start, const glm::v
         {{x + w, y    , z    }, {0.0f, 0.0f, texture}, DOWN,     colour},
         {{x + w, y    , z + d}, {0.0f, h, texture}, DOWN,     colour},
         {{x    , y    , z + d}, {w, h, texture}, DOWN,     colour},
-    };
+    });
     // clang-format on
 
-    int index = 0;
-    for (int i = 0; i < 6; i++)
+    for (GLuint face = 0; face < 6; face++)
     {
-        mesh.indices.push_back(index);
-        mesh.indices.push_back(index + 1);
-        mesh.indices.push_back(index + 2);
-        mesh.indices.push_back(index + 2);
-        mesh.indices.push_back(index + 3);
-        mesh.indices.push_back(index);
-        index += 4;
+        builder.add_quad_indices(face * 4);
     }
+}
 
+LevelObjectsMesh3D generate_cube_mesh_level(const glm::vec3& start, const glm::vec3& size,
+                                            int texture, glm::u8vec4 colour)
+{
+    LevelObjectsMesh3D mesh;
+    MeshBuilder builder(mesh);
+    generate_cube_mesh_level(builder, start, size, texture, colour);
     return mesh;
 }
 
@@ -424,11 +423,10 @@ Mesh2DWorld generate_line_mesh(const Line& line, glm::u8vec4 colour)
     return mesh;
 }
 
-Mesh2DWorld generate_2d_quad_mesh(glm::vec2 position, glm::vec2 size, float base_texture,
-                                  float world_texture, glm::u8vec4 colour, Direction direction)
+void generate_2d_quad_mesh(MeshBuilder<Vertex2DWorld>& builder, glm::vec2 position, glm::vec2 size,
+                           float base_texture, float world_texture, glm::u8vec4 colour,
+                           Direction direction)
 {
-    Mesh2DWorld mesh;
-
     auto& p = position;
     auto& s = size;
 
@@ -438,17 +436,15 @@ Mesh2DWorld generate_2d_quad_mesh(glm::vec2 position, glm::vec2 size, float base
     float depth = size.y / TILE_SIZE;
 
     // clang-format off
-    mesh.vertices = {
+    builder.add_vertices({
         {.position = {p.x,       p.y      }, .texture_coord = {tex_coords[0].x, tex_coords[0].y, base_texture}, .world_texture_coord = {0,     0,     world_texture}, .colour = colour},
         {.position = {p.x,       p.y + s.y}, .texture_coord = {tex_coords[1].x, tex_coords[1].y, base_texture}, .world_texture_coord = {0,     depth, world_texture}, .colour = colour},
         {.position = {p.x + s.x, p.y + s.y}, .texture_coord = {tex_coords[2].x, tex_coords[2].y, base_texture}, .world_texture_coord = {width, depth, world_texture}, .colour = colour},
         {.position = {p.x + s.x, p.y      }, .texture_coord = {tex_coords[3].x, tex_coords[3].y, base_texture}, .world_texture_coord = {width, 0,     world_texture}, .colour = colour},
-    };
+    });
     // clang-format on
 
-    mesh.indices = {0, 1, 2, 2, 3, 0};
-
-    return mesh;
+    builder.add_indices({0, 1, 2, 2, 3, 0});
 }
 
 std::array<glm::vec2, 3> generate_2d_triangle_vertex_positions(glm::vec2 position, glm::vec2 size,
@@ -464,11 +460,10 @@ std::array<glm::vec2, 3> generate_2d_triangle_vertex_positions(glm::vec2 positio
         direction);
 }
 
-Mesh2DWorld generate_2d_triangle_mesh(glm::vec2 position, glm::vec2 size, float base_texture,
-                                      float world_texture, glm::u8vec4 colour, Direction direction)
+void generate_2d_triangle_mesh(MeshBuilder<Vertex2DWorld>& builder, glm::vec2 position,
+                               glm::vec2 size, float base_texture, float world_texture,
+                               glm::u8vec4 colour, Direction direction)
 {
-    Mesh2DWorld mesh;
-
     auto& p = position;
 
     const auto& tex_coords = direction_to_texture_coords(direction);
@@ -482,23 +477,20 @@ Mesh2DWorld generate_2d_triangle_mesh(glm::vec2 position, glm::vec2 size, float
     glm::vec3 world_tex2{(v[2].x - p.x) / TILE_SIZE, (v[2].y - p.y) / TILE_SIZE, world_texture};
 
     // clang-format off
-    mesh.vertices = {
+    builder.add_vertices({
         {.position = v[0], .texture_coord = {tex_coords[0].x, tex_coords[0].y, base_texture}, .world_texture_coord = world_tex0, .colour = colour},
         {.position = v[1], .texture_coord = {tex_coords[1].x, tex_coords[1].y, base_texture}, .world_texture_coord = world_tex1, .colour = colour},
         {.position = v[2], .texture_coord = {tex_coords[2].x, tex_coords[2].y, base_texture}, .world_texture_coord = world_tex2, .colour = colour},
-    };
+    });
     // clang-format on
 
-    mesh.indices = {0, 1, 2};
-
-    return mesh;
+    builder.add_indices({0, 1, 2});
 }
 
-Mesh2DWorld generate_2d_diamond_mesh(glm::vec2 position, glm::vec2 size, float base_texture,
-                                     float world_texture, glm::u8vec4 colour, Direction direction)
+void generate_2d_diamond_mesh(MeshBuilder<Vertex2DWorld>& builder, glm::vec2 position,
+                              glm::vec2 size, float base_texture, float world_texture,
+                              glm::u8vec4 colour, Direction direction)
 {
-    Mesh2DWorld mesh;
-
     auto& p = position;
     auto& s = size;
 
@@ -508,46 +500,82 @@ Mesh2DWorld generate_2d_diamond_mesh(glm::vec2 position, glm::vec2 size, float b
     float depth = size.y / TILE_SIZE;
 
     // clang-format off
-    mesh.vertices = {
+    builder.add_vertices({
         {.position = {p.x + s.x,     p.y + s.y / 2  }, .texture_coord = {tex_coords[0].x, tex_coords[0].y, base_texture}, .world_texture_coord = {width,     depth / 2, world_texture}, .colour = colour},
         {.position = {p.x + s.x / 2, p.y            }, .texture_coord = {tex_coords[1].x, tex_coords[1].y, base_texture}, .world_texture_coord = {width / 2, 0,         world_texture}, .colour = colour},
         {.position = {p.x,           p.y + s.y / 2  }, .texture_coord = {tex_coords[2].x, tex_coords[2].y, base_texture}, .world_texture_coord = {0,         depth / 2, world_texture}, .colour = colour},
         {.position = {p.x + s.x / 2, p.y + s.y      }, .texture_coord = {tex_coords[3].x, tex_coords[3].y, base_texture}, .world_texture_coord = {width / 2, depth,     world_texture}, .colour = colour},
-    };
+    });
     // clang-format on
 
-    mesh.indices = {0, 1, 2, 2, 3, 0};
-
-    return mesh;
+    builder.add_indices({0, 1, 2, 2, 3, 0});
 }
 
-Mesh2DWorld generate_2d_outline_quad_mesh(glm::vec2 position, glm::vec2 size)
+void generate_2d_outline_quad_mesh(MeshBuilder<Vertex2DWorld>& builder, glm::vec2 position,
+                                   glm::vec2 size)
 {
     glm::u8vec4 colour = {255, 255, 255, 255};
-    Mesh2DWorld mesh;
-    add_line_to_mesh(mesh,
+    builder.reserve(8, 8);
+    add_line_to_mesh(builder,
                      {
                          {position.x, position.y},
                          {position.x + size.x, position.y},
                      },
                      colour);
-    add_line_to_mesh(mesh,
+    add_line_to_mesh(builder,
                      {
                          {position.x + size.x, position.y},
                          {position.x + size.x, position.y + size.y},
                      },
                      colour);
-    add_line_to_mesh(mesh,
+    add_line_to_mesh(builder,
                      {
                          {position.x + size.x, position.y + size.y},
                          {position.x, position.y + size.y},
                      },
                      colour);
-    add_line_to_mesh(mesh,
+    add_line_to_mesh(builder,
                      {
                          {position.x, position.y + size.y},
                          {position.x, position.y},
                      },
                      colour);
+}
+
+// Versions of the generators returning a new mesh, for one-off meshes such as previews
+Mesh2DWorld generate_2d_quad_mesh(glm::vec2 position, glm::vec2 size, float base_texture,
+                                  float world_texture, glm::u8vec4 colour, Direction direction)
+{
+    Mesh2DWorld mesh;
+    MeshBuilder builder(mesh);
+    generate_2d_quad_mesh(builder, position, size, base_texture, world_texture, colour, direction);
+    return mesh;
+}
+
+Mesh2DWorld generate_2d_triangle_mesh(glm::vec2 position, glm::vec2 size, float base_texture,
+                                      float world_texture, glm::u8vec4 colour, Direction direction)
+{
+    Mesh2DWorld mesh;
+    MeshBuilder builder(mesh);
+    generate_2d_triangle_mesh(builder, position, size, base_texture, world_texture, colour,
+                              direction);
+    return mesh;
+}
+
+Mesh2DWorld generate_2d_diamond_mesh(glm::vec2 position, glm::vec2 size, float base_texture,
+                                     float world_texture, glm::u8vec4 colour, Direction direction)
+{
+    Mesh2DWorld mesh;
+    MeshBuilder builder(mesh);
+    generate_2d_diamond_mesh(builder, position, size, base_texture, world_texture, colour,
+                             direction);
+    return mesh;
+}
+
+Mesh2DWorld generate_2d_outline_quad_mesh(glm::vec2 position, glm::vec2 size)
+{
+    Mesh2DWorld mesh;
+    MeshBuilder builder(mesh);
+    generate_2d_outline_quad_mesh(builder, position, size);
     return mesh;
 }
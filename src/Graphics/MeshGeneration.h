@@ -1,12 +1,16 @@
 #pragma once
 
 #include "Mesh.h"
+#include "MeshBuilder.h"
 
 [[nodiscard]] Mesh3D generate_quad_mesh(float w, float h);
 
 [[nodiscard]] LevelObjectsMesh3D generate_cube_mesh_level(const glm::vec3& start,
                                                           const glm::vec3& size, int texture,
                                                           glm::u8vec4 colour = Colour::WHITE);
+void generate_cube_mesh_level(MeshBuilder<VertexLevelObjects>& builder, const glm::vec3& start,
+                              const glm::vec3& size, int texture,
+                              glm::u8vec4 colour = Colour::WHITE);
 
 [[nodiscard]] Mesh3D generate_cube_mesh(const glm::vec3& size, bool repeat_texture = false,
                                         glm::u8vec4 colour = Colour::WHITE);
@@ -31,6 +35,15 @@ void add_line_to_mesh(MeshType& mesh, const Line& line, glm::u8vec4 colour)
     mesh.indices.push_back(static_cast<GLuint>(mesh.indices.size()));
 }
 
+template <typename Vertex>
+void add_line_to_mesh(MeshBuilder<Vertex>& builder, const Line& line, glm::u8vec4 colour)
+{
+    auto first = builder.vertex_count();
+    builder.add_vertex({.position = line.start, .colour = colour});
+    builder.add_vertex({.position = line.end, .colour = colour});
+    builder.add_indices({first, first + 1});
+}
+
 void generate_line_mesh(Mesh2DWorld& mesh, const Line& line, glm::u8vec4 colour);
 void generate_line_mesh(Mesh3D& mesh, const Line3D& line, glm::vec4 colour);
 
@@ -52,6 +65,22 @@ void generate_line_mesh(Mesh3D& mesh, const Line3D& line, glm::vec4 colour);
 
 [[nodiscard]] Mesh2DWorld generate_2d_outline_quad_mesh(glm::vec2 position, glm::vec2 size);
 
+// Versions of the above appending to existing buffers, see MeshBuilder
+void generate_2d_quad_mesh(MeshBuilder<Vertex2DWorld>& builder, glm::vec2 position, glm::vec2 size,
+                           float base_texture, float world_texture = 0,
+                           glm::u8vec4 colour = Colour::WHITE,
+                           Direction direction = Direction::Forward);
+void generate_2d_triangle_mesh(MeshBuilder<Vertex2DWorld>& builder, glm::vec2 position,
+                               glm::vec2 size, float base_texture, float world_texture = 0,
+                               glm::u8vec4 colour = Colour::WHITE,
+                               Direction direction = Direction::Forward);
+void generate_2d_diamond_mesh(MeshBuilder<Vertex2DWorld>& builder, glm::vec2 position,
+                              glm::vec2 size, float base_texture, float world_texture = 0,
+                              glm::u8vec4 colour = Colour::WHITE,
+                              Direction direction = Direction::Forward);
+void generate_2d_outline_quad_mesh(MeshBuilder<Vertex2DWorld>& builder, glm::vec2 position,
+                                   glm::vec2 size);
+
 template <typename T>
 struct NamedQuadVertices
 {
@@ -0,0 +1,194 @@
+#include "BufferArena.h"
+
+#include <algorithm>
+
+namespace gl
+{
+    BufferArena::BufferArena(GLsizeiptr element_size, GLuint block_capacity)
+        : element_size_(element_size)
+        , block_capacity_(block_capacity)
+    {
+    }
+
+    BufferArena::Handle BufferArena::allocate(GLuint count)
+    {
+        assert(count > 0);
+
+        Range range;
+        bool found = false;
+        for (std::uint32_t i = 0; i < blocks_.size() && !found; i++)
+        {
+            found = try_allocate_from(i, count, range);
+        }
+
+        if (!found)
+        {
+            add_block(std::max(count, block_capacity_));
+            try_allocate_from(static_cast<std::uint32_t>(blocks_.size() - 1), count, range);
+        }
+        used_count_ += count;
+
+        Handle handle;
+        if (free_handles_.empty())
+        {
+            handle.index = static_cast<std::uint32_t>(allocations_.size());
+            allocations_.push_back(range);
+        }
+        else
+        {
+            handle.index = free_handles_.back();
+            free_handles_.pop_back();
+            allocations_[handle.index] = range;
+        }
+        return handle;
+    }
+
+    void BufferArena::free(Handle& handle)
+    {
+        if (!handle.is_valid())
+        {
+            return;
+        }
+
+        auto& range = allocations_[handle.index];
+        auto& free_ranges = blocks_[range.block].free_ranges;
+        used_count_ -= range.count;
+
+        // Insert the range back, merging with the free ranges either side of it
+        auto next = std::ranges::lower_bound(free_ranges, range.offset, {}, &FreeRange::offset);
+        auto itr = free_ranges.insert(next, {.offset = range.offset, .count = range.count});
+        if (itr + 1 != free_ranges.end() && itr->offset + itr->count == (itr + 1)->offset)
+        {
+            itr->count += (itr + 1)->count;
+            free_ranges.erase(itr + 1);
+        }
+        if (itr != free_ranges.begin() && (itr - 1)->offset + (itr - 1)->count == itr->offset)
+        {
+            (itr - 1)->count += itr->count;
+            free_ranges.erase(itr);
+        }
+
+        range = {};
+        free_handles_.push_back(handle.index);
+        handle = {};
+    }
+
+    const BufferArena::Range& BufferArena::get(Handle handle) const
+    {
+        assert(handle.is_valid());
+        return allocations_[handle.index];
+    }
+
+    void BufferArena::write(Handle handle, const void* data, GLuint count)
+    {
+        auto& range = get(handle);
+        assert(count <= range.count);
+
+        glNamedBufferSubData(blocks_[range.block].buffer.id, range.offset * element_size_,
+                             count * element_size_, data);
+    }
+
+    const BufferObject& BufferArena::get_buffer(std::uint32_t block) const
+    {
+        return blocks_[block].buffer;
+    }
+
+    size_t BufferArena::block_count() const
+    {
+        return blocks_.size();
+    }
+
+    bool BufferArena::defragment()
+    {
+        bool moved_any = false;
+        for (std::uint32_t i = 0; i < blocks_.size(); i++)
+        {
+            auto& block = blocks_[i];
+
+            // Already compact when the only free space is at the end
+            if (block.free_ranges.empty() ||
+                (block.free_ranges.size() == 1 &&
+                 block.free_ranges[0].offset + block.free_ranges[0].count == block.capacity))
+            {
+                continue;
+            }
+
+            std::vector<Range*> ranges;
+            for (auto& range : allocations_)
+            {
+                if (range.count > 0 && range.block == i)
+                {
+                    ranges.push_back(&range);
+                }
+            }
+            std::ranges::sort(ranges, {}, &Range::offset);
+
+            // Ranges are copied into a new buffer as glCopyNamedBufferSubData does not allow the
+            // source and destination to overlap
+            BufferObject new_buffer;
+            new_buffer.create_store(block.capacity * element_size_);
+
+            GLuint offset = 0;
+            for (auto range : ranges)
+            {
+                glCopyNamedBufferSubData(block.buffer.id, new_buffer.id,
+                                         range->offset * element_size_, offset * element_size_,
+                                         range->count * element_size_);
+                range->offset = offset;
+                offset += range->count;
+            }
+
+            block.buffer = std::move(new_buffer);
+            block.free_ranges.clear();
+            if (offset < block.capacity)
+            {
+                block.free_ranges.push_back({.offset = offset, .count = block.capacity - offset});
+            }
+            moved_any = true;
+        }
+        return moved_any;
+    }
+
+    GLuint BufferArena::used_count() const
+    {
+        return used_count_;
+    }
+
+    GLuint BufferArena::capacity() const
+    {
+        GLuint total = 0;
+        for (auto& block : blocks_)
+        {
+            total += block.capacity;
+        }
+        return total;
+    }
+
+    void BufferArena::add_block(GLuint capacity)
+    {
+        auto& block = blocks_.emplace_back();
+        block.capacity = capacity;
+        block.buffer.create_store(capacity * element_size_);
+        block.free_ranges.push_back({.offset = 0, .count = capacity});
+    }
+
+    bool BufferArena::try_allocate_from(std::uint32_t block_index, GLuint count, Range& out_range)
+    {
+        auto& free_ranges = blocks_[block_index].free_ranges;
+        auto itr = std::ranges::find_if(free_ranges, [&](const FreeRange& free_range)
+                                        { return free_range.count >= count; });
+        if (itr == free_ranges.end())
+        {
+            return false;
+        }
+
+        out_range = {.block = block_index, .offset = itr->offset, .count = count};
+        itr->offset += count;
+        itr->count -= count;
+        if (itr->count == 0)
+        {
+            free_ranges.erase(itr);
+        }
+        return true;
+    }
+} // namespace gl
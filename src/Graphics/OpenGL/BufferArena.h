@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "BufferObject.h"
+
+namespace gl
+{
+    /**
+     * @brief Sub-allocates ranges from a few large buffers, rather than creating a new buffer for
+     * every allocation.
+     *
+     * Sizes and offsets are in elements (eg vertices or indices) rather than bytes, such that the
+     * offsets can be used directly as the base vertex or first index of a draw call.
+     *
+     * Allocations are referred to by handle, as defragmenting moves where they are stored. Use
+     * "get" to find the current location of an allocation.
+     */
+    class BufferArena
+    {
+        static constexpr std::uint32_t INVALID_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+      public:
+        struct Handle
+        {
+            std::uint32_t index = INVALID_INDEX;
+
+            bool is_valid() const
+            {
+                return index != INVALID_INDEX;
+            }
+
+            bool operator==(const Handle& other) const = default;
+        };
+
+        /// Where an allocation is currently stored
+        struct Range
+        {
+            std::uint32_t block = 0;
+            GLuint offset = 0;
+            GLuint count = 0;
+        };
+
+        /**
+         * @brief Construct a new Buffer Arena object
+         *
+         * @param element_size The size in bytes of each element.
+         * @param block_capacity The number of elements each block can hold. Allocations larger than
+         * this get a block of their own.
+         */
+        BufferArena(GLsizeiptr element_size, GLuint block_capacity);
+
+        /// Allocate space for the given number of elements, creating a new block if needed
+        [[nodiscard]] Handle allocate(GLuint count);
+
+        /// Returns the space to the arena and invalidates the handle
+        void free(Handle& handle);
+
+        const Range& get(Handle handle) const;
+
+        /// Writes the data to the start of the allocation. The data must fit within it.
+        template <typename T>
+        void write(Handle handle, const std::vector<T>& data)
+        {
+            static_assert(sizeof(T) > 0);
+            assert(static_cast<GLsizeiptr>(sizeof(T)) == element_size_);
+            write(handle, data.data(), static_cast<GLuint>(data.size()));
+        }
+
+        void write(Handle handle, const void* data, GLuint count);
+
+        const BufferObject& get_buffer(std::uint32_t block) const;
+        size_t block_count() const;
+
+        /// Moves the allocations in each block to the start of the block such that the free space
+        /// is contiguous. Returns true if anything was moved, in which case the moved blocks are
+        /// stored in new buffers so anything referencing them (eg a VAO) must be updated.
+        bool defragment();
+
+        /// The number of elements allocated across all blocks
+        GLuint used_count() const;
+
+        /// The number of elements the blocks can hold in total
+        GLuint capacity() const;
+
+      private:
+        struct FreeRange
+        {
+            GLuint offset = 0;
+            GLuint count = 0;
+        };
+
+        struct Block
+        {
+            BufferObject buffer;
+            GLuint capacity = 0;
+
+            /// Sorted by offset, with neighbouring ranges merged together
+            std::vector<FreeRange> free_ranges;
+        };
+
+        void add_block(GLuint capacity);
+
+        /// Finds the first free range that fits the given count, and takes the space from it
+        bool try_allocate_from(std::uint32_t block_index, GLuint count, Range& out_range);
+
+        std::vector<Block> blocks_;
+
+        /// Indexed by Handle::index
+        std::vector<Range> allocations_;
+        std::vector<std::uint32_t> free_handles_;
+
+        GLsizeiptr element_size_ = 0;
+        GLuint block_capacity_ = 0;
+        GLuint used_count_ = 0;
+    };
+} // namespace gl
@@ -47,6 +47,10 @@ namespace gl
         Int = GL_INT,
         UnsignedInt = GL_UNSIGNED_INT,
         Float = GL_FLOAT,
+        HalfFloat = GL_HALF_FLOAT,
+
+        /// Signed 10 bit XYZ and 2 bit W packed into 32 bits, must be used with a size of 4
+        Int2_10_10_10_Rev = GL_INT_2_10_10_10_REV,
     };
 
     void enable_debugging();
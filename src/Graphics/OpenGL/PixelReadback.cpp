@@ -0,0 +1,101 @@
+#include "PixelReadback.h"
+
+namespace gl
+{
+    namespace
+    {
+        /// Upper bound when forced to wait on a request, to avoid hanging if the GPU is lost
+        constexpr GLuint64 MAX_WAIT_NS = 1'000'000'000;
+
+        /// Only a signalled fence means the buffer can be read without waiting, a timeout does not
+        bool is_finished(GLenum status)
+        {
+            return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+        }
+    } // namespace
+
+    PixelReadback::PixelReadback()
+    {
+        for (auto& slot : slots_)
+        {
+            slot.buffer.create_store(sizeof(GLint));
+        }
+    }
+
+    PixelReadback::~PixelReadback()
+    {
+        for (auto& slot : slots_)
+        {
+            release(slot);
+        }
+    }
+
+    void PixelReadback::request(GLint x, GLint y)
+    {
+        // When every slot is waiting, the oldest is dropped as newer requests are more relevant
+        auto& slot = slots_[next_slot_];
+        next_slot_ = (next_slot_ + 1) % slots_.size();
+        release(slot);
+
+        // With a pixel pack buffer bound, glReadPixels writes into the buffer rather than client
+        // memory, so it does not have to wait for the GPU
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer.id);
+        glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_INT, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        slot.age = 0;
+        slot.sequence = next_sequence_++;
+    }
+
+    std::optional<GLint> PixelReadback::poll(int max_latency_frames)
+    {
+        std::optional<GLint> result;
+        for (auto& slot : slots_)
+        {
+            if (!slot.fence)
+            {
+                continue;
+            }
+
+            bool finished = is_finished(glClientWaitSync(slot.fence, 0, 0));
+
+            // Deliberately stalls until the GPU catches up once a request is older than the
+            // latency allows, so the result is never more than that many frames behind. If the
+            // wait times out, the request is left to be waited on again next frame, as reading
+            // the buffer before the fence is signalled would stall anyway.
+            if (!finished && slot.age >= max_latency_frames)
+            {
+                finished = is_finished(
+                    glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, MAX_WAIT_NS));
+            }
+
+            if (!finished)
+            {
+                slot.age++;
+                continue;
+            }
+
+            // Requests can finish out of order with respect to polling, so older results are
+            // ignored once a newer one has been returned
+            if (slot.sequence > last_returned_sequence_)
+            {
+                GLint value = -1;
+                glGetNamedBufferSubData(slot.buffer.id, 0, sizeof(GLint), &value);
+                last_returned_sequence_ = slot.sequence;
+                result = value;
+            }
+            release(slot);
+        }
+        return result;
+    }
+
+    void PixelReadback::release(Slot& slot)
+    {
+        if (slot.fence)
+        {
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+        }
+    }
+} // namespace gl
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+#include "BufferObject.h"
+
+namespace gl
+{
+    /**
+     * @brief Reads single integer pixels (eg object IDs from the picker framebuffer) back from the
+     * GPU without stalling, using a ring of pixel buffer objects.
+     *
+     * "request" copies the pixel into the next buffer and returns immediately. "poll" returns the
+     * value of the newest request the GPU has finished, only waiting on requests that are older
+     * than the given number of frames. With a latency of 0 this is the same as glReadPixels.
+     */
+    class PixelReadback
+    {
+      public:
+        /// The most requests that can be waiting at once. When full, the oldest is dropped.
+        static constexpr int RING_SIZE = 4;
+
+        PixelReadback();
+        ~PixelReadback();
+
+        PixelReadback(const PixelReadback&) = delete;
+        PixelReadback& operator=(const PixelReadback&) = delete;
+        PixelReadback(PixelReadback&&) = delete;
+        PixelReadback& operator=(PixelReadback&&) = delete;
+
+        /// Reads the pixel at the given position of the current read framebuffer's first colour
+        /// attachment, which must be a single channel integer texture
+        void request(GLint x, GLint y);
+
+        /// Should be called once per frame. Returns the value of the newest finished request, if it
+        /// is newer than the last value returned. Requests that have waited "max_latency_frames"
+        /// polls are waited on, stalling the CPU until the GPU has finished them.
+        [[nodiscard]] std::optional<GLint> poll(int max_latency_frames);
+
+      private:
+        struct Slot
+        {
+            BufferObject buffer;
+            GLsync fence = nullptr;
+
+            /// Number of times this has been polled without finishing
+            int age = 0;
+            std::uint64_t sequence = 0;
+        };
+
+        void release(Slot& slot);
+
+        std::array<Slot, RING_SIZE> slots_;
+        size_t next_slot_ = 0;
+
+        std::uint64_t next_sequence_ = 1;
+        std::uint64_t last_returned_sequence_ = 0;
+    };
+} // namespace gl
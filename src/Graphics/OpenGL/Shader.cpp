@@ -3,6 +3,7 @@
 #include <cstring>
 #include <iostream>
 #include <print>
+#include <type_traits>
 
 #include <glm/gtc/type_ptr.hpp>
 
@@ -239,6 +240,10 @@ namespace gl
         replace_words_.clear();
         replace_words_.shrink_to_fit();
 
+        // Not every shader has these, so they are looked up without reporting missing uniforms
+        model_matrix_ = {program_, glGetUniformLocation(program_, "model_matrix")};
+        normal_matrix_ = {program_, glGetUniformLocation(program_, "normal_matrix")};
+
         return true;
     }
 
@@ -278,6 +283,15 @@ namespace gl
                                   glm::value_ptr(matrix));
     }
 
+    void Shader::set_model_matrix(const glm::mat4& matrix)
+    {
+        model_matrix_.set(matrix);
+        if (normal_matrix_.is_valid())
+        {
+            normal_matrix_.set(glm::transpose(glm::inverse(glm::mat3(matrix))));
+        }
+    }
+
     void Shader::bind_uniform_block_index(const std::string& name, GLuint index)
     {
         glUniformBlockBinding(program_, glGetUniformBlockIndex(program_, name.c_str()), index);
@@ -288,11 +302,12 @@ namespace gl
         auto itr = uniform_locations_.find(name);
         if (itr == uniform_locations_.end())
         {
+            // Missing uniforms are stored as -1 such that they are only reported once, and setting
+            // them does nothing
             auto location = glGetUniformLocation(program_, name.c_str());
             if (location == -1)
             {
                 std::println(std::cerr, "Cannot find uniform location {}'", name);
-                return 0;
             }
             uniform_locations_.insert({name, location});
 
@@ -301,4 +316,46 @@ namespace gl
 
         return itr->second;
     }
+
+    template <typename T>
+    void Uniform<T>::set(const T& value) const
+    {
+        if constexpr (std::is_same_v<T, int> || std::is_same_v<T, bool>)
+        {
+            glProgramUniform1i(program_, location_, value);
+        }
+        else if constexpr (std::is_same_v<T, float>)
+        {
+            glProgramUniform1f(program_, location_, value);
+        }
+        else if constexpr (std::is_same_v<T, glm::vec2>)
+        {
+            glProgramUniform2fv(program_, location_, 1, glm::value_ptr(value));
+        }
+        else if constexpr (std::is_same_v<T, glm::vec3>)
+        {
+            glProgramUniform3fv(program_, location_, 1, glm::value_ptr(value));
+        }
+        else if constexpr (std::is_same_v<T, glm::vec4>)
+        {
+            glProgramUniform4fv(program_, location_, 1, glm::value_ptr(value));
+        }
+        else if constexpr (std::is_same_v<T, glm::mat3>)
+        {
+            glProgramUniformMatrix3fv(program_, location_, 1, GL_FALSE, glm::value_ptr(value));
+        }
+        else if constexpr (std::is_same_v<T, glm::mat4>)
+        {
+            glProgramUniformMatrix4fv(program_, location_, 1, GL_FALSE, glm::value_ptr(value));
+        }
+    }
+
+    template class Uniform<int>;
+    template class Uniform<bool>;
+    template class Uniform<float>;
+    template class Uniform<glm::vec2>;
+    template class Uniform<glm::vec3>;
+    template class Uniform<glm::vec4>;
+    template class Uniform<glm::mat3>;
+    template class Uniform<glm::mat4>;
 } // namespace gl
@@ -34,6 +34,35 @@ namespace gl
         std::unordered_map<std::filesystem::path, std::string> cache_;
     };
 
+    /**
+     * @brief Handle to a uniform with its location already looked up, such that it can be set in
+     * draw loops without looking up the name each time.
+     *
+     * Handles to uniforms that do not exist in the shader are valid to set, but do nothing.
+     */
+    template <typename T>
+    class Uniform
+    {
+      public:
+        Uniform() = default;
+        Uniform(GLuint program, GLint location)
+            : program_(program)
+            , location_(location)
+        {
+        }
+
+        void set(const T& value) const;
+
+        bool is_valid() const
+        {
+            return location_ != -1;
+        }
+
+      private:
+        GLuint program_ = 0;
+        GLint location_ = -1;
+    };
+
     class Shader
     {
       public:
@@ -83,6 +112,18 @@ namespace gl
         void set_uniform(const std::string& name, const glm::vec4& vector);
         void set_uniform(const std::string& name, const glm::mat4& matrix);
 
+        /// Looks up the uniform once, such that it can be set repeatedly without the name lookup of
+        /// set_uniform
+        template <typename T>
+        [[nodiscard]] Uniform<T> get_uniform(const std::string& name)
+        {
+            return {program_, get_uniform_location(name)};
+        }
+
+        /// Sets the "model_matrix" uniform, and if the shader has one, the "normal_matrix" uniform
+        /// calculated from it. This avoids the shader calculating the normal matrix per vertex.
+        void set_model_matrix(const glm::mat4& matrix);
+
         /**
          * @brief Bind a uniform block to a specific index in the shader program.
          *
@@ -105,6 +146,10 @@ namespace gl
 
       private:
         std::unordered_map<std::string, GLint> uniform_locations_;
+
+        /// Looked up when linking as most shaders have a model matrix
+        Uniform<glm::mat4> model_matrix_;
+        Uniform<glm::mat3> normal_matrix_;
         std::vector<GLuint> stages_;
         GLuint program_ = 0;
 
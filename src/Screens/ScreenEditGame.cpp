@@ -1,16 +1,20 @@
 #include "ScreenEditGame.h"
 
+#include <chrono>
 #include <fstream>
 #include <ranges>
 
+#include <SFML/System/Clock.hpp>
 #include <imgui.h>
 #include <imgui_stdlib.h>
+#include <magic_enum/magic_enum.hpp>
 
 #include "../Editor/EditConstants.h"
 #include "../Editor/EditorGUI.h"
 #include "../Editor/LevelFileIO.h"
 #include "../Editor/LevelObjects/LevelObjectConcepts.h"
 #include "../Editor/ObjectPropertyEditors/ObjectSizePropertyEditor.h"
+#include "../Editor/SpatialGrid.h"
 #include "../Graphics/OpenGL/GLUtils.h"
 #include "../Util/ImGuiExtras.h"
 #include "../Util/Keyboard.h"
@@ -321,7 +325,7 @@ void ScreenEditGame::on_event(const sf::Event& event)
         // must be recreated
         if (editor_state_.selection.single_object_is_selected())
         {
-            create_property_editors(editor_state_.selection.p_active_object);
+            create_property_editors(get_active_object());
         }
 
         // Prevent unintentionally creating "false walls" when an object has been moved
@@ -350,7 +354,7 @@ void ScreenEditGame::on_event(const sf::Event& event)
                 if (editor_state_.selection.has_selection())
                 {
                     auto [objects, floors] =
-                        level_.copy_objects_and_floors(editor_state_.selection.objects);
+                        level_.copy_objects_and_floors(editor_state_.selection.get_objects());
 
                     action_manager_.push_action(
                         std::make_unique<DeleteObjectAction>(objects, floors));
@@ -388,7 +392,7 @@ void ScreenEditGame::on_event(const sf::Event& event)
                 if (editor_state_.selection.has_selection() && mouse_in_2d_view())
                 {
                     auto [objects, _] =
-                        level_.copy_objects_and_floors(editor_state_.selection.objects);
+                        level_.copy_objects_and_floors(editor_state_.selection.get_objects());
                     auto cached = objects;
                     for (auto& object : objects)
                     {
@@ -399,7 +403,7 @@ void ScreenEditGame::on_event(const sf::Event& event)
                     try_update_object_tools();
 
                     // Ensure property editors are using the new rotation for their UIs
-                    create_property_editors(editor_state_.selection.p_active_object);
+                    create_property_editors(get_active_object());
                 }
                 break;
 
@@ -449,7 +453,7 @@ void ScreenEditGame::on_event(const sf::Event& event)
         {
             auto selection = level_.try_select(
                 map_pixel_to_world({mouse_position_.x, mouse_position_.y}, camera_2d_),
-                editor_state_.selection.p_active_object, editor_state_.current_floor);
+                get_active_object(), editor_state_.current_floor);
 
             if (selection)
             {
@@ -486,6 +490,12 @@ void ScreenEditGame::on_event(const sf::Event& event)
 
 void ScreenEditGame::on_update(const Keyboard& keyboard, sf::Time dt)
 {
+    if (auto result = level_saver_.poll())
+    {
+        on_level_saved(*result);
+    }
+    action_manager_.get_journal().update();
+
     if (showing_dialog())
     {
         return;
@@ -532,7 +542,7 @@ void ScreenEditGame::on_render(bool show_debug)
         drawing_pad_shader_.bind();
         drawing_pad_shader_.set_uniform("projection_matrix", camera_2d_.get_projection_matrix());
         drawing_pad_shader_.set_uniform("view_matrix", camera_2d_.get_view_matrix());
-        drawing_pad_shader_.set_uniform("model_matrix", create_model_matrix({}));
+        drawing_pad_shader_.set_model_matrix(create_model_matrix({}));
         drawing_pad_shader_.set_uniform("use_world_texture",
                                         editor_settings_.show_textures_in_2d_view);
         drawing_pad_shader_.set_uniform("texture_mix", editor_settings_.texture_mix);
@@ -541,7 +551,7 @@ void ScreenEditGame::on_render(bool show_debug)
         world_textures_.bind(1);
 
         // Render level
-        level_.render_2d(drawing_pad_shader_, editor_state_.selection.objects,
+        level_.render_2d(drawing_pad_shader_, editor_state_.selection,
                          editor_state_.current_floor, object_move_handler_.get_move_offset());
 
         // Render the tool preview
@@ -567,13 +577,11 @@ void ScreenEditGame::on_render(bool show_debug)
         drawing_pad_shader_.set_uniform("use_texture_alpha_channel", true);
         drawing_pad_shader_.set_uniform("use_world_texture", false);
 
-        drawing_pad_shader_.set_uniform(
-            "model_matrix",
-            create_model_matrix_orbit(
-                {.position = {camera_3d_.transform.position.x * TILE_SIZE - TILE_SIZE / 4,
-                              camera_3d_.transform.position.z * TILE_SIZE, 0},
-                 .rotation = {0, 0, camera_3d_.transform.rotation.y + 90.0f}},
-                {8, 8, 0}));
+        drawing_pad_shader_.set_model_matrix(create_model_matrix_orbit(
+            {.position = {camera_3d_.transform.position.x * TILE_SIZE - TILE_SIZE / 4,
+                          camera_3d_.transform.position.z * TILE_SIZE, 0},
+             .rotation = {0, 0, camera_3d_.transform.rotation.y + 90.0f}},
+            {8, 8, 0}));
 
         arrow_mesh_.bind().draw_elements();
         gl::disable(gl::Capability::Blend);
@@ -606,8 +614,7 @@ void ScreenEditGame::on_render(bool show_debug)
     if (editor_settings_.render_main_light)
     {
         // Draw main light source position - the cube is 3x3x3 so offset by 1.5
-        scene_shader_.set_uniform(
-            "model_matrix",
+        scene_shader_.set_model_matrix(
             create_model_matrix({.position = main_light.position - glm::vec3{1.5}}));
         sun_mesh_.bind().draw_elements();
     }
@@ -624,7 +631,7 @@ void ScreenEditGame::on_render(bool show_debug)
     world_geometry_shader_.bind();
     world_textures_.bind(0);
     world_geometry_shader_.set_uniform("use_texture", true);
-    world_geometry_shader_.set_uniform("model_matrix", create_model_matrix({}));
+    world_geometry_shader_.set_model_matrix(create_model_matrix({}));
     world_geometry_shader_.set_uniform("main_light_position", main_light.position);
     world_geometry_shader_.set_uniform("main_light_colour", main_light.colour);
     world_geometry_shader_.set_uniform("main_light_brightness", main_light.brightness);
@@ -634,8 +641,13 @@ void ScreenEditGame::on_render(bool show_debug)
     // objects, however, have their positions moved by the given offset for when they are being
     // moved around
     auto offset = object_move_handler_.get_move_offset();
-    level_.render(world_geometry_shader_, editor_state_.selection.objects,
-                  editor_state_.current_floor, {offset.x, 0, offset.y});
+    auto frustum = editor_settings_.frustum_culling
+                       ? std::optional<Frustum>{camera_3d_.get_frustum()}
+                       : std::nullopt;
+
+    auto floor_range = get_floor_range();
+    level_.render(world_geometry_shader_, editor_state_.selection, floor_range,
+                  {offset.x, 0, offset.y}, frustum, editor_settings_.optimise_floor_geometry);
 
     // Draw the current tool preview
     if (!object_move_handler_.is_moving_objects())
@@ -661,9 +673,11 @@ void ScreenEditGame::on_render(bool show_debug)
     if (editor_settings_.render_vertex_normals)
     {
         world_normal_shader_.bind();
-        world_normal_shader_.set_uniform("model_matrix", create_model_matrix({}));
-        level_.render(world_normal_shader_, editor_state_.selection.objects,
-                      editor_state_.current_floor, {offset.x, 0, offset.y});
+        world_normal_shader_.set_model_matrix(create_model_matrix({}));
+        // The normals shader does not support ghosting
+        floor_range.ghost_hidden_floors = false;
+        level_.render(world_normal_shader_, editor_state_.selection, floor_range,
+                      {offset.x, 0, offset.y}, frustum, editor_settings_.optimise_floor_geometry);
     }
 
     //======================================
@@ -674,30 +688,57 @@ void ScreenEditGame::on_render(bool show_debug)
         picker_fbo_.bind(gl::FramebufferTarget::Framebuffer, false);
         picker_shader_.bind();
 
-        GLint clear_value = -1;
-        glClear(GL_DEPTH_BUFFER_BIT);
-        glClearNamedFramebufferiv(picker_fbo_.id, GL_COLOR, 0, &clear_value);
-
         auto window_size = window().getSize();
         glViewport(0, 0, window_size.x / (editor_settings_.show_2d_view ? 2 : 1), window_size.y);
 
+        // Only the pixel under the mouse is ever read, so the scissor test is used to restrict
+        // both the clears and the rasterisation to it
+        gl::enable(gl::Capability::ScissorTest);
+
+        GLint clear_value = -1;
+        auto clear_picker = [&]()
+        {
+            glClear(GL_DEPTH_BUFFER_BIT);
+            glClearNamedFramebufferiv(picker_fbo_.id, GL_COLOR, 0, &clear_value);
+        };
+
         if (mouse_picking_click_state_.enabled)
         {
+            glScissor(mouse_picking_click_state_.point.x, mouse_picking_click_state_.point.y, 1,
+                      1);
+            clear_picker();
+
             // Render the scene to texture's single channel texture containing object IDs
             if (mouse_picking_click_state_.button == sf::Mouse::Button::Right &&
                 mouse_picking_click_state_.action == MousePickingState::Action::ButtonReleased)
             {
-                level_.render_to_picker(picker_shader_);
-
-                // The pixel's value on the image maps to a LevelObject's id value
-                GLint picked_object_id = 0;
-                glReadPixels(mouse_picking_click_state_.point.x, mouse_picking_click_state_.point.y,
-                             1, 1, GL_RED_INTEGER, GL_INT, &picked_object_id);
+                std::optional<ObjectId> picked_object_id;
+                if (editor_settings_.ray_cast_picking)
+                {
+                    // Offset to the centre of the pixel, matching what glReadPixels would sample
+                    auto& point = mouse_picking_click_state_.unscaled_point;
+                    auto ray = camera_3d_.get_mouse_ray({point.x + 0.5f, point.y + 0.5f});
+                    picked_object_id = level_.pick_object(ray, get_floor_range());
+                }
+                else
+                {
+                    level_.render_to_picker(picker_shader_, get_floor_range());
+
+                    // The pixel's value on the image maps to a LevelObject's id value
+                    GLint pixel_id = 0;
+                    glReadPixels(mouse_picking_click_state_.point.x,
+                                 mouse_picking_click_state_.point.y, 1, 1, GL_RED_INTEGER, GL_INT,
+                                 &pixel_id);
+                    if (pixel_id > -1)
+                    {
+                        picked_object_id = pixel_id;
+                    }
+                }
 
-                // If the pixel was non-empty, then try to select the corrsponding object
-                if (picked_object_id > -1)
+                // If an object was picked, then try to select it
+                if (picked_object_id)
                 {
-                    if (auto object = level_.get_object(picked_object_id))
+                    if (auto object = level_.get_object(*picked_object_id))
                     {
                         select_object(object);
                     }
@@ -712,41 +753,51 @@ void ScreenEditGame::on_render(bool show_debug)
             {
                 for (auto& editor : property_editors_)
                 {
-                    glClear(GL_DEPTH_BUFFER_BIT);
-                    glClearNamedFramebufferiv(picker_fbo_.id, GL_COLOR, 0, &clear_value);
+                    clear_picker();
                     editor->render_to_picker(mouse_picking_click_state_, picker_shader_);
                 }
 
-                glClear(GL_DEPTH_BUFFER_BIT);
-                glClearNamedFramebufferiv(picker_fbo_.id, GL_COLOR, 0, &clear_value);
+                clear_picker();
                 object_move_handler_.try_start_move_mouse_picker(
                     mouse_picking_click_state_, picker_shader_, level_, editor_state_,
-                    tool_ ? tool_->get_tool_type() : ToolType::CreateWall, camera_3d_);
+                    tool_ ? tool_->get_tool_type() : ToolType::CreateWall, camera_3d_,
+                    get_floor_range(), editor_settings_.ray_cast_picking);
             }
         }
 
         if (mouse_picking_move_state_.enabled)
         {
+            glScissor(mouse_picking_move_state_.point.x, mouse_picking_move_state_.point.y, 1, 1);
             for (auto& editor : property_editors_)
             {
-                glClear(GL_DEPTH_BUFFER_BIT);
-                glClearNamedFramebufferiv(picker_fbo_.id, GL_COLOR, 0, &clear_value);
+                clear_picker();
                 editor->render_to_picker_mouse_over(mouse_picking_move_state_, picker_shader_);
             }
 
             if (tool_)
             {
-                glClear(GL_DEPTH_BUFFER_BIT);
-                glClearNamedFramebufferiv(picker_fbo_.id, GL_COLOR, 0, &clear_value);
+                clear_picker();
                 tool_->render_to_picker_mouse_over(mouse_picking_move_state_, picker_shader_);
             }
         }
 
+        gl::disable(gl::Capability::ScissorTest);
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
     }
     mouse_picking_move_state_.reset();
     mouse_picking_click_state_.reset();
 
+    // The mouse-over picker results are read back asynchronously, so are collected every frame
+    // even when nothing new was rendered to the picker
+    for (auto& editor : property_editors_)
+    {
+        editor->poll_picker_mouse_over(editor_settings_.max_pick_latency_frames);
+    }
+    if (tool_)
+    {
+        tool_->poll_picker_mouse_over(editor_settings_.max_pick_latency_frames);
+    }
+
     //=============================
     //     Render the ImGUI
     // ============================
@@ -824,7 +875,7 @@ void ScreenEditGame::select_object(LevelObject* object)
 
 void ScreenEditGame::create_property_editors(LevelObject* object)
 {
-    if (!editor_state_.selection.single_object_is_selected())
+    if (!object || !editor_state_.selection.single_object_is_selected())
     {
         return;
     }
@@ -843,15 +894,18 @@ void ScreenEditGame::create_property_editors(LevelObject* object)
         object->object_type);
 }
 
-void ScreenEditGame::exit_editor()
+LevelObject* ScreenEditGame::get_active_object()
 {
-    LevelFileIO level_file_io;
+    auto& active_object = editor_state_.selection.active_object;
+    return active_object ? level_.get_object(*active_object) : nullptr;
+}
 
-    if (level_.serialise(level_file_io))
-    {
-        save_level("backup");
-        level_name_actual_ = level_name_;
-    }
+void ScreenEditGame::exit_editor()
+{
+    // The backup must be written before leaving, so waits rather than saving in the background
+    save_level("backup", get_save_format());
+    wait_for_save();
+    level_name_actual_ = level_name_;
 
     p_screen_manager_->pop_screen();
     window().setMouseCursorVisible(true);
@@ -876,6 +930,19 @@ void ScreenEditGame::decrease_floor()
     offset_camera_to_floor(old_floor);
 }
 
+FloorRange ScreenEditGame::get_floor_range() const
+{
+    if (!editor_settings_.limit_visible_floors)
+    {
+        return {};
+    }
+    return {
+        .min_floor = editor_state_.current_floor - editor_settings_.visible_floors_below,
+        .max_floor = editor_state_.current_floor + editor_settings_.visible_floors_above,
+        .ghost_hidden_floors = editor_settings_.ghost_hidden_floors,
+    };
+}
+
 bool ScreenEditGame::showing_dialog() const
 {
     return show_save_dialog_ || level_file_selector_.is_showing();
@@ -912,8 +979,8 @@ void ScreenEditGame::try_update_object_tools()
         if (current_tool == Type)
         {
 
-            assert(editor_state_.selection.p_active_object);
-            auto active_object = editor_state_.selection.p_active_object;
+            auto active_object = get_active_object();
+            assert(active_object);
             if (auto object = std::get_if<Object>(&active_object->object_type))
             {
                 auto floor = level_.get_object_floor(active_object->object_id);
@@ -931,16 +998,31 @@ void ScreenEditGame::try_update_object_tools()
 
 bool ScreenEditGame::load_level()
 {
+    // The level could be the one being saved, so must finish being written before it is read
+    wait_for_save();
+
+    sf::Clock clock;
     LevelFileIO level_file_io;
     if (!level_file_io.open(level_name_, false))
     {
         return false;
     }
+    auto open_time = clock.restart();
 
     if (!level_.deserialise(level_file_io))
     {
         return false;
     }
+    auto deserialise_time = clock.getElapsedTime();
+    std::println("Loaded {} ({}) in {:.2f}ms - Open: {:.2f}ms, Deserialise: {:.2f}ms", level_name_,
+                 magic_enum::enum_name(level_file_io.get_format()),
+                 (open_time + deserialise_time).asMicroseconds() / 1000.0f,
+                 open_time.asMicroseconds() / 1000.0f,
+                 deserialise_time.asMicroseconds() / 1000.0f);
+
+    // Edits made after the level was last saved are recovered from the journal
+    auto recovered_edits = action_manager_.get_journal().open(
+        make_level_journal_path(level_name_), level_file_io.get_save_id(), level_);
 
     auto& main_light = level_.get_light_settings();
     glClearColor(main_light.sky_colour.r, main_light.sky_colour.g, main_light.sky_colour.b, 1.0f);
@@ -950,6 +1032,11 @@ bool ScreenEditGame::load_level()
     tool_ = std::make_unique<CreateWallTool>(drawing_pad_texture_map_);
 
     messages_manager_.add_message(std::format("Successfully loaded {}.", level_name_));
+    if (recovered_edits > 0)
+    {
+        messages_manager_.add_message(
+            std::format("Recovered {} unsaved edits from the journal.", recovered_edits));
+    }
     return true;
 }
 
@@ -962,24 +1049,108 @@ void ScreenEditGame::save_level()
     }
     else
     {
-        save_level(level_name_);
+        save_level(level_name_, get_save_format());
         level_name_actual_ = level_name_;
 
         show_save_dialog_ = false;
     }
 }
 
-void ScreenEditGame::save_level(const std::string& name)
+void ScreenEditGame::save_level(const std::string& name, LevelFileFormat format)
 {
-    LevelFileIO level_file_io;
+    // Only one save runs at a time, so any previous save must finish first
+    wait_for_save();
 
-    if (level_.serialise(level_file_io))
+    // Only the snapshot is taken on this thread, which is much cheaper than serialising the level
+    sf::Clock clock;
+    auto snapshot = level_.snapshot_floors();
+    if (!snapshot)
     {
-        if (level_file_io.save(name, true))
-        {
-            messages_manager_.add_message(std::format("Successfully saved to {}.", name));
-        }
+        messages_manager_.add_message(std::format("Failed to save {}.", name));
+        return;
+    }
+    auto snapshot_time = clock.getElapsedTime();
+
+    // Identifies the save such that the edit journal is only replayed onto the save it follows
+    auto save_id = static_cast<std::uint64_t>(
+        std::chrono::system_clock::now().time_since_epoch().count());
+    if (name == level_name_)
+    {
+        action_manager_.get_journal().begin_save(make_level_journal_path(name), save_id,
+                                                 *snapshot);
+    }
+
+    level_saver_.start(std::move(*snapshot),
+                       {.level_name = name,
+                        .format = format,
+                        .compression_level = editor_settings_.level_compression_level,
+                        .revision = level_.get_revision(),
+                        .save_id = save_id});
+
+    std::println("Saving {} ({}) - Snapshot: {:.2f}ms", name, magic_enum::enum_name(format),
+                 snapshot_time.asMicroseconds() / 1000.0f);
+    messages_manager_.add_message(std::format("Saving {}...", name));
+}
+
+void ScreenEditGame::export_level_json()
+{
+    wait_for_save();
+
+    auto snapshot = level_.snapshot_floors();
+    if (!snapshot)
+    {
+        messages_manager_.add_message(std::format("Failed to export {}.", level_name_));
+        return;
+    }
+
+    level_saver_.start(std::move(*snapshot), {.level_name = level_name_,
+                                              .format = LevelFileFormat::Json,
+                                              .revision = level_.get_revision(),
+                                              .export_json = true});
+    messages_manager_.add_message(std::format("Exporting {}...", level_name_));
+}
+
+void ScreenEditGame::wait_for_save()
+{
+    if (auto result = level_saver_.wait())
+    {
+        on_level_saved(*result);
+    }
+}
+
+void ScreenEditGame::on_level_saved(const LevelSaveResult& result)
+{
+    auto& name = result.request.level_name;
+    if (result.request.export_json)
+    {
+        messages_manager_.add_message(result.success
+                                          ? std::format("Successfully exported {} to JSON.", name)
+                                          : std::format("Failed to export {}.", name));
+        return;
+    }
+
+    action_manager_.get_journal().end_save(result.success);
+    if (!result.success)
+    {
+        messages_manager_.add_message(std::format("Failed to save {}.", name));
+        return;
     }
+
+    // Edits made while saving are not in the saved level, in which case it remains unsaved
+    level_.mark_saved(result.request.revision);
+
+    std::println("Saved {} ({}) in {:.2f}ms - Serialise: {:.2f}ms, Write: {:.2f}ms", name,
+                 magic_enum::enum_name(result.request.format),
+                 (result.serialise_time + result.write_time).asMicroseconds() / 1000.0f,
+                 result.serialise_time.asMicroseconds() / 1000.0f,
+                 result.write_time.asMicroseconds() / 1000.0f);
+    messages_manager_.add_message(std::format("Successfully saved to {}.", name));
+}
+
+LevelFileFormat ScreenEditGame::get_save_format() const
+{
+    return editor_settings_.save_levels_as_binary ? LevelFileFormat::Binary
+                                                  : LevelFileFormat::Json;
 }
 
 // ---------------------------
@@ -1103,8 +1274,10 @@ void ScreenEditGame::display_editor_gui()
     {
         if (ImGui::Begin("Object Properties"))
         {
-            auto object_updated = editor_state_.selection.p_active_object->property_gui(
-                editor_state_, level_texture_map_, action_manager_);
+            auto active_object = get_active_object();
+            auto object_updated =
+                active_object &&
+                active_object->property_gui(editor_state_, level_texture_map_, action_manager_);
 
             if (object_updated)
             {
@@ -1113,7 +1286,7 @@ void ScreenEditGame::display_editor_gui()
                 // was before.
                 // This ensures that the wall props stay correct
                 try_update_object_tools();
-                create_property_editors(editor_state_.selection.p_active_object);
+                create_property_editors(get_active_object());
             }
         }
         ImGui::End();
@@ -1138,6 +1311,10 @@ void ScreenEditGame::display_menu_bar_gui()
             }
             if (ImGui::MenuItem("Save"))        { save_level();             }
             if (ImGui::MenuItem("Save As..."))  { show_save_dialog_ = true; }
+            if (ImGui::MenuItem("Export JSON", nullptr, false, !level_name_.empty()))
+            {
+                export_level_json();
+            }
             if (ImGui::MenuItem("Exit"))        { exit_editor();            }
             ImGui::EndMenu();
         }
@@ -1176,6 +1353,13 @@ void ScreenEditGame::display_menu_bar_gui()
             ImGui::Checkbox("Display Main Light", &editor_settings_.render_main_light);
             ImGui::Checkbox("Show Level Settings", &editor_settings_.show_level_settings);
             ImGui::Checkbox("Always Show 3D Gizmos", &editor_settings_.always_show_3d_gizmos);
+
+            ImGui::Checkbox("Limit Visible Floors?", &editor_settings_.limit_visible_floors);
+            if (!editor_settings_.limit_visible_floors) ImGui::BeginDisabled();
+            ImGui::SliderInt("Floors Below", &editor_settings_.visible_floors_below, 0, 32);
+            ImGui::SliderInt("Floors Above", &editor_settings_.visible_floors_above, 0, 32);
+            ImGui::Checkbox("Ghost Hidden Floors?", &editor_settings_.ghost_hidden_floors);
+            if (!editor_settings_.limit_visible_floors) ImGui::EndDisabled();
             ImGui::EndMenu();
         }
 
@@ -1185,6 +1369,12 @@ void ScreenEditGame::display_menu_bar_gui()
             ImGui::SliderFloat("Look Sensitivity", &camera_controller_options_3d_.look_sensitivity, 0.01f, 2.0f);
             ImGui::Checkbox("Lock Mouse?", &camera_controller_options_3d_.lock_rotation);
             ImGui::Checkbox("Free camera movement?", &camera_controller_options_3d_.free_movement);
+            ImGui::Checkbox("Ray Cast 3D Selection?", &editor_settings_.ray_cast_picking);
+            ImGui::Checkbox("Frustum Culling?", &editor_settings_.frustum_culling);
+            ImGui::Checkbox("Optimise Floor Geometry?", &editor_settings_.optimise_floor_geometry);
+            ImGui::SliderInt("Max Pick Latency (Frames)", &editor_settings_.max_pick_latency_frames, 0, gl::PixelReadback::RING_SIZE - 1);
+            ImGui::Checkbox("Save Levels As Binary?", &editor_settings_.save_levels_as_binary);
+            ImGui::SliderInt("JSON Compression Level", &editor_settings_.level_compression_level, 1, 9);
             ImGui::EndMenu();
         }
 
@@ -1230,20 +1420,37 @@ void ScreenEditGame::display_debug_gui()
     camera_2d_.gui("2D Camera Options");
 
     // clang-format on
+
+    if (ImGui::Begin("Benchmarks"))
+    {
+        // Results are printed to the console
+        if (ImGui::Button("Spatial Grid"))
+        {
+            benchmark_spatial_grid();
+        }
+        if (ImGui::Button("Picking BVH"))
+        {
+            benchmark_picking_bvh();
+        }
+    }
+    ImGui::End();
+
+    level_.display_mesh_arena_gui();
+    level_.display_render_stats_gui();
 }
 
 void ScreenEditGame::undo()
 {
     action_manager_.undo_action();
     try_set_tool_to_create_wall();
-    create_property_editors(editor_state_.selection.p_active_object);
+    create_property_editors(get_active_object());
 }
 
 void ScreenEditGame::redo()
 {
     action_manager_.redo_action();
     try_set_tool_to_create_wall();
-    create_property_editors(editor_state_.selection.p_active_object);
+    create_property_editors(get_active_object());
 }
 
 bool ScreenEditGame::mouse_in_2d_view() const
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../Editor/Actions.h"
+#include "../Editor/BackgroundLevelSaver.h"
 #include "../Editor/EditConstants.h"
 #include "../Editor/EditorEventHandlers.h"
 #include "../Editor/EditorLevel.h"
@@ -46,6 +47,9 @@ class ScreenEditGame final : public Screen
     /// Creates property editors for the given object that enable editing via the views
     void create_property_editors(LevelObject* object);
 
+    /// Gets the active object of the selection, or nullptr if there is none
+    LevelObject* get_active_object();
+
     /// Exit to the main menu, saving the current level to "backup/backup.cly"
     void exit_editor();
 
@@ -70,11 +74,27 @@ class ScreenEditGame final : public Screen
     void increase_floor();
     void decrease_floor();
 
+    /// The floors shown in the 3D view, which are the only floors that can be picked
+    FloorRange get_floor_range() const;
+
     /// Loads a level from disk (Loads "level_name_")
     bool load_level();
 
-    /// Saves the current level to disk
-    void save_level(const std::string& name);
+    /// Starts saving the current level to disk in the background, which is reported by the
+    /// messages once it has finished
+    void save_level(const std::string& name, LevelFileFormat format);
+
+    /// Writes a JSON copy of the current level in the background, without saving the level itself
+    void export_level_json();
+
+    /// Waits for the level being saved in the background (if any) to finish
+    void wait_for_save();
+
+    /// Marks the level as saved and reports the result of a background save
+    void on_level_saved(const LevelSaveResult& result);
+
+    /// The format levels are saved in by default, set by the editor settings
+    LevelFileFormat get_save_format() const;
 
     // Saves the level or opens the save dialog if a level name has not been seleted
     void save_level();
@@ -169,5 +189,8 @@ class ScreenEditGame final : public Screen
 
     MessagesManager messages_manager_;
 
+    /// Saves the level on a worker thread such that saving does not stall the editor
+    BackgroundLevelSaver level_saver_;
+
     LevelObjectPropertyEditors property_editors_;
 };
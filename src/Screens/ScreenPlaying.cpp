@@ -158,7 +158,7 @@ void ScreenPlaying::render_scene(gl::Shader& shader)
 
     // Draw terrain
     grass_material_.bind(0);
-    shader.set_uniform("model_matrix", create_model_matrix({.position = {-5, 0, -5}}));
+    shader.set_model_matrix(create_model_matrix({.position = {-5, 0, -5}}));
     terrain_mesh_.bind();
     terrain_mesh_.draw_elements();
 }
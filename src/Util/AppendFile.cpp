@@ -0,0 +1,171 @@
+#include "AppendFile.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+AppendFile::~AppendFile()
+{
+    close();
+}
+
+AppendFile::AppendFile(AppendFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+AppendFile& AppendFile::operator=(AppendFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+#ifdef _WIN32
+        p_file_handle_ = std::exchange(other.p_file_handle_, nullptr);
+#else
+        file_ = std::exchange(other.file_, -1);
+#endif
+    }
+    return *this;
+}
+
+bool AppendFile::open(const std::filesystem::path& path, std::uint64_t size)
+{
+    close();
+
+#ifdef _WIN32
+    auto file = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    p_file_handle_ = file;
+
+    LARGE_INTEGER position;
+    position.QuadPart = static_cast<LONGLONG>(size);
+    if (!SetFilePointerEx(file, position, nullptr, FILE_BEGIN) || !SetEndOfFile(file))
+    {
+        close();
+        return false;
+    }
+#else
+    file_ = ::open(path.c_str(), O_WRONLY | O_CREAT, 0644);
+    if (file_ == -1)
+    {
+        return false;
+    }
+
+    if (ftruncate(file_, static_cast<off_t>(size)) == -1 ||
+        lseek(file_, 0, SEEK_END) == static_cast<off_t>(-1))
+    {
+        close();
+        return false;
+    }
+#endif
+    return true;
+}
+
+void AppendFile::close()
+{
+#ifdef _WIN32
+    if (p_file_handle_)
+    {
+        CloseHandle(p_file_handle_);
+    }
+    p_file_handle_ = nullptr;
+#else
+    if (file_ != -1)
+    {
+        ::close(file_);
+    }
+    file_ = -1;
+#endif
+}
+
+bool AppendFile::is_open() const
+{
+#ifdef _WIN32
+    return p_file_handle_ != nullptr;
+#else
+    return file_ != -1;
+#endif
+}
+
+bool AppendFile::append(std::span<const std::byte> data)
+{
+    if (!is_open())
+    {
+        return false;
+    }
+
+    // Writes can be partial, so keep writing until all of the data has been written
+    while (!data.empty())
+    {
+#ifdef _WIN32
+        DWORD written = 0;
+        auto size = static_cast<DWORD>(std::min<std::size_t>(data.size(), 1 << 30));
+        if (!WriteFile(p_file_handle_, data.data(), size, &written, nullptr))
+        {
+            return false;
+        }
+#else
+        auto written = write(file_, data.data(), data.size());
+        if (written == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+#endif
+        data = data.subspan(static_cast<std::size_t>(written));
+    }
+    return true;
+}
+
+bool AppendFile::sync()
+{
+    if (!is_open())
+    {
+        return false;
+    }
+
+#ifdef _WIN32
+    return FlushFileBuffers(p_file_handle_) != 0;
+#else
+    return fsync(file_) == 0;
+#endif
+}
+
+bool sync_file(const std::filesystem::path& path)
+{
+#ifdef _WIN32
+    auto file = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    bool synced = FlushFileBuffers(file) != 0;
+    CloseHandle(file);
+#else
+    auto file = ::open(path.c_str(), O_WRONLY);
+    if (file == -1)
+    {
+        return false;
+    }
+    bool synced = fsync(file) == 0;
+    ::close(file);
+#endif
+    return synced;
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+/// A file that is only ever appended to, which can be synced to disk such that the data appended
+/// so far survives the program or the OS crashing.
+class AppendFile
+{
+  public:
+    AppendFile() = default;
+    ~AppendFile();
+
+    AppendFile(const AppendFile&) = delete;
+    AppendFile& operator=(const AppendFile&) = delete;
+
+    AppendFile(AppendFile&& other) noexcept;
+    AppendFile& operator=(AppendFile&& other) noexcept;
+
+    /// Opens the file for appending, creating it if it does not exist, and closing any file that
+    /// was previously open. The file is truncated to "size" bytes first, such that anything after
+    /// the data that is known to be valid is overwritten.
+    bool open(const std::filesystem::path& path, std::uint64_t size);
+    void close();
+
+    [[nodiscard]] bool is_open() const;
+
+    /// Writes the data to the end of the file. It is only guaranteed to be on disk once synced.
+    bool append(std::span<const std::byte> data);
+
+    /// Blocks until everything appended so far has been written to disk
+    bool sync();
+
+  private:
+#ifdef _WIN32
+    void* p_file_handle_ = nullptr;
+#else
+    int file_ = -1;
+#endif
+};
+
+/// Blocks until the contents of a file that has been written and closed are on disk, such as
+/// before it replaces another file
+bool sync_file(const std::filesystem::path& path);
\ No newline at end of file
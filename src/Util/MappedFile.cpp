@@ -0,0 +1,140 @@
+#include "MappedFile.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        p_data_ = std::exchange(other.p_data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+#ifdef _WIN32
+        p_file_handle_ = std::exchange(other.p_file_handle_, nullptr);
+        p_mapping_handle_ = std::exchange(other.p_mapping_handle_, nullptr);
+#endif
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::filesystem::path& path)
+{
+    close();
+
+#ifdef _WIN32
+    auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    p_file_handle_ = file;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+    {
+        close();
+        return false;
+    }
+
+    p_mapping_handle_ = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!p_mapping_handle_)
+    {
+        close();
+        return false;
+    }
+
+    p_data_ =
+        static_cast<const std::byte*>(MapViewOfFile(p_mapping_handle_, FILE_MAP_READ, 0, 0, 0));
+    if (!p_data_)
+    {
+        close();
+        return false;
+    }
+    size_ = static_cast<std::size_t>(file_size.QuadPart);
+#else
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file == -1)
+    {
+        return false;
+    }
+
+    struct stat file_stat;
+    if (fstat(file, &file_stat) == -1 || file_stat.st_size == 0)
+    {
+        ::close(file);
+        return false;
+    }
+
+    // The mapping keeps its own reference to the file, so the descriptor is not needed after this
+    auto size = static_cast<std::size_t>(file_stat.st_size);
+    auto p_mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+    if (p_mapping == MAP_FAILED)
+    {
+        return false;
+    }
+
+    p_data_ = static_cast<const std::byte*>(p_mapping);
+    size_ = size;
+#endif
+    return true;
+}
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+    if (p_data_)
+    {
+        UnmapViewOfFile(p_data_);
+    }
+    if (p_mapping_handle_)
+    {
+        CloseHandle(p_mapping_handle_);
+    }
+    if (p_file_handle_)
+    {
+        CloseHandle(p_file_handle_);
+    }
+    p_file_handle_ = nullptr;
+    p_mapping_handle_ = nullptr;
+#else
+    if (p_data_)
+    {
+        munmap(const_cast<std::byte*>(p_data_), size_);
+    }
+#endif
+    p_data_ = nullptr;
+    size_ = 0;
+}
+
+bool MappedFile::is_open() const
+{
+    return p_data_ != nullptr;
+}
+
+std::span<const std::byte> MappedFile::data() const
+{
+    return {p_data_, size_};
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+/// A read-only view of a file mapped into memory. The contents are paged in by the OS as they are
+/// accessed rather than copied into a buffer up front.
+class MappedFile
+{
+  public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /// Maps the given file, closing any file that was previously mapped. Returns false if the file
+    /// could not be opened or is empty.
+    bool open(const std::filesystem::path& path);
+    void close();
+
+    [[nodiscard]] bool is_open() const;
+    [[nodiscard]] std::span<const std::byte> data() const;
+
+  private:
+    const std::byte* p_data_ = nullptr;
+    std::size_t size_ = 0;
+
+#ifdef _WIN32
+    void* p_file_handle_ = nullptr;
+    void* p_mapping_handle_ = nullptr;
+#endif
+};
\ No newline at end of file
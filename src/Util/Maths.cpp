@@ -1,5 +1,7 @@
 #include "Maths.h"
 
+#include <algorithm>
+
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/rotate_vector.hpp>
 #include <print>
@@ -12,6 +14,72 @@ Rectangle Line::to_bounds() const
     };
 }
 
+void BoundingBox::expand(const glm::vec3& point)
+{
+    min = glm::min(min, point);
+    max = glm::max(max, point);
+}
+
+void BoundingBox::expand(const BoundingBox& other)
+{
+    min = glm::min(min, other.min);
+    max = glm::max(max, other.max);
+}
+
+bool BoundingBox::is_empty() const
+{
+    return min.x > max.x || min.y > max.y || min.z > max.z;
+}
+
+glm::vec3 BoundingBox::centre() const
+{
+    return (min + max) * 0.5f;
+}
+
+Frustum Frustum::from_matrix(const glm::mat4& projection_view)
+{
+    // glm matrices are column major, so m[column][row]
+    auto row = [&](int i)
+    {
+        return glm::vec4{projection_view[0][i], projection_view[1][i], projection_view[2][i],
+                         projection_view[3][i]};
+    };
+
+    Frustum frustum;
+    frustum.planes = {
+        row(3) + row(0), // Left
+        row(3) - row(0), // Right
+        row(3) + row(1), // Bottom
+        row(3) - row(1), // Top
+        row(3) + row(2), // Near
+        row(3) - row(2), // Far
+    };
+    for (auto& plane : frustum.planes)
+    {
+        plane /= glm::length(glm::vec3{plane});
+    }
+    return frustum;
+}
+
+bool Frustum::is_visible(const BoundingBox& box) const
+{
+    for (auto& plane : planes)
+    {
+        // Test the corner of the box furthest along the plane's normal, if that is behind the plane
+        // then so is the rest of the box
+        glm::vec3 corner{
+            plane.x >= 0 ? box.max.x : box.min.x,
+            plane.y >= 0 ? box.max.y : box.min.y,
+            plane.z >= 0 ? box.max.z : box.min.z,
+        };
+        if (glm::dot(glm::vec3{plane}, corner) + plane.w < 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool Rectangle::is_entirely_within(const Rectangle& other) const
 {
     return other.position.x <= position.x && other.position.y <= position.y &&
@@ -169,6 +237,71 @@ bool point_in_triangle(glm::vec2 point, const std::array<glm::vec2, 3>& triangle
     return !(has_negative && has_positive);
 }
 
+std::optional<float> ray_triangle_intersect(const Ray& ray, const glm::vec3& v0,
+                                            const glm::vec3& v1, const glm::vec3& v2)
+{
+    // Moller-Trumbore intersection, see
+    // https://en.wikipedia.org/wiki/M%C3%B6ller%E2%80%93Trumbore_intersection_algorithm
+    constexpr float EPSILON = 1e-7f;
+
+    glm::vec3 edge1 = v1 - v0;
+    glm::vec3 edge2 = v2 - v0;
+    glm::vec3 p = glm::cross(ray.direction, edge2);
+    float determinant = glm::dot(edge1, p);
+
+    // Ray is parallel to the triangle
+    if (std::abs(determinant) < EPSILON)
+    {
+        return {};
+    }
+    float inverse_determinant = 1.0f / determinant;
+
+    glm::vec3 to_origin = ray.origin - v0;
+    float u = glm::dot(to_origin, p) * inverse_determinant;
+    if (u < 0.0f || u > 1.0f)
+    {
+        return {};
+    }
+
+    glm::vec3 q = glm::cross(to_origin, edge1);
+    float v = glm::dot(ray.direction, q) * inverse_determinant;
+    if (v < 0.0f || u + v > 1.0f)
+    {
+        return {};
+    }
+
+    float t = glm::dot(edge2, q) * inverse_determinant;
+    if (t < 0.0f || t > ray.length)
+    {
+        return {};
+    }
+    return t;
+}
+
+std::optional<float> ray_box_intersect(const Ray& ray, const glm::vec3& inverse_direction,
+                                       const BoundingBox& box)
+{
+    if (box.is_empty())
+    {
+        return {};
+    }
+
+    // Slab test
+    glm::vec3 t1 = (box.min - ray.origin) * inverse_direction;
+    glm::vec3 t2 = (box.max - ray.origin) * inverse_direction;
+
+    glm::vec3 t_near = glm::min(t1, t2);
+    glm::vec3 t_far = glm::max(t1, t2);
+
+    float enter = std::max({t_near.x, t_near.y, t_near.z, 0.0f});
+    float exit = std::min({t_far.x, t_far.y, t_far.z, ray.length});
+    if (enter > exit)
+    {
+        return {};
+    }
+    return enter;
+}
+
 bool point_in_polygon(const glm::vec2& point, const std::vector<glm::vec2>& points,
                       const glm::vec2& points_offset)
 {
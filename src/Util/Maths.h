@@ -1,6 +1,8 @@
 #pragma once
 
 #include <array>
+#include <limits>
+#include <optional>
 #include <vector>
 
 #include <SFML/System/Angle.hpp>
@@ -43,6 +45,8 @@ struct Line
     glm::vec2 end{0};
 
     [[nodiscard]] Rectangle to_bounds() const;
+
+    bool operator==(const Line& other) const = default;
 };
 
 struct Line3D
@@ -51,6 +55,45 @@ struct Line3D
     glm::vec3 end{0};
 };
 
+/// Axis-aligned bounding box. Defaults to an "empty" box such that expanding it by any point
+/// results in a box containing only that point.
+struct BoundingBox
+{
+    glm::vec3 min{std::numeric_limits<float>::max()};
+    glm::vec3 max{std::numeric_limits<float>::lowest()};
+
+    void expand(const glm::vec3& point);
+    void expand(const BoundingBox& other);
+
+    [[nodiscard]] bool is_empty() const;
+    [[nodiscard]] glm::vec3 centre() const;
+};
+
+/// The planes bounding what a camera can see, used to skip drawing objects that are off screen
+struct Frustum
+{
+    /// Each plane is stored as (normal, distance), with the normals pointing into the frustum
+    std::array<glm::vec4, 6> planes{};
+
+    /// Extracts the planes from the given projection * view matrix
+    [[nodiscard]] static Frustum from_matrix(const glm::mat4& projection_view);
+
+    /// Returns false only if the box is entirely outside of the frustum. Boxes near the corners of
+    /// the frustum may be reported as visible, but this is fine for culling.
+    [[nodiscard]] bool is_visible(const BoundingBox& box) const;
+};
+
+struct Ray
+{
+    glm::vec3 origin{0};
+
+    /// Must be normalised
+    glm::vec3 direction{0, 0, 1};
+
+    /// Hits further than this along the ray are ignored
+    float length = std::numeric_limits<float>::max();
+};
+
 [[nodiscard]] glm::mat4 create_model_matrix(const Transform& transform);
 [[nodiscard]] glm::mat4 create_model_matrix_orbit(const Transform& transform,
                                                   const glm::vec3& origin);
@@ -69,5 +112,15 @@ struct Line3D
 
 [[nodiscard]] bool point_in_triangle(glm::vec2 point, const std::array<glm::vec2, 3>& triangle);
 
+/// Returns the distance along the ray to the triangle if it is hit. Both sides of the triangle can
+/// be hit.
+[[nodiscard]] std::optional<float> ray_triangle_intersect(const Ray& ray, const glm::vec3& v0,
+                                                          const glm::vec3& v1, const glm::vec3& v2);
+
+/// Returns the distance along the ray to where it enters the box if it is hit. When the ray starts
+/// inside the box, the distance is 0. The inverse direction is 1 / ray.direction.
+[[nodiscard]] std::optional<float>
+ray_box_intersect(const Ray& ray, const glm::vec3& inverse_direction, const BoundingBox& box);
+
 [[nodiscard]] bool point_in_polygon(const glm::vec2& point, const std::vector<glm::vec2>& points,
                                     const glm::vec2& points_offset = {0, 0});
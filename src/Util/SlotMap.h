@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/// Handle to a value stored in a SlotMap. The generation is used to detect handles to values that
+/// have since been erased, so unlike a pointer or index it is safe to hold across insertions and
+/// removals.
+struct SlotMapHandle
+{
+    std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+    std::uint32_t generation = 0;
+
+    bool operator==(const SlotMapHandle& other) const = default;
+};
+
+/**
+ * @brief Container with O(1) insertion, lookup and removal via generational handles.
+ *
+ * Values are kept tightly packed such that iterating is as fast as iterating a std::vector, at the
+ * cost of the order of values changing when one is erased (The last value is moved into the gap).
+ * Handles go through an indirection table so they stay valid when values are moved around.
+ */
+template <typename T>
+class SlotMap
+{
+    static constexpr std::uint32_t INVALID_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+    struct Slot
+    {
+        /// Index into values_, or INVALID_INDEX when the slot is free
+        std::uint32_t value_index = INVALID_INDEX;
+
+        /// Incremented each time the slot is freed to invalidate any old handles
+        std::uint32_t generation = 0;
+    };
+
+  public:
+    using Handle = SlotMapHandle;
+
+    template <typename... Args>
+    Handle emplace(Args&&... args)
+    {
+        std::uint32_t slot_index = 0;
+        if (free_slots_.empty())
+        {
+            slot_index = static_cast<std::uint32_t>(slots_.size());
+            slots_.emplace_back();
+        }
+        else
+        {
+            slot_index = free_slots_.back();
+            free_slots_.pop_back();
+        }
+
+        auto& slot = slots_[slot_index];
+        slot.value_index = static_cast<std::uint32_t>(values_.size());
+        values_.emplace_back(std::forward<Args>(args)...);
+        value_slots_.push_back(slot_index);
+
+        return {.index = slot_index, .generation = slot.generation};
+    }
+
+    Handle insert(T value)
+    {
+        return emplace(std::move(value));
+    }
+
+    /// Erase the value of the given handle. Returns false if the handle is no longer valid.
+    bool erase(Handle handle)
+    {
+        if (!contains(handle))
+        {
+            return false;
+        }
+        auto& slot = slots_[handle.index];
+        auto value_index = slot.value_index;
+
+        // Move the last value into the gap so the values remain packed
+        if (value_index + 1 != values_.size())
+        {
+            values_[value_index] = std::move(values_.back());
+            value_slots_[value_index] = value_slots_.back();
+            slots_[value_slots_[value_index]].value_index = value_index;
+        }
+        values_.pop_back();
+        value_slots_.pop_back();
+
+        slot.value_index = INVALID_INDEX;
+        slot.generation++;
+        free_slots_.push_back(handle.index);
+        return true;
+    }
+
+    /// Returns nullptr if the handle is no longer valid
+    T* get(Handle handle)
+    {
+        return contains(handle) ? &values_[slots_[handle.index].value_index] : nullptr;
+    }
+
+    const T* get(Handle handle) const
+    {
+        return contains(handle) ? &values_[slots_[handle.index].value_index] : nullptr;
+    }
+
+    bool contains(Handle handle) const
+    {
+        return handle.index < slots_.size() && slots_[handle.index].generation == handle.generation &&
+               slots_[handle.index].value_index != INVALID_INDEX;
+    }
+
+    /// Erases all values. Handles given out before the clear remain invalid afterwards.
+    void clear()
+    {
+        for (auto slot_index : value_slots_)
+        {
+            auto& slot = slots_[slot_index];
+            slot.value_index = INVALID_INDEX;
+            slot.generation++;
+            free_slots_.push_back(slot_index);
+        }
+        values_.clear();
+        value_slots_.clear();
+    }
+
+    void reserve(size_t capacity)
+    {
+        values_.reserve(capacity);
+        value_slots_.reserve(capacity);
+        slots_.reserve(capacity);
+    }
+
+    size_t size() const
+    {
+        return values_.size();
+    }
+
+    bool empty() const
+    {
+        return values_.empty();
+    }
+
+    auto begin()
+    {
+        return values_.begin();
+    }
+
+    auto end()
+    {
+        return values_.end();
+    }
+
+    auto begin() const
+    {
+        return values_.begin();
+    }
+
+    auto end() const
+    {
+        return values_.end();
+    }
+
+  private:
+    /// The packed values
+    std::vector<T> values_;
+
+    /// Maps each value in values_ back to the slot that refers to it, used when moving values
+    std::vector<std::uint32_t> value_slots_;
+
+    std::vector<Slot> slots_;
+    std::vector<std::uint32_t> free_slots_;
+};
@@ -1,9 +1,13 @@
 #include "Util.h"
 
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <thread>
 
 std::string read_file_to_string(const std::filesystem::path& file_path)
 {
@@ -34,6 +38,60 @@ std::vector<std::string> split_string(const std::string& string, char delim)
     return tokens;
 }
 
+void parallel_for(size_t count, const std::function<void(size_t)>& func)
+{
+    auto thread_count = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), count);
+    if (thread_count <= 1)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            func(i);
+        }
+        return;
+    }
+
+    // Indices are handed out one at a time rather than split up front, as the cost of each call
+    // can vary a lot (eg a large polygon platform vs a wall)
+    std::atomic<size_t> next_index = 0;
+    std::exception_ptr exception;
+    std::mutex exception_mutex;
+
+    auto worker = [&]()
+    {
+        for (auto i = next_index++; i < count; i = next_index++)
+        {
+            try
+            {
+                func(i);
+            }
+            catch (...)
+            {
+                std::scoped_lock lock(exception_mutex);
+                if (!exception)
+                {
+                    exception = std::current_exception();
+                }
+            }
+        }
+    };
+
+    {
+        // The calling thread does its share of the work rather than waiting
+        std::vector<std::jthread> threads;
+        threads.reserve(thread_count - 1);
+        for (size_t i = 0; i < thread_count - 1; i++)
+        {
+            threads.emplace_back(worker);
+        }
+        worker();
+    }
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
 epoch_t get_epoch()
 {
     using namespace std::chrono;
@@ -2,6 +2,7 @@
 
 #include <deque>
 #include <filesystem>
+#include <functional>
 #include <iostream>
 #include <string_view>
 #include <vector>
@@ -66,5 +67,9 @@ constexpr inline auto rgb_to_normalised(const glm::vec3& rgb)
     return glm::vec4(rgb / 255.0f, 1.0f);
 }
 
+/// Calls "func" for every index in [0, count), spread across a thread per core. Blocks until every
+/// call has finished, so "func" must be safe to call concurrently with different indices.
+void parallel_for(size_t count, const std::function<void(size_t)>& func);
+
 epoch_t get_epoch();
 std::string epoch_to_datetime_string(epoch_t epoch);
\ No newline at end of file
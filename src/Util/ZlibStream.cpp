@@ -0,0 +1,452 @@
+#include "ZlibStream.h"
+
+#include <algorithm>
+#include <iostream>
+#include <print>
+#include <thread>
+
+namespace
+{
+    constexpr std::array<char, 4> INDEX_MAGIC = {'C', 'L', 'Y', 'I'};
+
+    /// The 2 byte zlib header before the deflate data, and the adler-32 checksum after it
+    constexpr std::uint64_t ZLIB_HEADER_SIZE = 2;
+    constexpr std::uint64_t ZLIB_CHECKSUM_SIZE = 4;
+
+    /// The block count and magic at the very end of the file
+    constexpr std::uint64_t INDEX_FOOTER_SIZE = 8;
+    constexpr std::uint64_t INDEX_ENTRY_SIZE = 8;
+
+    /// Enough blocks to keep every thread busy while the oldest block is being written or read
+    std::size_t get_max_blocks_in_flight()
+    {
+        return std::max(std::thread::hardware_concurrency(), 1u) * 2;
+    }
+
+    std::array<char, 2> make_zlib_header(int compression_level)
+    {
+        // Deflate with a 32K window, with the level flags set the same as zlib would
+        if (compression_level == Z_DEFAULT_COMPRESSION)
+        {
+            compression_level = 6;
+        }
+        unsigned level_flags = compression_level < 2   ? 0
+                               : compression_level < 6 ? 1
+                               : compression_level == 6 ? 2
+                                                        : 3;
+        unsigned header = (0x78 << 8) | (level_flags << 6);
+        header += 31 - header % 31;
+        return {static_cast<char>(header >> 8), static_cast<char>(header & 0xff)};
+    }
+
+    void append_u32(std::vector<char>& output, std::uint32_t value)
+    {
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            output.push_back(static_cast<char>((value >> shift) & 0xff));
+        }
+    }
+
+    std::uint32_t read_u32(const char* p_data)
+    {
+        std::uint32_t value = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            value |= static_cast<std::uint32_t>(static_cast<unsigned char>(p_data[i])) << (i * 8);
+        }
+        return value;
+    }
+} // namespace
+
+// =======================================
+//      DeflateStreamBuffer
+// =======================================
+DeflateStreamBuffer::DeflateStreamBuffer(const std::filesystem::path& path, int compression_level)
+    : file_(path, std::ios::binary)
+    , compression_level_(compression_level)
+    , max_blocks_compressing_(get_max_blocks_in_flight())
+{
+    auto header = make_zlib_header(compression_level);
+    file_.write(header.data(), header.size());
+    has_error_ = !file_;
+
+    block_.resize(BLOCK_SIZE);
+    setp(block_.data(), block_.data() + block_.size());
+}
+
+DeflateStreamBuffer::~DeflateStreamBuffer()
+{
+    finish();
+}
+
+bool DeflateStreamBuffer::finish()
+{
+    if (is_finished_)
+    {
+        return !has_error_;
+    }
+
+    submit_block(true);
+    while (!compressing_.empty())
+    {
+        write_next_block();
+    }
+    is_finished_ = true;
+
+    // The checksum ending the zlib stream is big endian, unlike the index
+    std::vector<char> trailer;
+    for (int shift = 24; shift >= 0; shift -= 8)
+    {
+        trailer.push_back(static_cast<char>((adler_ >> shift) & 0xff));
+    }
+    for (auto& [compressed_size, uncompressed_size] : index_)
+    {
+        append_u32(trailer, compressed_size);
+        append_u32(trailer, uncompressed_size);
+    }
+    append_u32(trailer, static_cast<std::uint32_t>(index_.size()));
+    trailer.insert(trailer.end(), INDEX_MAGIC.begin(), INDEX_MAGIC.end());
+
+    file_.write(trailer.data(), trailer.size());
+    file_.flush();
+    has_error_ |= !file_;
+    return !has_error_;
+}
+
+std::size_t DeflateStreamBuffer::get_uncompressed_size() const
+{
+    return uncompressed_size_;
+}
+
+DeflateStreamBuffer::int_type DeflateStreamBuffer::overflow(int_type ch)
+{
+    if (is_finished_ || has_error_)
+    {
+        return traits_type::eof();
+    }
+
+    submit_block(false);
+    if (!traits_type::eq_int_type(ch, traits_type::eof()))
+    {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+void DeflateStreamBuffer::submit_block(bool is_final)
+{
+    block_.resize(pptr() - pbase());
+    uncompressed_size_ += block_.size();
+
+    auto compress_block = [level = compression_level_, is_final, input = std::move(block_)]()
+    {
+        CompressedBlock block;
+        block.uncompressed_size = static_cast<std::uint32_t>(input.size());
+        block.adler = adler32(adler32(0L, Z_NULL, 0), reinterpret_cast<const Bytef*>(input.data()),
+                              static_cast<uInt>(input.size()));
+
+        // Raw deflate, as the zlib header and checksum are written once for the whole file
+        z_stream stream{};
+        if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+            return block;
+        }
+
+        // Extra space is needed for the empty block that flushing ends with
+        block.data.resize(deflateBound(&stream, static_cast<uLong>(input.size())) + 16);
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+        stream.avail_in = static_cast<uInt>(input.size());
+        stream.next_out = reinterpret_cast<Bytef*>(block.data.data());
+        stream.avail_out = static_cast<uInt>(block.data.size());
+
+        // Every block other than the last is flushed to a byte boundary without ending the
+        // stream, such that the next block can be appended straight after it
+        auto result = deflate(&stream, is_final ? Z_FINISH : Z_FULL_FLUSH);
+        block.is_valid = stream.avail_in == 0 && result == (is_final ? Z_STREAM_END : Z_OK);
+        block.data.resize(stream.total_out);
+        deflateEnd(&stream);
+        return block;
+    };
+    compressing_.push_back(std::async(std::launch::async, std::move(compress_block)));
+
+    // Bounds the memory used no matter how quickly data is written
+    while (compressing_.size() > max_blocks_compressing_)
+    {
+        write_next_block();
+    }
+
+    if (is_final)
+    {
+        setp(nullptr, nullptr);
+    }
+    else
+    {
+        block_ = std::vector<char>(BLOCK_SIZE);
+        setp(block_.data(), block_.data() + block_.size());
+    }
+}
+
+void DeflateStreamBuffer::write_next_block()
+{
+    auto block = compressing_.front().get();
+    compressing_.pop_front();
+    if (!block.is_valid || has_error_)
+    {
+        has_error_ = true;
+        return;
+    }
+
+    file_.write(block.data.data(), block.data.size());
+    adler_ = adler32_combine(adler_, block.adler, block.uncompressed_size);
+    index_.push_back({static_cast<std::uint32_t>(block.data.size()), block.uncompressed_size});
+}
+
+// =======================================
+//      InflateStreamBuffer
+// =======================================
+InflateStreamBuffer::InflateStreamBuffer(const std::filesystem::path& path)
+    : file_(path, std::ios::binary)
+    , max_blocks_inflating_(get_max_blocks_in_flight())
+{
+    // Files without an index, such as those compressed in one go before it was added, are read as
+    // a single stream
+    if (file_.is_open() && !read_block_index())
+    {
+        stream_initialised_ = inflateInit(&stream_) == Z_OK;
+        has_error_ = !stream_initialised_;
+    }
+
+    // Empty until the first read
+    setg(decompressed_.data(), decompressed_.data(), decompressed_.data());
+}
+
+InflateStreamBuffer::~InflateStreamBuffer()
+{
+    if (stream_initialised_)
+    {
+        inflateEnd(&stream_);
+    }
+}
+
+bool InflateStreamBuffer::is_open() const
+{
+    return file_.is_open();
+}
+
+bool InflateStreamBuffer::has_error() const
+{
+    return has_error_;
+}
+
+InflateStreamBuffer::int_type InflateStreamBuffer::underflow()
+{
+    if (gptr() < egptr())
+    {
+        return traits_type::to_int_type(*gptr());
+    }
+    if (has_error_)
+    {
+        return traits_type::eof();
+    }
+    return index_.empty() ? underflow_stream() : underflow_blocks();
+}
+
+bool InflateStreamBuffer::read_block_index()
+{
+    auto reset = [&]()
+    {
+        index_.clear();
+        file_.clear();
+        file_.seekg(0);
+        return false;
+    };
+
+    file_.seekg(0, std::ios::end);
+    auto file_size = static_cast<std::uint64_t>(file_.tellg());
+    if (!file_ || file_size < ZLIB_HEADER_SIZE + ZLIB_CHECKSUM_SIZE + INDEX_FOOTER_SIZE)
+    {
+        return reset();
+    }
+
+    std::array<char, INDEX_FOOTER_SIZE> footer;
+    file_.seekg(file_size - INDEX_FOOTER_SIZE);
+    file_.read(footer.data(), footer.size());
+    if (!file_ || !std::equal(INDEX_MAGIC.begin(), INDEX_MAGIC.end(), footer.begin() + 4))
+    {
+        return reset();
+    }
+
+    auto index_size = std::uint64_t{read_u32(footer.data())} * INDEX_ENTRY_SIZE;
+    if (file_size < ZLIB_HEADER_SIZE + ZLIB_CHECKSUM_SIZE + index_size + INDEX_FOOTER_SIZE)
+    {
+        return reset();
+    }
+
+    // The checksum and index are read together as they are stored next to each other
+    std::vector<char> trailer(ZLIB_CHECKSUM_SIZE + index_size);
+    file_.seekg(file_size - INDEX_FOOTER_SIZE - trailer.size());
+    file_.read(trailer.data(), trailer.size());
+    if (!file_)
+    {
+        return reset();
+    }
+
+    expected_adler_ = 0;
+    for (std::size_t i = 0; i < ZLIB_CHECKSUM_SIZE; i++)
+    {
+        expected_adler_ = (expected_adler_ << 8) | static_cast<unsigned char>(trailer[i]);
+    }
+
+    std::uint64_t compressed_size = 0;
+    for (std::uint64_t offset = ZLIB_CHECKSUM_SIZE; offset < trailer.size();
+         offset += INDEX_ENTRY_SIZE)
+    {
+        auto& entry = index_.emplace_back();
+        entry[0] = read_u32(trailer.data() + offset);
+        entry[1] = read_u32(trailer.data() + offset + 4);
+        compressed_size += entry[0];
+    }
+
+    // The index can only be trusted if the blocks fill the space between the header and checksum
+    if (index_.empty() || ZLIB_HEADER_SIZE + compressed_size + trailer.size() + INDEX_FOOTER_SIZE !=
+                              file_size)
+    {
+        return reset();
+    }
+
+    file_.seekg(ZLIB_HEADER_SIZE);
+    return true;
+}
+
+void InflateStreamBuffer::inflate_ahead()
+{
+    while (inflating_.size() < max_blocks_inflating_ && next_block_ < index_.size())
+    {
+        auto [compressed_size, uncompressed_size] = index_[next_block_++];
+
+        // Read on this thread, as the blocks follow each other in the file. If the read fails the
+        // block fails to inflate, which is reported once the reader reaches it.
+        std::vector<char> compressed(compressed_size);
+        if (!file_.read(compressed.data(), compressed.size()))
+        {
+            compressed.clear();
+        }
+
+        auto inflate_block = [compressed = std::move(compressed), uncompressed_size]()
+        {
+            InflatedBlock block;
+            block.data.resize(uncompressed_size);
+
+            z_stream stream{};
+            if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+            {
+                return block;
+            }
+
+            // Inflate requires somewhere to write to even when there is nothing to write
+            char empty_output = 0;
+            stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+            stream.avail_in = static_cast<uInt>(compressed.size());
+            stream.next_out = reinterpret_cast<Bytef*>(
+                block.data.empty() ? &empty_output : block.data.data());
+            stream.avail_out = static_cast<uInt>(block.data.size());
+
+            auto result = inflate(&stream, Z_SYNC_FLUSH);
+            block.is_valid = result != Z_STREAM_ERROR && result != Z_DATA_ERROR &&
+                             result != Z_MEM_ERROR && result != Z_NEED_DICT &&
+                             stream.avail_in == 0 && stream.avail_out == 0;
+            block.adler =
+                adler32(adler32(0L, Z_NULL, 0), reinterpret_cast<const Bytef*>(block.data.data()),
+                        static_cast<uInt>(block.data.size()));
+            inflateEnd(&stream);
+            return block;
+        };
+        inflating_.push_back(std::async(std::launch::async, std::move(inflate_block)));
+    }
+}
+
+InflateStreamBuffer::int_type InflateStreamBuffer::underflow_blocks()
+{
+    // Empty blocks are skipped over
+    while (true)
+    {
+        inflate_ahead();
+        if (inflating_.empty())
+        {
+            return traits_type::eof();
+        }
+
+        auto block = inflating_.front().get();
+        inflating_.pop_front();
+        if (!block.is_valid)
+        {
+            std::println(std::cerr, "Error decompressing level data");
+            has_error_ = true;
+            return traits_type::eof();
+        }
+
+        adler_ = adler32_combine(adler_, block.adler, static_cast<z_off_t>(block.data.size()));
+        if (inflating_.empty() && next_block_ == index_.size() && adler_ != expected_adler_)
+        {
+            std::println(std::cerr, "Error decompressing level data: Incorrect checksum");
+            has_error_ = true;
+            return traits_type::eof();
+        }
+
+        if (!block.data.empty())
+        {
+            current_block_ = std::move(block.data);
+            setg(current_block_.data(), current_block_.data(),
+                 current_block_.data() + current_block_.size());
+            return traits_type::to_int_type(*gptr());
+        }
+    }
+}
+
+InflateStreamBuffer::int_type InflateStreamBuffer::underflow_stream()
+{
+    if (!stream_initialised_ || stream_ended_)
+    {
+        return traits_type::eof();
+    }
+
+    stream_.next_out = reinterpret_cast<Bytef*>(decompressed_.data());
+    stream_.avail_out = static_cast<uInt>(decompressed_.size());
+
+    // Inflating may not produce any output until enough input has been read, so keep reading until
+    // there is something to return
+    while (stream_.avail_out == decompressed_.size())
+    {
+        if (stream_.avail_in == 0)
+        {
+            file_.read(compressed_.data(), compressed_.size());
+            stream_.next_in = reinterpret_cast<Bytef*>(compressed_.data());
+            stream_.avail_in = static_cast<uInt>(file_.gcount());
+            if (stream_.avail_in == 0)
+            {
+                std::println(std::cerr, "Compressed level data ended unexpectedly");
+                has_error_ = true;
+                return traits_type::eof();
+            }
+        }
+
+        auto result = inflate(&stream_, Z_NO_FLUSH);
+        if (result == Z_STREAM_END)
+        {
+            stream_ended_ = true;
+            break;
+        }
+        if (result != Z_OK && result != Z_BUF_ERROR)
+        {
+            std::println(std::cerr, "Error decompressing level data: {}",
+                         stream_.msg ? stream_.msg : "Unknown error");
+            has_error_ = true;
+            return traits_type::eof();
+        }
+    }
+
+    auto size = decompressed_.size() - stream_.avail_out;
+    setg(decompressed_.data(), decompressed_.data(), decompressed_.data() + size);
+    return size > 0 ? traits_type::to_int_type(*gptr()) : traits_type::eof();
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <streambuf>
+#include <vector>
+
+#include <zlib.h>
+
+/// Stream buffer that compresses everything written to it into a zlib file. The data is split into
+/// blocks that are compressed independently across threads (as pigz does) and concatenated into a
+/// single zlib stream, so the file can still be read by anything that reads zlib.
+///
+/// After the end of the zlib stream an index of the blocks is written, which zlib ignores, but
+/// allows InflateStreamBuffer to inflate the blocks independently as well:
+///
+///  Per block - u32 compressed size, u32 uncompressed size
+///  Footer    - u32 block count, then the magic "CLYI"
+///
+/// Only a few blocks per thread are held in memory at a time, regardless of how much is written.
+class DeflateStreamBuffer : public std::streambuf
+{
+  public:
+    constexpr static std::size_t BLOCK_SIZE = 1024 * 1024;
+
+    DeflateStreamBuffer(const std::filesystem::path& path, int compression_level);
+    ~DeflateStreamBuffer() override;
+
+    DeflateStreamBuffer(const DeflateStreamBuffer&) = delete;
+    DeflateStreamBuffer& operator=(const DeflateStreamBuffer&) = delete;
+
+    /// Compresses the rest of the data and writes the end of the zlib stream and the block index.
+    /// Returns false if any of the data could not be compressed or written to the file.
+    bool finish();
+
+    /// The number of bytes written to the stream before being compressed. Data still buffered is
+    /// not counted, so this is only the full size once "finish" has been called.
+    [[nodiscard]] std::size_t get_uncompressed_size() const;
+
+  protected:
+    int_type overflow(int_type ch) override;
+
+  private:
+    struct CompressedBlock
+    {
+        std::vector<char> data;
+        uLong adler = 0;
+        std::uint32_t uncompressed_size = 0;
+        bool is_valid = false;
+    };
+
+    /// Starts compressing the data written so far, and starts a new block for the following data
+    void submit_block(bool is_final);
+
+    /// Waits for the oldest block being compressed and writes it to the file
+    void write_next_block();
+
+    std::ofstream file_;
+    int compression_level_;
+    bool is_finished_ = false;
+    bool has_error_ = false;
+
+    std::vector<char> block_;
+    std::deque<std::future<CompressedBlock>> compressing_;
+    std::size_t max_blocks_compressing_ = 1;
+
+    /// Index entries of the blocks written so far, and the adler-32 checksum of all of their data
+    std::vector<std::array<std::uint32_t, 2>> index_;
+    uLong adler_ = 1;
+    std::size_t uncompressed_size_ = 0;
+};
+
+/// Stream buffer that inflates a zlib compressed file as it is read, such that only a small
+/// window of the compressed and decompressed data is held in memory at a time. Use with a
+/// std::istream to read it.
+///
+/// Files written by DeflateStreamBuffer are read using their block index, with the blocks ahead
+/// of the reader being inflated on other threads.
+class InflateStreamBuffer : public std::streambuf
+{
+    constexpr static std::size_t CHUNK_SIZE = 64 * 1024;
+
+  public:
+    explicit InflateStreamBuffer(const std::filesystem::path& path);
+    ~InflateStreamBuffer() override;
+
+    InflateStreamBuffer(const InflateStreamBuffer&) = delete;
+    InflateStreamBuffer& operator=(const InflateStreamBuffer&) = delete;
+
+    /// False if the file could not be opened
+    [[nodiscard]] bool is_open() const;
+
+    /// True if the compressed data is corrupt or ends before the end of the zlib stream
+    [[nodiscard]] bool has_error() const;
+
+  protected:
+    int_type underflow() override;
+
+  private:
+    struct InflatedBlock
+    {
+        std::vector<char> data;
+        uLong adler = 0;
+        bool is_valid = false;
+    };
+
+    /// Reads the block index from the end of the file, returning false if there is not one
+    bool read_block_index();
+
+    /// Starts inflating blocks until enough are ahead of the reader
+    void inflate_ahead();
+
+    int_type underflow_blocks();
+    int_type underflow_stream();
+
+    std::ifstream file_;
+    bool has_error_ = false;
+
+    // Reading the file as a single zlib stream
+    z_stream stream_{};
+    bool stream_initialised_ = false;
+    bool stream_ended_ = false;
+    std::array<char, CHUNK_SIZE> compressed_;
+    std::array<char, CHUNK_SIZE> decompressed_;
+
+    // Reading the file by its block index
+    std::vector<std::array<std::uint32_t, 2>> index_;
+    std::size_t next_block_ = 0;
+    std::uint32_t expected_adler_ = 0;
+    uLong adler_ = 1;
+    std::deque<std::future<InflatedBlock>> inflating_;
+    std::size_t max_blocks_inflating_ = 1;
+    std::vector<char> current_block_;
+};
\ No newline at end of file